@@ -0,0 +1,43 @@
+# -------- Generated by configure -----------
+
+CXX := g++
+CXXFLAGS :=   
+LD := g++
+LIBS +=  -lpng -lz
+RANLIB := ranlib
+INSTALL := install
+AR := ar cru
+MKDIR := mkdir -p
+ECHO := printf
+CAT := cat
+RM := rm -f
+RM_REC := rm -f -r
+ZIP := zip -q
+CP := cp
+WINDOWSPATH=
+STRIP := strip
+LLVM_PROFDATA := llvm-profdata
+BINARY_LOADER :=
+
+MODULES +=  src/headless src/unix src/gui src/debugger src/debugger/gui src/yacc src/cheat
+MODULE_DIRS += 
+EXEEXT := 
+
+PREFIX := /usr/local
+BINDIR := /usr/local/bin
+DOCDIR := /usr/local/share/doc/stella
+DATADIR := /usr/local/share
+PROFILE := 
+DEBUG   := 
+HEADLESS := yes
+
+HAVE_GCC = 1
+
+
+
+INCLUDES += -Isrc/emucore -Isrc/common -Isrc/common/tv_filters -Isrc/emucore/tia -Isrc/emucore/tia/frame-manager -Isrc/headless -Isrc/unix -Isrc/gui -Isrc/debugger -Isrc/debugger/gui -Isrc/yacc -Isrc/cheat
+OBJS += 
+DEFINES +=  -DUNIX -DHEADLESS_SUPPORT -DBSPF_UNIX -DGUI_SUPPORT -DWINDOWED_SUPPORT -DSOUND_SUPPORT -DDEBUGGER_SUPPORT -DJOYSTICK_SUPPORT -DCHEATCODE_SUPPORT -DPNG_SUPPORT -DZIP_SUPPORT
+LDFLAGS += 
+
+CXX_UPDATE_DEP_FLAG = -MMD -MF "$(*D)/$(DEPDIR)/$(*F).d" -MQ "$@" -MP
@@ -0,0 +1,152 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <regex>
+
+#include "Benchmark.hxx"
+
+using std::chrono::duration;
+using std::chrono::steady_clock;
+
+namespace {
+  // Minimum duration of a single sample
+  constexpr double MIN_SAMPLE_NS = 20e6;
+
+  double timeIterations(const BenchmarkSuite::Body& body, uInt64 iterations)
+  {
+    const auto start = steady_clock::now();
+    for(uInt64 i = 0; i < iterations; ++i)
+      body();
+
+    return duration<double, std::nano>(steady_clock::now() - start).count();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool BenchmarkSuite::selected(const string& name) const
+{
+  return myFilter.empty() || name.find(myFilter) != string::npos;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BenchmarkSuite::add(const string& name, const Body& body)
+{
+  if(selected(name))
+    myBenchmarks.push_back({name, body});
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+vector<BenchmarkSuite::Result> BenchmarkSuite::run(uInt32 samples,
+                                                   ostream& log) const
+{
+  vector<Result> results;
+
+  for(const auto& benchmark: myBenchmarks)
+  {
+    (log << benchmark.name << " ... ").flush();
+
+    // Calibrate (this also serves as warmup)
+    uInt64 iterations = 1;
+    for(;;)
+    {
+      const double ns = timeIterations(benchmark.body, iterations);
+      if(ns >= MIN_SAMPLE_NS)
+        break;
+
+      iterations = ns > 0
+        ? std::max(iterations + 1, uInt64(iterations * 1.2 * MIN_SAMPLE_NS / ns))
+        : iterations * 10;
+    }
+
+    Result result;
+    result.name = benchmark.name;
+    result.iterations = iterations;
+    result.samples = std::max(samples, 2U);
+
+    vector<double> times(result.samples);
+    for(auto& time: times)
+      time = timeIterations(benchmark.body, iterations) / iterations;
+
+    for(double time: times)
+      result.mean += time;
+    result.mean /= times.size();
+
+    for(double time: times)
+      result.stddev += (time - result.mean) * (time - result.mean);
+    result.stddev = std::sqrt(result.stddev / (times.size() - 1));
+
+    result.min = *std::min_element(times.begin(), times.end());
+
+    log << result.mean << " ns" << endl;
+    results.push_back(result);
+  }
+
+  return results;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool BenchmarkSuite::loadBaseline(const string& filename, Baseline& baseline)
+{
+  ifstream in(filename);
+  if(!in.is_open())
+    return false;
+
+  // writeJSON puts each result on a line of its own, so there is no need
+  // for a full JSON parser
+  const std::regex entry(R"re("name": "([^"]*)".*"mean": ([-+0-9.eE]+))re");
+  string line;
+  std::smatch match;
+
+  while(std::getline(in, line))
+    if(std::regex_search(line, match, entry))
+      baseline[match[1]] = std::stod(match[2]);
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BenchmarkSuite::writeJSON(ostream& out, const vector<Result>& results,
+                               const Baseline& baseline)
+{
+  out << "{\n  \"unit\": \"ns\",\n  \"benchmarks\": [\n"
+      << std::fixed << std::setprecision(1);
+
+  for(size_t i = 0; i < results.size(); ++i)
+  {
+    const Result& result = results[i];
+
+    out << "    { \"name\": \"" << result.name << "\""
+        << ", \"iterations\": " << result.iterations
+        << ", \"samples\": " << result.samples
+        << ", \"mean\": " << result.mean
+        << ", \"stddev\": " << result.stddev
+        << ", \"min\": " << result.min;
+
+    const auto& iter = baseline.find(result.name);
+    if(iter != baseline.end() && iter->second > 0)
+      out << ", \"baseline\": " << iter->second
+          << ", \"change\": " << std::setprecision(4)
+          << (result.mean / iter->second - 1) << std::setprecision(1);
+
+    out << " }" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+
+  out << "  ]\n}" << endl;
+}
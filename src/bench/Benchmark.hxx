@@ -0,0 +1,112 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef BENCHMARK_HXX
+#define BENCHMARK_HXX
+
+#include <functional>
+#include <map>
+
+#include "bspf.hxx"
+
+/**
+  A minimal micro benchmark harness.  Each benchmark is a function which is
+  timed repeatedly: the number of iterations per sample is calibrated so that
+  a sample takes at least a few milliseconds, and the mean, standard
+  deviation and minimum of the time per iteration are reported over all
+  samples.
+
+  Results are written as JSON, optionally compared against the results of a
+  previous run (the baseline).
+*/
+class BenchmarkSuite
+{
+  public:
+    using Body = std::function<void()>;
+
+    struct Result {
+      string name;
+      uInt64 iterations{0};  // per sample
+      uInt32 samples{0};
+      double mean{0.};       // all times in nanoseconds per iteration
+      double stddev{0.};
+      double min{0.};
+    };
+
+    // Mean time per iteration of each benchmark in a baseline
+    using Baseline = std::map<string, double>;
+
+  public:
+    /**
+      Create a suite which only runs the benchmarks whose name contains the
+      filter string (all if it is empty).
+    */
+    explicit BenchmarkSuite(const string& filter = "") : myFilter(filter) { }
+
+    /**
+      Whether the benchmark of the given name passes the filter.  Fixtures
+      should only be built for benchmarks which do.
+    */
+    bool selected(const string& name) const;
+
+    /**
+      Add a benchmark; benchmarks which don't pass the filter are ignored.
+      Benchmarks are run in the order they were added.
+    */
+    void add(const string& name, const Body& body);
+
+    /**
+      Run all benchmarks.
+
+      @param samples  The number of samples to take per benchmark
+      @param log      Progress is written here
+    */
+    vector<Result> run(uInt32 samples, ostream& log) const;
+
+    /**
+      Read the results of a previous run, written by writeJSON.
+
+      @return  False if the file can't be read
+    */
+    static bool loadBaseline(const string& filename, Baseline& baseline);
+
+    /**
+      Write results as JSON.  For benchmarks found in the baseline, the
+      baseline mean and the relative change (positive means slower) are
+      included.
+    */
+    static void writeJSON(ostream& out, const vector<Result>& results,
+                          const Baseline& baseline);
+
+  private:
+    struct Benchmark {
+      string name;
+      Body body;
+    };
+    vector<Benchmark> myBenchmarks;
+
+    string myFilter;
+
+  private:
+    // Following constructors and assignment operators not supported
+    BenchmarkSuite(const BenchmarkSuite&) = delete;
+    BenchmarkSuite(BenchmarkSuite&&) = delete;
+    BenchmarkSuite& operator=(const BenchmarkSuite&) = delete;
+    BenchmarkSuite& operator=(BenchmarkSuite&&) = delete;
+};
+
+#endif
@@ -0,0 +1,615 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+/*
+  Micro and macro benchmarks for the performance critical parts of the
+  emulation core; built with 'make bench'.
+
+  Usage: stella-bench [-filter <substring>] [-samples <n>] [-out <file>]
+                      [-baseline <file>] [-threshold <percent>]
+                      [-profiledir <dir>]
+         stella-bench -verify
+
+  The results are written as JSON (to stdout, unless '-out' is given).
+  If a baseline (the output of a previous run) is given, the exit code is
+  nonzero if any benchmark is slower than the baseline by more than the
+  threshold (10% by default).  The emulation benchmarks use the ROMs from
+  the 'profile' directory.
+
+  With '-verify', no benchmarks are run; instead the optimized parts of the
+  core are checked against their reference implementations, and the exit
+  code is nonzero if any of them differ.
+*/
+
+#include <cstdlib>
+
+#include "Benchmark.hxx"
+#include "FSNode.hxx"
+#include "Logger.hxx"
+#include "Settings.hxx"
+#include "StellaEnvironment.hxx"
+#include "CartDetector.hxx"
+#include "MD5.hxx"
+#include "M6502.hxx"
+#include "TIA.hxx"
+#include "System.hxx"
+#include "Random.hxx"
+#include "Serializer.hxx"
+#include "Thumbulator.hxx"
+#include "MusicSynth.hxx"
+#include "audio/LanczosResampler.hxx"
+#include "AtariNTSC.hxx"
+#include "TIAConstants.hxx"
+
+namespace {
+  /**
+    A single bare console (no OSystem, no framebuffer, no sound), as used
+    by the agent environment.
+  */
+  class Machine
+  {
+    public:
+      Machine(const ByteBuffer& image, size_t size,
+              const Settings::Options& options = {})
+        : myEnvironment(image, size, 1, 1, options),
+          myFrame(myEnvironment.frameWidth() * myEnvironment.frameHeight())
+      { }
+
+      System& system() { return myEnvironment.system(); }
+
+      void runFrame()
+      {
+        const uInt8 action = StellaEnvironment::Noop;
+        if(!myEnvironment.step(&action, 1, nullptr, nullptr, myFrame.data()))
+          throw runtime_error("emulation failed");
+      }
+
+    private:
+      StellaEnvironment myEnvironment;
+      vector<uInt8> myFrame;
+  };
+
+  struct Image {
+    ByteBuffer data;
+    size_t size{0};
+  };
+
+  const std::array<std::pair<AtariNTSC::Kernel, const char*>, 4> NTSC_KERNELS = {{
+    { AtariNTSC::Kernel::SCALAR, "scalar" }, { AtariNTSC::Kernel::SSE2, "sse2" },
+    { AtariNTSC::Kernel::AVX2,   "avx2"   }, { AtariNTSC::Kernel::NEON, "neon" }
+  }};
+
+  // A 4K ROM which loops over some arithmetic on zero page RAM, without
+  // ever accessing the TIA
+  Image cpuLoopImage()
+  {
+    Image image{make_unique<uInt8[]>(4_KB), 4_KB};
+    std::fill_n(image.data.get(), image.size, 0xEA);  // NOP
+
+    const uInt8 code[] = {
+      0xA2, 0x00,        // F000  ldx #0
+      0xE8,              // F002  inx
+      0x8A,              // F003  txa
+      0x18,              // F004  clc
+      0x65, 0x80,        // F005  adc $80
+      0x85, 0x80,        // F007  sta $80
+      0x95, 0x81,        // F009  sta $81,x  (wraps within $81 - $180)
+      0x4A,              // F00B  lsr
+      0x45, 0x82,        // F00C  eor $82
+      0x85, 0x82,        // F00E  sta $82
+      0x4C, 0x02, 0xF0   // F010  jmp $F002
+    };
+    std::copy_n(code, sizeof(code), image.data.get());
+
+    // Reset and break vectors
+    image.data[0xFFC] = image.data[0xFFE] = 0x00;
+    image.data[0xFFD] = image.data[0xFFF] = 0xF0;
+
+    return image;
+  }
+
+  // A DPC+ sized ROM with a small Thumb loop at the entry point of the
+  // ARM driver
+  Image thumbLoopImage()
+  {
+    Image image{make_unique<uInt8[]>(32_KB), 32_KB};
+    std::fill_n(image.data.get(), image.size, 0);
+
+    const uInt16 code[] = {
+      0x2164,  // C08  movs r1, #100
+      0x0209,  // C0A  lsls r1, r1, #8
+      0x2000,  // C0C  movs r0, #0
+      0x3001,  // C0E  adds r0, #1
+      0x4288,  // C10  cmp r0, r1
+      0xD1FC,  // C12  bne C0E
+      0x4770   // C14  bx lr
+    };
+    for(size_t i = 0; i < sizeof(code) / sizeof(code[0]); ++i)
+    {
+      image.data[0xC08 + 2 * i]     = code[i] & 0xFF;
+      image.data[0xC08 + 2 * i + 1] = code[i] >> 8;
+    }
+
+    return image;
+  }
+
+  bool loadImage(const string& filename, Image& image)
+  {
+    FilesystemNode node(filename);
+    if(!node.isFile())
+      return false;
+
+    image.size = node.read(image.data);
+    return image.size > 0;
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  void addCpuBenchmarks(BenchmarkSuite& suite)
+  {
+    if(!suite.selected("m6502/execute-10k-cycles"))
+      return;
+
+    auto machine = std::make_shared<Machine>(cpuLoopImage().data, 4_KB);
+
+    suite.add("m6502/execute-10k-cycles", [machine]() {
+      machine->system().m6502().execute(10000);
+    });
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  void addTIABenchmarks(BenchmarkSuite& suite)
+  {
+    if(!suite.selected("tia/cycle-frame"))
+      return;
+
+    auto machine = std::make_shared<Machine>(cpuLoopImage().data, 4_KB);
+
+    // Drive the TIA directly: VSYNC, then change registers on every line,
+    // so that the line cache never kicks in
+    suite.add("tia/cycle-frame", [machine]() {
+      System& system = machine->system();
+      TIA& tia = system.tia();
+
+      tia.poke(0x00, 0x02);  // VSYNC on
+      system.incrementCycles(3 * 76);
+      tia.poke(0x00, 0x00);  // VSYNC off
+      tia.poke(0x01, 0x00);  // VBLANK off
+
+      for(uInt32 line = 0; line < 259; ++line)
+      {
+        tia.poke(0x09, uInt8(line));         // COLUBK
+        tia.poke(0x06, uInt8(line ^ 0x5A));  // COLUP0
+        tia.poke(0x1B, uInt8(line));         // GRP0
+        tia.poke(0x0D, uInt8(~line));        // PF0
+        system.incrementCycles(76);
+      }
+      tia.updateEmulation();
+    });
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  void addThumbulatorBenchmarks(BenchmarkSuite& suite)
+  {
+    if(!suite.selected("thumbulator/run-77k-instructions"))
+      return;
+
+    struct Fixture {
+      Image image{thumbLoopImage()};
+      std::array<uInt16, 4_KB> ram;
+      unique_ptr<Thumbulator> thumb;
+    };
+    auto fixture = std::make_shared<Fixture>();
+    fixture->thumb = make_unique<Thumbulator>(
+        reinterpret_cast<const uInt16*>(fixture->image.data.get()),
+        fixture->ram.data(), uInt16(fixture->image.size),
+        false, Thumbulator::ConfigureFor::DPCplus, nullptr);
+
+    suite.add("thumbulator/run-77k-instructions", [fixture]() {
+      fixture->thumb->run();
+    });
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  void addMusicSynthBenchmarks(BenchmarkSuite& suite)
+  {
+    if(!suite.selected("musicsynth/update-1k-reads"))
+      return;
+
+    auto synth = std::make_shared<MusicSynth>();
+    for(uInt8 voice = 0; voice < 3; ++voice)
+      synth->frequency(voice) = 0x1234567u * (voice + 1);
+
+    suite.add("musicsynth/update-1k-reads", [synth]() {
+      uInt64 cycles = synth->lastCycles();
+      for(uInt32 i = 0; i < 1000; ++i)
+        synth->update(cycles += 7);
+    });
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  void addResamplerBenchmarks(BenchmarkSuite& suite)
+  {
+    if(!suite.selected("lanczos/fill-fragment-512-stereo"))
+      return;
+
+    constexpr uInt32 fragmentSize = 512;
+
+    struct Fixture {
+      std::array<Int16, 2 * fragmentSize> input;
+      std::array<float, 2 * fragmentSize> output;
+      unique_ptr<LanczosResampler> resampler;
+    };
+    auto fixture = std::make_shared<Fixture>();
+
+    Random random(0);
+    for(auto& sample: fixture->input)
+      sample = Int16(random.next());
+
+    Int16* input = fixture->input.data();
+    fixture->resampler = make_unique<LanczosResampler>(
+        Resampler::Format(31440, fragmentSize, true),
+        Resampler::Format(48000, fragmentSize, true),
+        [input]() { return input; }, 3);
+
+    suite.add("lanczos/fill-fragment-512-stereo", [fixture]() {
+      fixture->resampler->fillFragment(fixture->output.data(),
+                                       uInt32(fixture->output.size()));
+    });
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  void addNTSCBenchmarks(BenchmarkSuite& suite)
+  {
+    vector<std::pair<string, AtariNTSC::Kernel>> benchmarks;
+    if(suite.selected("atarintsc/render-frame"))
+      benchmarks.emplace_back("atarintsc/render-frame", AtariNTSC::bestKernel());
+    for(const auto& kernel: NTSC_KERNELS)
+    {
+      const string name = string("atarintsc/render-frame/") + kernel.second;
+      if(AtariNTSC::isSupported(kernel.first) && suite.selected(name))
+        benchmarks.emplace_back(name, kernel.first);
+    }
+    if(benchmarks.empty())
+      return;
+
+    constexpr uInt32 width = TIAConstants::frameBufferWidth,
+                     height = 228;
+
+    struct Fixture {
+      AtariNTSC ntsc;
+      vector<uInt8> input;
+      vector<uInt32> output;
+    };
+    auto fixture = std::make_shared<Fixture>();
+
+    PaletteArray palette;
+    for(uInt32 i = 0; i < palette.size(); ++i)
+      palette[i] = (i << 16) | ((255 - i) << 8) | ((i * 7) & 0xFF);
+
+    fixture->ntsc.initialize(AtariNTSC::TV_Composite);
+    fixture->ntsc.setPalette(palette);
+    fixture->ntsc.enableThreading(false);
+
+    Random random(0);
+    fixture->input.resize(width * height);
+    for(auto& pixel: fixture->input)
+      pixel = uInt8(random.next()) & 0xFE;
+    fixture->output.resize(AtariNTSC::outWidth(width) * height);
+
+    const auto render = [fixture](AtariNTSC::Kernel kernel) {
+      fixture->ntsc.setKernel(kernel);
+      fixture->ntsc.render(fixture->input.data(), width, height,
+                           fixture->output.data(), AtariNTSC::outWidth(width) * 4);
+    };
+
+    for(const auto& benchmark: benchmarks)
+    {
+      const AtariNTSC::Kernel kernel = benchmark.second;
+      suite.add(benchmark.first, [render, kernel]() { render(kernel); });
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  void addROMBenchmarks(BenchmarkSuite& suite, const string& profileDir)
+  {
+    for(const char* name: { "128.bin", "catharsis_theory.bin" })
+    {
+      const bool machineSelected =
+        suite.selected(string("emulation/frame/") + name) ||
+        suite.selected(string("serializer/save/") + name) ||
+        suite.selected(string("serializer/load/") + name);
+      if(!machineSelected && !suite.selected(string("md5/") + name) &&
+         !suite.selected(string("cartdetector/") + name))
+        continue;
+
+      auto image = std::make_shared<Image>();
+      if(!loadImage(profileDir + "/" + name, *image))
+      {
+        cerr << "ERROR: unable to load " << profileDir << "/" << name << endl;
+        continue;
+      }
+
+      suite.add(string("md5/") + name, [image]() {
+        MD5::hash(image->data, image->size);
+      });
+
+      suite.add(string("cartdetector/") + name, [image]() {
+        CartDetector::autodetectType(image->data, image->size);
+      });
+
+      if(!machineSelected)
+        continue;
+
+      auto machine = std::make_shared<Machine>(image->data, image->size);
+      suite.add(string("emulation/frame/") + name, [machine]() {
+        machine->runFrame();
+      });
+
+      // Loading needs a state to load, even if saving isn't benchmarked
+      auto state = std::make_shared<Serializer>();
+      machine->system().save(*state);
+      suite.add(string("serializer/save/") + name, [machine, state]() {
+        state->rewind();
+        machine->system().save(*state);
+      });
+      suite.add(string("serializer/load/") + name, [machine, state]() {
+        state->rewind();
+        machine->system().load(*state);
+      });
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // MusicSynth must match the music data fetchers it replaced clock for
+  // clock, over long sequences of randomly spaced music register reads
+  void verifyMusicSynth()
+  {
+    // The music data fetchers as the DPC, DPC+, CDF, BUS and CTY schemes
+    // implemented them before MusicSynth
+    struct Reference {
+      double rate{20000.0};
+      uInt64 audioCycles{0};
+      double fractionalClocks{0.0};
+      std::array<uInt32, 3> counters{0};
+      std::array<uInt32, 3> frequencies{0};
+
+      uInt32 update(uInt64 systemCycles)
+      {
+        uInt32 cycles = uInt32(systemCycles - audioCycles);
+        audioCycles = systemCycles;
+
+        double clocks = ((rate * cycles) / 1193191.66666667) + fractionalClocks;
+        uInt32 wholeClocks = uInt32(clocks);
+        fractionalClocks = clocks - double(wholeClocks);
+
+        if(wholeClocks > 0)
+          for(int x = 0; x <= 2; ++x)
+            counters[x] += frequencies[x] * wholeClocks;
+
+        return wholeClocks;
+      }
+    };
+
+    Random random(0);
+    for(double rate: { 20000.0, 10000.0, 15700.0, 21400.0, 30000.0 })
+    {
+      Reference reference;
+      MusicSynth synth(rate);
+      reference.rate = rate;
+
+      uInt64 cycles = 0;
+      for(uInt32 i = 0; i < 4000000; ++i)
+      {
+        // Mostly reads a few cycles apart, sometimes a frame or more
+        const uInt32 r = random.next();
+        cycles += (r & 0x300) ? (r & 0x3F) : (r & 0x1FFFF);
+
+        if((r & 0xFFFF) == 0)
+        {
+          const uInt8 voice = uInt8(r >> 16) % 3;
+          reference.frequencies[voice] = synth.frequency(voice) = random.next();
+        }
+
+        // Round trip through the state file representation now and then
+        if((r & 0xFFF) == 1)
+        {
+          MusicSynth loaded(rate);
+          loaded.setLastCycles(synth.lastCycles());
+          loaded.setFractionalClocks(synth.fractionalClocks());
+          loaded.counters() = synth.counters();
+          loaded.frequencies() = synth.frequencies();
+          synth = loaded;
+        }
+
+        const uInt32 expected = reference.update(cycles);
+        synth.update(cycles);
+
+        if(synth.counters() != reference.counters ||
+           synth.fractionalClocks() != reference.fractionalClocks)
+          throw runtime_error("MusicSynth: clocks differ from reference at rate " +
+                              std::to_string(rate) + ", read " + std::to_string(i) +
+                              " (" + std::to_string(expected) + " clocks expected)");
+      }
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Every AtariNTSC kernel the CPU supports must be bit-identical to the
+  // scalar one, for all presets
+  void verifyNTSCKernels()
+  {
+    constexpr uInt32 width = TIAConstants::frameBufferWidth,
+                     height = 228;
+
+    PaletteArray palette;
+    for(uInt32 i = 0; i < palette.size(); ++i)
+      palette[i] = (i << 16) | ((255 - i) << 8) | ((i * 7) & 0xFF);
+
+    Random random(0);
+    vector<uInt8> input(width * height);
+    for(auto& pixel: input)
+      pixel = uInt8(random.next()) & 0xFE;
+
+    const std::array<std::pair<const AtariNTSC::Setup*, const char*>, 4> presets = {{
+      { &AtariNTSC::TV_Composite, "composite" }, { &AtariNTSC::TV_SVideo, "s-video" },
+      { &AtariNTSC::TV_RGB,       "rgb"       }, { &AtariNTSC::TV_Bad,    "bad" }
+    }};
+    for(const auto& preset: presets)
+    {
+      AtariNTSC ntsc;
+      ntsc.initialize(*preset.first);
+      ntsc.setPalette(palette);
+      ntsc.enableThreading(false);
+
+      const auto render = [&](AtariNTSC::Kernel kernel) {
+        vector<uInt32> output(AtariNTSC::outWidth(width) * height);
+        ntsc.setKernel(kernel);
+        ntsc.render(input.data(), width, height,
+                    output.data(), AtariNTSC::outWidth(width) * 4);
+        return output;
+      };
+
+      const vector<uInt32> reference = render(AtariNTSC::Kernel::SCALAR);
+      for(const auto& kernel: NTSC_KERNELS)
+      {
+        if(kernel.first == AtariNTSC::Kernel::SCALAR ||
+           !AtariNTSC::isSupported(kernel.first))
+          continue;
+
+        if(render(kernel.first) != reference)
+          throw runtime_error(string("AtariNTSC: ") + kernel.second + " output differs"
+                              " from scalar output with the " + preset.second + " preset");
+        cerr << kernel.second << "/" << preset.second << " ";
+      }
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  int runChecks()
+  {
+    const std::array<std::pair<const char*, void (*)()>, 2> checks = {{
+      { "musicsynth", verifyMusicSynth },
+      { "atarintsc", verifyNTSCKernels }
+    }};
+
+    int failures = 0;
+    for(const auto& check: checks)
+    {
+      (cerr << check.first << " ... ").flush();
+      try
+      {
+        check.second();
+        cerr << "ok" << endl;
+      }
+      catch(const std::exception& e)
+      {
+        cerr << "FAILED: " << e.what() << endl;
+        ++failures;
+      }
+    }
+
+    return failures > 0 ? 2 : 0;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int main(int argc, char* argv[])
+{
+  string filter, outFile, baselineFile, profileDir = "profile";
+  uInt32 samples = 10;
+  double threshold = 10;
+  bool verify = false;
+
+  for(int i = 1; i < argc; ++i)
+  {
+    const string arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+
+    if(arg == "-filter" && hasValue)           filter = argv[++i];
+    else if(arg == "-samples" && hasValue)     samples = uInt32(atoi(argv[++i]));
+    else if(arg == "-out" && hasValue)         outFile = argv[++i];
+    else if(arg == "-baseline" && hasValue)    baselineFile = argv[++i];
+    else if(arg == "-threshold" && hasValue)   threshold = atof(argv[++i]);
+    else if(arg == "-profiledir" && hasValue)  profileDir = argv[++i];
+    else if(arg == "-verify")                  verify = true;
+    else
+    {
+      cerr << "usage: " << argv[0] << " [-filter <substring>] [-samples <n>]"
+           << " [-out <file>] [-baseline <file>] [-threshold <percent>]"
+           << " [-profiledir <dir>]" << endl
+           << "       " << argv[0] << " -verify" << endl;
+      return 2;
+    }
+  }
+
+  if(verify)
+    return runChecks();
+
+  BenchmarkSuite::Baseline baseline;
+  if(!baselineFile.empty() && !BenchmarkSuite::loadBaseline(baselineFile, baseline))
+  {
+    cerr << "ERROR: unable to read baseline " << baselineFile << endl;
+    return 2;
+  }
+
+  // Keep autodetection chatter out of the timings
+  Logger::instance().setLogParameters(Logger::Level::ERR, true);
+
+  BenchmarkSuite suite(filter);
+
+  try
+  {
+    addCpuBenchmarks(suite);
+    addTIABenchmarks(suite);
+    addThumbulatorBenchmarks(suite);
+    addMusicSynthBenchmarks(suite);
+    addResamplerBenchmarks(suite);
+    addNTSCBenchmarks(suite);
+    addROMBenchmarks(suite, profileDir);
+  }
+  catch(const std::exception& e)
+  {
+    cerr << "ERROR: " << e.what() << endl;
+    return 2;
+  }
+
+  const vector<BenchmarkSuite::Result> results = suite.run(samples, cerr);
+
+  if(outFile.empty())
+    BenchmarkSuite::writeJSON(cout, results, baseline);
+  else
+  {
+    ofstream out(outFile);
+    BenchmarkSuite::writeJSON(out, results, baseline);
+  }
+
+  // Gate on regressions against the baseline
+  int regressions = 0;
+  for(const auto& result: results)
+  {
+    const auto& iter = baseline.find(result.name);
+    if(iter != baseline.end() && iter->second > 0 &&
+       result.mean > iter->second * (1 + threshold / 100))
+    {
+      cerr << "REGRESSION: " << result.name << " " << iter->second
+           << " ns -> " << result.mean << " ns" << endl;
+      ++regressions;
+    }
+  }
+
+  return regressions > 0 ? 1 : 0;
+}
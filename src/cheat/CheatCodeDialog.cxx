@@ -27,6 +27,9 @@
 #include "OSystem.hxx"
 #include "Props.hxx"
 #include "Widget.hxx"
+#ifdef DEBUGGER_SUPPORT
+  #include "Debugger.hxx"
+#endif
 
 #include "CheatCodeDialog.hxx"
 
@@ -80,6 +83,18 @@ CheatCodeDialog::CheatCodeDialog(OSystem& osystem, DialogContainer& parent,
                        "One shot" + ELLIPSIS, kAddOneShotCmd);
   wid.push_back(b);
 
+#ifdef DEBUGGER_SUPPORT
+  ypos += lineHeight + 8;
+  b = new ButtonWidget(this, font, xpos, ypos, buttonWidth, buttonHeight,
+                       "Search" + ELLIPSIS, kSearchRamCmd);
+  wid.push_back(b);
+
+  // Inputbox for RAM search commands, see 'ramsearch' in the debugger
+  mySearchInput = make_unique<InputTextDialog>(this, font,
+      StringList{"Search "}, "RAM search (start, eq, inc, dec, ...)");
+  mySearchInput->setTarget(this);
+#endif
+
   // Inputbox which will pop up when adding/editing a cheat
   StringList labels;
   labels.push_back("Name       ");
@@ -198,6 +213,18 @@ void CheatCodeDialog::addOneShotCheat()
   myCheatInput->setEmitSignal(kOneShotCheatAdded);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CheatCodeDialog::searchRam()
+{
+#ifdef DEBUGGER_SUPPORT
+  mySearchInput->show();    // Center input dialog over entire screen
+  mySearchInput->setText("start", 0);
+  mySearchInput->setMessage("");
+  mySearchInput->setFocus(0);
+  mySearchInput->setEmitSignal(kRamSearched);
+#endif
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CheatCodeDialog::handleCommand(CommandSender* sender, int cmd,
                                     int data, int id)
@@ -279,6 +306,27 @@ void CheatCodeDialog::handleCommand(CommandSender* sender, int cmd,
       break;
     }
 
+    case kSearchRamCmd:
+      searchRam();
+      break;
+
+#ifdef DEBUGGER_SUPPORT
+    case kRamSearched:
+    {
+      // Only the first line (the summary) fits into the dialog
+      const string& result =
+        instance().debugger().run("ramsearch " + mySearchInput->getResult(0));
+      string message;
+      for(char c: result.substr(0, result.find('\n')))
+        if(isprint(static_cast<unsigned char>(c)))
+          message += c;
+
+      mySearchInput->setText("", 0);
+      mySearchInput->setMessage(message);
+      break;
+    }
+#endif
+
     default:
       Dialog::handleCommand(sender, cmd, data, 0);
       break;
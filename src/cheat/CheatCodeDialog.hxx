@@ -48,10 +48,12 @@ class CheatCodeDialog : public Dialog
     void editCheat();
     void removeCheat();
     void addOneShotCheat();
+    void searchRam();
 
   private:
     CheckListWidget* myCheatList{nullptr};
     unique_ptr<InputTextDialog> myCheatInput;
+    unique_ptr<InputTextDialog> mySearchInput;
 
     ButtonWidget* myEditButton{nullptr};
     ButtonWidget* myRemoveButton{nullptr};
@@ -63,7 +65,9 @@ class CheatCodeDialog : public Dialog
       kCheatAdded        = 'CHad',
       kCheatEdited       = 'CHed',
       kOneShotCheatAdded = 'CHoa',
-      kRemCheatCmd       = 'CHTr'
+      kRemCheatCmd       = 'CHTr',
+      kSearchRamCmd      = 'CHTs',
+      kRamSearched       = 'CHrs'
     };
 
   private:
@@ -32,6 +32,12 @@ CheatManager::CheatManager(OSystem& osystem)
 {
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+CheatManager::~CheatManager()
+{
+  waitForCheatDatabase();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CheatManager::add(const string& name, const string& code,
                        bool enable, int idx)
@@ -213,43 +219,55 @@ void CheatManager::enable(const string& code, bool enable)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CheatManager::loadCheatDatabase()
 {
-  const string& cheatfile = myOSystem.cheatFile();
-  ifstream in(cheatfile);
-  if(!in)
-    return;
+  waitForCheatDatabase();
 
-  string line, md5, cheat;
-  string::size_type one, two, three, four;
+  myLoader = std::thread([this, cheatfile = myOSystem.cheatFile()]() {
+    ifstream in(cheatfile);
+    if(!in)
+      return;
 
-  // Loop reading cheats
-  while(getline(in, line))
-  {
-    if(line.length() == 0)
-      continue;
+    string line, md5, cheat;
+    string::size_type one, two, three, four;
 
-    one = line.find('\"', 0);
-    two = line.find('\"', one + 1);
-    three = line.find('\"', two + 1);
-    four = line.find('\"', three + 1);
+    // Loop reading cheats
+    while(getline(in, line))
+    {
+      if(line.length() == 0)
+        continue;
 
-    // Invalid line if it doesn't contain 4 quotes
-    if((one == string::npos) || (two == string::npos) ||
-       (three == string::npos) || (four == string::npos))
-      break;
+      one = line.find('\"', 0);
+      two = line.find('\"', one + 1);
+      three = line.find('\"', two + 1);
+      four = line.find('\"', three + 1);
+
+      // Invalid line if it doesn't contain 4 quotes
+      if((one == string::npos) || (two == string::npos) ||
+         (three == string::npos) || (four == string::npos))
+        break;
 
-    // Otherwise get the ms5sum and associated cheats
-    md5   = line.substr(one + 1, two - one - 1);
-    cheat = line.substr(three + 1, four - three - 1);
+      // Otherwise get the ms5sum and associated cheats
+      md5   = line.substr(one + 1, two - one - 1);
+      cheat = line.substr(three + 1, four - three - 1);
 
-    myCheatMap.emplace(md5, cheat);
-  }
+      myCheatMap.emplace(md5, cheat);
+    }
+
+    myListIsDirty = false;
+  });
+}
 
-  myListIsDirty = false;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CheatManager::waitForCheatDatabase()
+{
+  if(myLoader.joinable())
+    myLoader.join();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CheatManager::saveCheatDatabase()
 {
+  waitForCheatDatabase();
+
   if(!myListIsDirty)
     return;
 
@@ -275,6 +293,8 @@ void CheatManager::loadCheats(const string& md5sum)
   if(cheats != "")
     myOSystem.settings().setValue("cheat", "");
 
+  waitForCheatDatabase();
+
   const auto& iter = myCheatMap.find(md5sum);
   if(iter == myCheatMap.end() && cheats == "")
     return;
@@ -289,6 +309,8 @@ void CheatManager::loadCheats(const string& md5sum)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CheatManager::saveCheats(const string& md5sum)
 {
+  waitForCheatDatabase();
+
   ostringstream cheats;
   for(uInt32 i = 0; i < myCheatList.size(); ++i)
   {
@@ -19,6 +19,7 @@
 #define CHEAT_MANAGER_HXX
 
 #include <map>
+#include <thread>
 
 class Cheat;
 class OSystem;
@@ -38,6 +39,7 @@ class CheatManager
 {
   public:
     explicit CheatManager(OSystem& osystem);
+    ~CheatManager();
 
     /**
       Adds the specified cheat to an internal list.
@@ -100,6 +102,7 @@ class CheatManager
 
     /**
       Load all cheats (for all ROMs) from disk to internal database.
+      The file is parsed in the background, until the database is used.
     */
     void loadCheatDatabase();
 
@@ -141,6 +144,11 @@ class CheatManager
     */
     void parse(const string& cheats);
 
+    /**
+      Wait until the cheat database has been loaded.
+    */
+    void waitForCheatDatabase();
+
   private:
     OSystem& myOSystem;
 
@@ -157,6 +165,9 @@ class CheatManager
     // Indicates that the list has been modified, and should be saved to disk
     bool myListIsDirty{false};
 
+    // Parses the cheat database
+    std::thread myLoader;
+
   private:
     // Following constructors and assignment operators not supported
     CheatManager() = delete;
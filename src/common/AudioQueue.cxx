@@ -16,6 +16,7 @@
 //============================================================================
 
 #include "AudioQueue.hxx"
+#include "PerfCounters.hxx"
 
 using std::mutex;
 using std::lock_guard;
@@ -89,10 +90,13 @@ Int16* AudioQueue::enqueue(Int16* fragment)
   newFragment = myFragmentQueue.at(fragmentIndex);
   myFragmentQueue.at(fragmentIndex) = fragment;
 
+  PERF_COUNT(audioFragments, 1);
+
   if (mySize < capacity) ++mySize;
   else {
     myNextFragment = (myNextFragment + 1) % capacity;
     if (!myIgnoreOverflows) myOverflowLogger.log();
+    PERF_COUNT(audioOverflows, 1);
   }
 
   return newFragment;
@@ -133,6 +137,23 @@ void AudioQueue::closeSink(Int16* fragment)
     myFirstFragmentForDequeue = fragment;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AudioQueue::setTargetSize(uInt32 targetSize)
+{
+  myTargetSize = targetSize;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 AudioQueue::surplus()
+{
+  const uInt32 targetSize = myTargetSize;
+  if (targetSize == 0) return 0;
+
+  lock_guard<mutex> guard(myMutex);
+
+  return mySize > targetSize ? mySize - targetSize : 0;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AudioQueue::ignoreOverflows(bool shouldIgnoreOverflows)
 {
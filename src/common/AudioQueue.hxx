@@ -19,6 +19,7 @@
 #define AUDIO_QUEUE_HXX
 
 #include <mutex>
+#include <atomic>
 
 #include "bspf.hxx"
 #include "StaggeredLogger.hxx"
@@ -96,6 +97,18 @@ class AudioQueue
      */
     void ignoreOverflows(bool shouldIgnoreOverflows);
 
+    /**
+      The number of fragments the sink wants to keep queued. The sink sets this
+      if it drives emulation (dynamic rate control); the emulation loop then
+      doesn't run ahead of it. Zero means that the sink doesn't care.
+     */
+    void setTargetSize(uInt32 targetSize);
+
+    /**
+      The number of fragments queued beyond the target size set by the sink.
+     */
+    uInt32 surplus();
+
   private:
 
     // The size of an individual fragment (in stereo / mono samples)
@@ -130,6 +143,9 @@ class AudioQueue
     // Log overflows?
     bool myIgnoreOverflows{true};
 
+    // The fill level requested by the sink (set from the audio thread)
+    std::atomic<uInt32> myTargetSize{0};
+
     StaggeredLogger myOverflowLogger{"audio buffer overflow", Logger::Level::INFO};
 
   private:
@@ -166,6 +166,12 @@ uInt32 AudioSettings::dpcPitch() const
   return lboundInt(mySettings.getInt(SETTING_DPC_PITCH), 10000);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool AudioSettings::dynamicRate() const
+{
+  return mySettings.getBool(SETTING_DYNAMIC_RATE);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AudioSettings::setPreset(AudioSettings::Preset preset)
 {
@@ -276,6 +282,14 @@ void AudioSettings::setDpcPitch(uInt32 pitch)
   mySettings.setValue(SETTING_DPC_PITCH, pitch);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AudioSettings::setDynamicRate(bool enabled)
+{
+  if (!myIsPersistent) return;
+
+  mySettings.setValue(SETTING_DYNAMIC_RATE, enabled);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AudioSettings::setVolume(uInt32 volume)
 {
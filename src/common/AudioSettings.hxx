@@ -50,6 +50,7 @@ class AudioSettings
     static constexpr const char* SETTING_VOLUME              = "audio.volume";
     static constexpr const char* SETTING_ENABLED             = "audio.enabled";
     static constexpr const char* SETTING_DPC_PITCH           = "audio.dpc_pitch";
+    static constexpr const char* SETTING_DYNAMIC_RATE        = "audio.dynamic_rate";
 
     static constexpr Preset DEFAULT_PRESET                          = Preset::highQualityMediumLag;
     static constexpr uInt32 DEFAULT_SAMPLE_RATE                     = 44100;
@@ -61,6 +62,7 @@ class AudioSettings
     static constexpr uInt32 DEFAULT_VOLUME                          = 80;
     static constexpr bool DEFAULT_ENABLED                           = true;
     static constexpr uInt32 DEFAULT_DPC_PITCH                       = 20000;
+    static constexpr bool DEFAULT_DYNAMIC_RATE                      = false;
 
     static constexpr int MAX_BUFFER_SIZE = 10;
     static constexpr int MAX_HEADROOM    = 10;
@@ -91,6 +93,8 @@ class AudioSettings
 
     uInt32 dpcPitch() const;
 
+    bool dynamicRate() const;
+
     void setPreset(Preset preset);
 
     void setSampleRate(uInt32 sampleRate);
@@ -107,6 +111,8 @@ class AudioSettings
 
     void setDpcPitch(uInt32 pitch);
 
+    void setDynamicRate(bool enabled);
+
     void setVolume(uInt32 volume);
 
     void setEnabled(bool isEnabled);
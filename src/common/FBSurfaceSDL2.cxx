@@ -144,6 +144,10 @@ void FBSurfaceSDL2::setDstSize(uInt32 w, uInt32 h)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FBSurfaceSDL2::setVisible(bool visible)
 {
+  // Lines modified while invisible were never uploaded
+  if(visible && !myIsVisible)
+    reinitializeBlitter();
+
   myIsVisible = visible;
 }
 
@@ -161,7 +165,8 @@ bool FBSurfaceSDL2::render()
 
   if(myIsVisible && myBlitter)
   {
-    myBlitter->blit(*mySurface);
+    myBlitter->blit(*mySurface, myDirtyFirstLine, myDirtyLineCount);
+    setDirtyLines(0, ALL_LINES);
 
     return true;
   }
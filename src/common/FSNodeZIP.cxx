@@ -36,9 +36,10 @@ FilesystemNodeZIP::FilesystemNodeZIP(const string& p)
   _zipFile = p.substr(0, pos+4);
 
   // Open file at least once to initialize the virtual file count
+  ZipHandler zipHandler;
   try
   {
-    myZipHandler->open(_zipFile);
+    zipHandler.open(_zipFile);
   }
   catch(const runtime_error&)
   {
@@ -46,7 +47,7 @@ FilesystemNodeZIP::FilesystemNodeZIP(const string& p)
     //       For now, we just indicate that no ROMs were found
     _error = zip_error::NO_ROMS;
   }
-  _numFiles = myZipHandler->romFiles();
+  _numFiles = zipHandler.romFiles();
   if(_numFiles == 0)
   {
     _error = zip_error::NO_ROMS;
@@ -63,9 +64,9 @@ FilesystemNodeZIP::FilesystemNodeZIP(const string& p)
   else if(_numFiles == 1)
   {
     bool found = false;
-    while(myZipHandler->hasNext() && !found)
+    while(zipHandler.hasNext() && !found)
     {
-      const string& file = myZipHandler->next();
+      const string& file = zipHandler.next();
       if(Bankswitch::isValidRomName(file))
       {
         _virtualPath = file;
@@ -134,12 +135,13 @@ bool FilesystemNodeZIP::getChildren(AbstractFSList& myList, ListMode mode) const
     return false;
 
   std::set<string> dirs;
-  myZipHandler->open(_zipFile);
-  while(myZipHandler->hasNext())
+  ZipHandler zipHandler;
+  zipHandler.open(_zipFile);
+  while(zipHandler.hasNext())
   {
     // Only consider entries that start with '_virtualPath'
     // Ignore empty filenames and '__MACOSX' virtual directories
-    const string& next = myZipHandler->next();
+    const string& next = zipHandler.next();
     if(BSPF::startsWithIgnoreCase(next, "__MACOSX") || next == EmptyString)
       continue;
     if(BSPF::startsWithIgnoreCase(next, _virtualPath))
@@ -175,13 +177,13 @@ size_t FilesystemNodeZIP::read(ByteBuffer& image) const
     case zip_error::NO_ROMS:      throw runtime_error("ZIP file doesn't contain any ROMs");
   }
 
-  myZipHandler->open(_zipFile);
+  // Handlers are cheap, since the parsed archive is cached; using one per
+  // call allows reading from different threads at the same time
+  ZipHandler zipHandler;
+  zipHandler.open(_zipFile);
 
-  bool found = false;
-  while(myZipHandler->hasNext() && !found)
-    found = myZipHandler->next() == _virtualPath;
-
-  return found ? uInt32(myZipHandler->decompress(image)) : 0; // TODO: 64bit
+  return zipHandler.select(_virtualPath)
+    ? uInt32(zipHandler.decompress(image)) : 0; // TODO: 64bit
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -196,7 +198,4 @@ AbstractFSNodePtr FilesystemNodeZIP::getParent() const
   return make_shared<FilesystemNodeZIP>(string(start, end - start - 1));
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-unique_ptr<ZipHandler> FilesystemNodeZIP::myZipHandler = make_unique<ZipHandler>();
-
 #endif  // ZIP_SUPPORT
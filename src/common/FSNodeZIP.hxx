@@ -64,6 +64,10 @@ class FilesystemNodeZIP : public AbstractFSNode
 
     size_t read(ByteBuffer& image) const override;
 
+    // Changes to the archive are what matters
+    size_t getSize() const override { return _realNode ? _realNode->getSize() : 0; }
+    uInt64 getModTime() const override { return _realNode ? _realNode->getModTime() : 0; }
+
   private:
     FilesystemNodeZIP(const string& zipfile, const string& virtualpath,
         const AbstractFSNodePtr& realnode, bool isdir);
@@ -101,9 +105,6 @@ class FilesystemNodeZIP : public AbstractFSNode
 
     bool _isDirectory{false}, _isFile{false};
 
-    // ZipHandler static reference variable responsible for accessing ZIP files
-    static unique_ptr<ZipHandler> myZipHandler;
-
     // Get last component of path
     static const char* lastPathComponent(const string& str)
     {
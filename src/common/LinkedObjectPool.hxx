@@ -151,6 +151,8 @@ class LinkedObjectPool
     */
     const_iter cbegin() const { return myList.cbegin(); }
     const_iter cend() const   { return myList.cend();   }
+    iter begin() { return myList.begin(); }
+    iter end()   { return myList.end();   }
 
     /**
       Answer whether 'current' is at the specified iterator.
@@ -17,6 +17,32 @@
 
 #include "Logger.hxx"
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Logger::Logger()
+{
+  for(uInt32 i = 0; i < QUEUE_SIZE; ++i)
+  {
+    myQueue[i].sequence.store(i, std::memory_order_relaxed);
+    myQueue[i].message.reserve(MESSAGE_SIZE);
+  }
+
+  myWriterThread = std::thread(&Logger::runWriter, this);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Logger::~Logger()
+{
+  {
+    std::lock_guard<std::mutex> lock(myWriterMutex);
+    myQuit = true;
+  }
+  myWriterWakeup.notify_one();
+  myWriterThread.join();
+
+  // Write out whatever was logged in the meantime
+  drain();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Logger& Logger::instance()
 {
@@ -48,22 +74,166 @@ void Logger::debug(const string& message)
   instance().logMessage(message, Level::DEBUG);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Logger::enabled(Level level)
+{
+  return level == Level::ERR ||
+    static_cast<int>(level) <= instance().myLogLevel.load(std::memory_order_relaxed);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Logger::logMessage(const string& message, Level level)
 {
-  if(level == Logger::Level::ERR)
+  if(!enabled(level))
+    return;
+
+  // Claim a free entry in the queue; if there is none, the message is
+  // dropped rather than waiting for the writer (except for errors)
+  uInt32 pos = myEnqueuePos.load(std::memory_order_relaxed);
+  Record* record = nullptr;
+  for(;;)
+  {
+    record = &myQueue[pos & (QUEUE_SIZE - 1)];
+    const Int32 diff = Int32(record->sequence.load(std::memory_order_acquire) - pos);
+
+    if(diff == 0)
+    {
+      if(myEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+    }
+    else if(diff < 0)
+    {
+      if(level != Level::ERR)
+      {
+        myDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      // A full queue keeps the writer busy, and it notifies us after writing
+      std::unique_lock<std::mutex> lock(myWriterMutex);
+      myWrittenWakeup.wait(lock, [this, record, pos] {
+        return myQuit || Int32(record->sequence.load(std::memory_order_acquire) - pos) >= 0;
+      });
+      if(myQuit)
+        return;
+      pos = myEnqueuePos.load(std::memory_order_relaxed);
+    }
+    else
+      pos = myEnqueuePos.load(std::memory_order_relaxed);
+  }
+
+  record->level = level;
+  record->time = std::chrono::system_clock::now();
+  record->thread = std::this_thread::get_id();
+  record->toConsole = myLogToConsole.load(std::memory_order_relaxed);
+  // The entry keeps its capacity, so this only allocates for long messages
+  record->message.assign(message);
+  record->sequence.store(pos + 1, std::memory_order_release);
+
+  // Only an idle writer needs to be notified; this pairs with the fence in
+  // runWriter(), so either the writer sees the message or we see it waiting
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if(myWriterSleeping.load(std::memory_order_relaxed))
+  {
+    { std::lock_guard<std::mutex> lock(myWriterMutex); }
+    myWriterWakeup.notify_one();
+  }
+
+  // Errors are only returned from once they are out
+  if(level == Level::ERR)
+  {
+    std::unique_lock<std::mutex> lock(myWriterMutex);
+    myWrittenWakeup.wait(lock, [this, pos] {
+      return myQuit || Int32(myWrittenPos.load(std::memory_order_acquire) - (pos + 1)) >= 0;
+    });
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Logger::drain()
+{
+  std::lock_guard<std::mutex> lock(myDrainMutex);
+  bool written = false;
+
+  const auto store = [&] (string&& message, bool toConsole) {
+    if(toConsole)
+    {
+      cout << message << '\n';
+      written = true;
+    }
+    myHistory.emplace_back(std::move(message));
+    if(myHistory.size() > HISTORY_SIZE)
+      myHistory.pop_front();
+  };
+
+  while(pending())
   {
-    cout << message << endl << std::flush;
-    myLogMessages += message + "\n";
+    const uInt32 pos = myDequeuePos.load(std::memory_order_relaxed);
+    Record& record = myQueue[pos & (QUEUE_SIZE - 1)];
+
+    store(string(record.message), record.toConsole);
+    record.sequence.store(pos + QUEUE_SIZE, std::memory_order_release);
+    myDequeuePos.store(pos + 1, std::memory_order_relaxed);
   }
-  else if(static_cast<int>(level) <= myLogLevel)
+
+  const uInt32 dropped = myDroppedMessages.exchange(0, std::memory_order_relaxed);
+  if(dropped > 0)
+    store("Logger: " + std::to_string(dropped) + " message(s) dropped, queue full",
+          myLogToConsole.load(std::memory_order_relaxed));
+
+  if(written)
+    cout << std::flush;
+
+  myWrittenPos.store(myDequeuePos.load(std::memory_order_relaxed),
+                     std::memory_order_release);
+  { std::lock_guard<std::mutex> lock(myWriterMutex); }
+  myWrittenWakeup.notify_all();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Logger::pending() const
+{
+  const uInt32 pos = myDequeuePos.load(std::memory_order_relaxed);
+
+  return Int32(myQueue[pos & (QUEUE_SIZE - 1)].sequence.load(std::memory_order_acquire)
+               - (pos + 1)) >= 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Logger::runWriter()
+{
+  std::unique_lock<std::mutex> lock(myWriterMutex);
+
+  while(!myQuit)
   {
-    if(myLogToConsole)
-      cout << message << endl << std::flush;
-    myLogMessages += message + "\n";
+    // Announce that we are about to wait before checking for messages, so
+    // a producer either sees this or its message is seen by the check
+    myWriterSleeping.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    myWriterWakeup.wait(lock, [this] {
+      return myQuit || pending() ||
+             myDroppedMessages.load(std::memory_order_relaxed) > 0;
+    });
+    myWriterSleeping.store(false, std::memory_order_relaxed);
+
+    lock.unlock();
+    drain();
+    lock.lock();
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string Logger::logMessages()
+{
+  drain();
+
+  std::lock_guard<std::mutex> lock(myDrainMutex);
+  string messages;
+  for(const auto& message: myHistory)
+    messages += message + "\n";
+
+  return messages;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Logger::setLogParameters(int logLevel, bool logToConsole)
 {
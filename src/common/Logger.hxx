@@ -19,9 +19,26 @@
 #define LOGGER_HXX
 
 #include <functional>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 #include "bspf.hxx"
 
+/**
+  Messages of all levels are put into a bounded lock-free queue, and written
+  to the console and the message history by a background thread.  The
+  calling thread, which may be the emulation thread, never does any I/O and
+  only allocates memory for unusually long messages.  If the queue is full,
+  the message is dropped and counted; the writer then logs how many messages
+  were lost.  The writer is woken up as soon as a message is queued.
+
+  Only errors wait until the writer has written them out (and flushed the
+  console), since the program may be about to terminate.
+*/
 class Logger {
 
   public:
@@ -46,24 +63,84 @@ class Logger {
 
     static void debug(const string& message);
 
+    /**
+      Answer whether messages of the given level are logged at all; use this
+      to avoid formatting messages which would be discarded anyway.
+    */
+    static bool enabled(Level level);
+
     void setLogParameters(int logLevel, bool logToConsole);
     void setLogParameters(Level logLevel, bool logToConsole);
 
-    const string& logMessages() const { return myLogMessages; }
+    /**
+      A snapshot of the most recent log messages, one per line.
+    */
+    string logMessages();
 
   protected:
-    Logger() = default;
+    Logger();
+    ~Logger();
 
   private:
-    int myLogLevel{static_cast<int>(Level::MAX)};
-    bool myLogToConsole{true};
+    // Number of entries in the queue (must be a power of two)
+    static constexpr uInt32 QUEUE_SIZE = 256;
+    // Space reserved for each message in the queue
+    static constexpr size_t MESSAGE_SIZE = 256;
+    // Number of messages kept in the history
+    static constexpr size_t HISTORY_SIZE = 1000;
+
+    struct Record {
+      std::atomic<uInt32> sequence{0};
+      Level level{Level::INFO};
+      std::chrono::system_clock::time_point time;
+      std::thread::id thread;
+      bool toConsole{false};
+      string message;
+    };
 
-    // The list of log messages
-    string myLogMessages;
+    std::atomic<int> myLogLevel{static_cast<int>(Level::MAX)};
+    std::atomic<bool> myLogToConsole{true};
+
+    // The queue of messages not yet written
+    std::array<Record, QUEUE_SIZE> myQueue;
+    std::atomic<uInt32> myEnqueuePos{0};
+    std::atomic<uInt32> myDequeuePos{0};
+    // Messages up to here have been written out and flushed
+    std::atomic<uInt32> myWrittenPos{0};
+    // Messages dropped because the queue was full
+    std::atomic<uInt32> myDroppedMessages{0};
+
+    // The most recent log messages; guarded by myDrainMutex, as is the
+    // reading side of the queue
+    std::deque<string> myHistory;
+    std::mutex myDrainMutex;
+
+    // The background thread writing out messages
+    std::thread myWriterThread;
+    std::mutex myWriterMutex;
+    std::condition_variable myWriterWakeup;
+    std::condition_variable myWrittenWakeup;
+    std::atomic<bool> myWriterSleeping{false};
+    bool myQuit{false};
 
   private:
     void logMessage(const string& message, Level level);
 
+    /**
+      Write out and store all queued messages.
+    */
+    void drain();
+
+    /**
+      Answer whether the next entry of the queue is ready to be written.
+    */
+    bool pending() const;
+
+    /**
+      The main loop of the writer thread.
+    */
+    void runWriter();
+
     Logger(const Logger&) = delete;
     Logger(Logger&&) = delete;
     Logger& operator=(const Logger&) = delete;
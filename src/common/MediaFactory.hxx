@@ -52,6 +52,9 @@
 #if defined(__LIB_RETRO__)
   #include "EventHandlerLIBRETRO.hxx"
   #include "FrameBufferLIBRETRO.hxx"
+#elif defined(HEADLESS_SUPPORT)
+  #include "EventHandlerHeadless.hxx"
+  #include "FrameBufferHeadless.hxx"
 #elif defined(SDL_SUPPORT)
   #include "EventHandlerSDL2.hxx"
   #include "FrameBufferSDL2.hxx"
@@ -132,6 +135,8 @@ class MediaFactory
     {
     #if defined(__LIB_RETRO__)
       return make_unique<FrameBufferLIBRETRO>(osystem);
+    #elif defined(HEADLESS_SUPPORT)
+      return make_unique<FrameBufferHeadless>(osystem);
     #elif defined(SDL_SUPPORT)
       return make_unique<FrameBufferSDL2>(osystem);
     #else
@@ -158,6 +163,8 @@ class MediaFactory
     {
     #if defined(__LIB_RETRO__)
       return make_unique<EventHandlerLIBRETRO>(osystem);
+    #elif defined(HEADLESS_SUPPORT)
+      return make_unique<EventHandlerHeadless>(osystem);
     #elif defined(SDL_SUPPORT)
       return make_unique<EventHandlerSDL2>(osystem);
     #else
@@ -176,6 +183,8 @@ class MediaFactory
     {
     #if defined(SDL_SUPPORT)
       return SDLVersion();
+    #elif defined(HEADLESS_SUPPORT)
+      return "Headless";
     #else
       return "Custom backend";
     #endif
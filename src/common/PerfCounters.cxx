@@ -0,0 +1,148 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <iomanip>
+
+#include "PerfCounters.hxx"
+
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+std::array<std::atomic<uInt64>, PerfCounters::NUM_COUNTERS> PerfCounters::myCounters{};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+PerfCounters::Values PerfCounters::values()
+{
+  Values values;
+
+  for(uInt32 i = 0; i < NUM_COUNTERS; ++i)
+    values[i] = myCounters[i].load(std::memory_order_relaxed);
+
+  return values;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const char* PerfCounters::name(Counter counter)
+{
+  static constexpr std::array<const char*, NUM_COUNTERS> NAMES = {
+    "frames", "cpuCycles", "tiaClocks", "tiaClocksCloned", "delayQueueEvents",
+    "bankSwitches", "armCalls", "armInstructions", "audioFragments",
+    "audioOverflows", "audioUnderruns", "emulationTimeNs", "renderTimeNs"
+  };
+
+  return NAMES[uInt32(counter)];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+StringList PerfCounters::summary(const Values& interval, double seconds)
+{
+  const auto get = [&interval](Counter counter) {
+    return double(interval[uInt32(counter)]);
+  };
+  const auto ratio = [](double value, double base) {
+    return base > 0 ? value / base : 0.0;
+  };
+  const double frames = get(Counter::frames);
+
+  StringList lines;
+  ostringstream ss;
+  ss << std::fixed << std::setprecision(1);
+
+  ss << "CPU " << std::setprecision(3) << ratio(get(Counter::cpuCycles), seconds * 1e6)
+     << " MHz  TIA cached " << std::setprecision(1)
+     << 100 * ratio(get(Counter::tiaClocksCloned), get(Counter::tiaClocks)) << "%";
+  lines.push_back(ss.str());  ss.str("");
+
+  ss << "delay queue " << ratio(get(Counter::delayQueueEvents), frames)
+     << "/fr  banks " << ratio(get(Counter::bankSwitches), frames) << "/fr";
+  lines.push_back(ss.str());  ss.str("");
+
+  ss << "ARM " << ratio(get(Counter::armCalls), frames) << " calls/fr  "
+     << std::setprecision(0) << ratio(get(Counter::armInstructions), get(Counter::armCalls))
+     << " instr/call" << std::setprecision(1);
+  lines.push_back(ss.str());  ss.str("");
+
+  ss << "audio " << ratio(get(Counter::audioFragments), seconds) << " frag/s  "
+     << interval[uInt32(Counter::audioUnderruns)] << " under  "
+     << interval[uInt32(Counter::audioOverflows)] << " over";
+  lines.push_back(ss.str());  ss.str("");
+
+  ss << "emulating " << 100 * ratio(get(Counter::emulationTime), seconds * 1e9)
+     << "%  rendering " << 100 * ratio(get(Counter::renderTime), seconds * 1e9) << "%";
+  lines.push_back(ss.str());
+
+  return lines;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+PerfCounters::Sampler::Sampler()
+  : myIntervalStart(steady_clock::now()),
+    myIntervalStartValues(values())
+{
+  myLastInterval.fill(0);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool PerfCounters::Sampler::update()
+{
+  const auto now = steady_clock::now();
+  const double seconds = duration<double>(now - myIntervalStart).count();
+
+  if(seconds < 1.0)
+    return false;
+
+  const Values current = values();
+  for(uInt32 i = 0; i < NUM_COUNTERS; ++i)
+    myLastInterval[i] = current[i] - myIntervalStartValues[i];
+
+  myIntervalStartValues = current;
+  myIntervalStart = now;
+  myLastIntervalSeconds = seconds;
+  myElapsedSeconds += seconds;
+
+  if(myCSV)
+  {
+    *myCSV << std::fixed << std::setprecision(3) << myElapsedSeconds
+           << "," << myLastIntervalSeconds;
+    for(const uInt64 value: myLastInterval)
+      *myCSV << "," << value;
+    *myCSV << endl;
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool PerfCounters::Sampler::logToCSV(const string& filename)
+{
+  myCSV.reset();
+  if(filename.empty())
+    return true;
+
+  auto out = make_unique<ofstream>(filename, std::ios::out | std::ios::app);
+  if(!*out)
+    return false;
+
+  *out << "seconds,interval";
+  for(uInt32 i = 0; i < NUM_COUNTERS; ++i)
+    *out << "," << name(Counter(i));
+  *out << endl;
+
+  myCSV = std::move(out);
+
+  return true;
+}
@@ -0,0 +1,186 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef PERF_COUNTERS_HXX
+#define PERF_COUNTERS_HXX
+
+#include <atomic>
+#include <chrono>
+
+#include "bspf.hxx"
+
+/**
+  Counters for the hot paths of the emulation core: CPU cycles, TIA clocks
+  and cached lines, delay queue events, bank switches, ARM code, audio
+  fragments and the time spent emulating vs. rendering.
+
+  Counting is only compiled in if PERFCOUNTER_SUPPORT is defined (configure
+  with '--enable-perfcounters'); otherwise PERF_COUNT and PERF_TIME expand
+  to nothing and all counters stay at zero.  The counters are updated from
+  the emulation, audio and main threads, so they are relaxed atomics.
+*/
+class PerfCounters
+{
+  public:
+    enum class Counter: uInt8 {
+      frames,
+      cpuCycles,
+      tiaClocks,
+      tiaClocksCloned,   // clocks of lines cloned from the line cache
+      delayQueueEvents,
+      bankSwitches,
+      armCalls,
+      armInstructions,
+      audioFragments,
+      audioOverflows,
+      audioUnderruns,
+      emulationTime,     // ns
+      renderTime,        // ns
+      numCounters
+    };
+    static constexpr uInt32 NUM_COUNTERS = uInt32(Counter::numCounters);
+
+    using Values = std::array<uInt64, NUM_COUNTERS>;
+
+    /**
+      Measures the lifetime of the object and adds it (in ns) to a counter.
+    */
+    class ScopedTimer
+    {
+      public:
+        explicit ScopedTimer(Counter counter)
+          : myCounter(counter), myStart(std::chrono::steady_clock::now()) { }
+        ~ScopedTimer() {
+          add(myCounter, uInt64(std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - myStart).count()));
+        }
+
+      private:
+        Counter myCounter;
+        std::chrono::steady_clock::time_point myStart;
+
+      private:
+        // Following constructors and assignment operators not supported
+        ScopedTimer() = delete;
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer(ScopedTimer&&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(ScopedTimer&&) = delete;
+    };
+
+    /**
+      Turns the running totals into per interval deltas (once per second),
+      which are what the frame stats overlay, the debugger and the CSV log
+      show.
+    */
+    class Sampler
+    {
+      public:
+        Sampler();
+
+        /**
+          Start a new interval if the current one is over, and log it to
+          the CSV file (if any).
+
+          @return  True if a new interval has been completed
+        */
+        bool update();
+
+        /**
+          The counters of the last completed interval, and its length.
+        */
+        const Values& lastInterval() const { return myLastInterval; }
+        double lastIntervalSeconds() const { return myLastIntervalSeconds; }
+
+        /**
+          Append a line per interval to the given file, or stop logging
+          if the filename is empty.
+
+          @return  False if the file couldn't be opened
+        */
+        bool logToCSV(const string& filename);
+
+      private:
+        std::chrono::steady_clock::time_point myIntervalStart;
+        Values myIntervalStartValues;
+        Values myLastInterval;
+        double myLastIntervalSeconds{0};
+        double myElapsedSeconds{0};
+
+        unique_ptr<ofstream> myCSV;
+
+      private:
+        // Following constructors and assignment operators not supported
+        Sampler(const Sampler&) = delete;
+        Sampler(Sampler&&) = delete;
+        Sampler& operator=(const Sampler&) = delete;
+        Sampler& operator=(Sampler&&) = delete;
+    };
+
+  public:
+    static void add(Counter counter, uInt64 amount) {
+      myCounters[uInt32(counter)].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /**
+      Whether counting has been compiled in.
+    */
+    static constexpr bool enabled() {
+    #ifdef PERFCOUNTER_SUPPORT
+      return true;
+    #else
+      return false;
+    #endif
+    }
+
+    /**
+      The running totals since startup.
+    */
+    static Values values();
+
+    static const char* name(Counter counter);
+
+    /**
+      Human readable summary of the counters over an interval, in
+      SUMMARY_LINES lines of at most 40 characters.
+    */
+    static StringList summary(const Values& interval, double seconds);
+    static constexpr uInt32 SUMMARY_LINES = 5;
+
+  private:
+    static std::array<std::atomic<uInt64>, NUM_COUNTERS> myCounters;
+
+  private:
+    // Following constructors and assignment operators not supported
+    PerfCounters() = delete;
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters(PerfCounters&&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+    PerfCounters& operator=(PerfCounters&&) = delete;
+};
+
+#ifdef PERFCOUNTER_SUPPORT
+  #define PERF_COUNT(counter, amount) \
+    PerfCounters::add(PerfCounters::Counter::counter, amount)
+  #define PERF_TIME(counter) \
+    PerfCounters::ScopedTimer perfTimer_##counter(PerfCounters::Counter::counter)
+#else
+  #define PERF_COUNT(counter, amount)
+  #define PERF_TIME(counter)
+#endif
+
+#endif
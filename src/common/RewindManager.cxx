@@ -22,6 +22,7 @@
 #include "StateManager.hxx"
 #include "TIA.hxx"
 #include "EventHandler.hxx"
+#include "ThreadPool.hxx"
 
 #include "RewindManager.hxx"
 
@@ -33,6 +34,11 @@ RewindManager::RewindManager(OSystem& system, StateManager& statemgr)
   setup();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RewindManager::~RewindManager()
+{
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void RewindManager::setup()
 {
@@ -135,9 +141,11 @@ bool RewindManager::addState(const string& message, bool timeMachine)
   Serializer& s = state.data;
 
   s.rewind();  // rewind Serializer internal buffers
+  state.chunk.reset();
   if(myStateManager.saveState(s) && myOSystem.console().tia().saveDisplay(s))
   {
-    myStateSize = std::max(myStateSize, uInt32(s.size()));
+    state.size = uInt32(s.size());
+    myStateSize = std::max(myStateSize, state.size);
     state.message = message;
     state.cycles = myOSystem.console().tia().cycles();
     myLastTimeMachineAdd = timeMachine;
@@ -241,40 +249,33 @@ string RewindManager::saveAllStates()
       << myOSystem.console().properties().get(PropType::Cart_Name)
       << ".sta";
 
-    Serializer out(buf.str(), Serializer::Mode::ReadWriteTrunc);
-    if (!out)
-      return "Can't save to all states file";
-
-    uInt32 curIdx = getCurrentIdx();
-    rewindStates(MAX_BUF_SIZE);
-    uInt32 numStates = uInt32(cyclesList().size());
-
-    // Save header
-    buf.str("");
-    out.putString(STATE_HEADER);
-    out.putShort(numStates);
-    out.putInt(myStateSize);
-
-    unique_ptr<uInt8[]> buffer = make_unique<uInt8[]>(myStateSize);
-    for (uInt32 i = 0; i < numStates; ++i)
+    // The states are only copied here, compressing and writing them happens
+    // in the background. States loaded from a file which haven't been used
+    // since are still compressed, and are written as they are.
+    StateArchive archive(STATE_HEADER);
+    for (RewindState& state : myStateList)
     {
-      RewindState& state = myStateList.current();
-      Serializer& s = state.data;
-      // Rewind Serializer internal buffers
-      s.rewind();
-      // Save state
-      s.getByteArray(buffer.get(), myStateSize);
-      out.putByteArray(buffer.get(), myStateSize);
-      out.putString(state.message);
-      out.putLong(state.cycles);
-
-      unwindStates(1);
+      if (state.chunk)
+        archive.chunks().push_back(state.chunk);
+      else
+      {
+        Serializer& s = state.data;
+        // Rewind Serializer internal buffers
+        s.rewind();
+        archive.chunks().push_back(
+          StateArchive::makeChunk(s, state.size, state.message, state.cycles));
+        s.rewind();
+      }
     }
-    // restore old state position
-    rewindStates(numStates - curIdx);
+    const size_t numStates = archive.chunks().size();
+
+    ostringstream done;
+    done << "Saved " << numStates << " states";
+    myStateManager.archiveWriter().submit(std::move(archive), buf.str(),
+                                          done.str(), "Error saving all states");
 
     buf.str("");
-    buf << "Saved " << numStates << " states";
+    buf << "Saving " << numStates << " states";
     return buf.str();
   }
   catch (...)
@@ -293,24 +294,21 @@ string RewindManager::loadAllStates()
       << myOSystem.console().properties().get(PropType::Cart_Name)
       << ".sta";
 
-    // Make sure the file can be opened for reading
-    Serializer in(buf.str(), Serializer::Mode::ReadOnly);
-    if (!in)
-      return "Can't load from all states file";
+    // Make sure a save into the same file has finished
+    myStateManager.archiveWriter().finish();
 
-    clear();
-    uInt32 numStates;
+    StateArchive archive;
+    if (!archive.load(buf.str()))
+      return "Can't load from all states file";
 
-    // Load header
-    buf.str("");
     // Check compatibility
-    if (in.getString() != STATE_HEADER)
+    if (archive.header() != STATE_HEADER)
       return "Incompatible all states file";
-    numStates = in.getShort();
-    myStateSize = in.getInt();
 
-    unique_ptr<uInt8[]> buffer = make_unique<uInt8[]>(myStateSize);
-    for (uInt32 i = 0; i < numStates; ++i)
+    clear();
+
+    // The states are decompressed when they are loaded for the first time
+    for (const auto& chunk : archive.chunks())
     {
       if (myStateList.full())
         compressStates();
@@ -319,22 +317,19 @@ string RewindManager::loadAllStates()
       // This updates the 'current' iterator inside the list
       myStateList.addLast();
       RewindState& state = myStateList.current();
-      Serializer& s = state.data;
-      // Rewind Serializer internal buffers
-      s.rewind();
 
-      // Fill new state with saved values
-      in.getByteArray(buffer.get(), myStateSize);
-      s.putByteArray(buffer.get(), myStateSize);
-      state.message = in.getString();
-      state.cycles = in.getLong();
+      state.chunk = chunk;
+      state.size = chunk->size;
+      state.message = chunk->message;
+      state.cycles = chunk->cycles;
+      myStateSize = std::max(myStateSize, state.size);
     }
 
     // initialize current state (parameters ignored)
     loadState(0, 0);
 
     buf.str("");
-    buf << "Loaded " << numStates << " states";
+    buf << "Loaded " << archive.chunks().size() << " states";
     return buf.str();
   }
   catch (...)
@@ -383,6 +378,16 @@ string RewindManager::loadState(Int64 startCycles, uInt32 numStates)
   RewindState& state = myStateList.current();
   Serializer& s = state.data;
 
+  // States loaded from a file are decompressed on first use
+  if(state.chunk)
+  {
+    s.rewind();
+    if(!StateArchive::extract(*state.chunk, s))
+      return "Invalid data in state";
+    s.rewind();
+    state.chunk.reset();
+  }
+
   myStateManager.loadState(s);
   myOSystem.console().tia().loadDisplay(s);
 
@@ -468,3 +473,43 @@ IntArray RewindManager::cyclesList() const
 
   return arr;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 RewindManager::visitStates(const StateVisitor& visitor)
+{
+  vector<RewindState*> states;
+  for(RewindState& state: myStateList)
+    states.push_back(&state);
+
+  if(states.empty())
+    return 0;
+
+  if(!myPool)
+    myPool = make_unique<ThreadPool>();
+
+  // Every job only touches its own state, so the serializers can be read
+  // concurrently
+  myPool->parallelFor(uInt32(states.size()), [&](uInt32 idx) {
+    RewindState& state = *states[idx];
+    ByteArray data(state.size);
+
+    if(state.chunk)
+    {
+      Serializer s;
+      if(!StateArchive::extract(*state.chunk, s))
+        return;
+      s.rewind();
+      s.getByteArray(data.data(), data.size());
+    }
+    else
+    {
+      Serializer& s = state.data;
+      s.rewind();
+      s.getByteArray(data.data(), data.size());
+      s.rewind();
+    }
+    visitor(idx, data.data(), uInt32(data.size()));
+  });
+
+  return uInt32(states.size());
+}
@@ -20,8 +20,12 @@
 
 class OSystem;
 class StateManager;
+class ThreadPool;
+
+#include <functional>
 
 #include "LinkedObjectPool.hxx"
+#include "StateArchive.hxx"
 #include "bspf.hxx"
 
 /**
@@ -47,6 +51,7 @@ class RewindManager
 {
   public:
     RewindManager(OSystem& system, StateManager& statemgr);
+    ~RewindManager();
 
   public:
     static constexpr uInt32 MAX_BUF_SIZE = 1000;
@@ -145,6 +150,8 @@ class RewindManager
     void resize(uInt32 size) { myStateList.resize(size); }
     void clear() {
       myStateSize = 0;
+      for(auto& state: myStateList)
+        state.chunk.reset();
       myStateList.clear();
     }
 
@@ -166,6 +173,23 @@ class RewindManager
     */
     IntArray cyclesList() const;
 
+    /**
+      Called for every state by visitStates(), with the (zero-based) index
+      of the state in the list and its serialized data.
+    */
+    using StateVisitor =
+      std::function<void(uInt32 idx, const uInt8* data, uInt32 size)>;
+
+    /**
+      Run the visitor on all states in the list, in parallel.  States loaded
+      from a file are decompressed into a temporary buffer; they stay
+      compressed in the list.  States which can't be decompressed are
+      skipped.  The visitor must not touch the console or the list.
+
+      @return  The number of states in the list
+    */
+    uInt32 visitStates(const StateVisitor& visitor);
+
   private:
     OSystem& myOSystem;
     StateManager& myStateManager;
@@ -182,6 +206,9 @@ class RewindManager
       Serializer data;  // actual save state
       string message;   // describes save state origin
       uInt64 cycles{0}; // cycles since emulation started
+      uInt32 size{0};   // size of the save state
+      // A state loaded from a file stays compressed until it is needed
+      StateArchive::ChunkPtr chunk;
 
       // We do nothing on object instantiation or copy
       // The goal of LinkedObjectPool is to not do any allocations at all
@@ -199,6 +226,9 @@ class RewindManager
     // frequent (de)-allocations)
     Common::LinkedObjectPool<RewindState> myStateList;
 
+    // Used to decode states in parallel; created on first use
+    unique_ptr<ThreadPool> myPool;
+
     /**
       Remove a save state from the list
     */
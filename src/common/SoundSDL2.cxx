@@ -38,6 +38,18 @@
 
 #include "ThreadDebugging.hxx"
 
+namespace {
+  // The resampling ratio is never adjusted by more than this; 0.5% is
+  // well below the threshold where a change in pitch can be heard
+  constexpr double MAX_RATE_ADJUSTMENT = 0.005;
+
+  // Weight of the current fill level in its running average
+  constexpr double FILL_SMOOTHING = 0.05;
+
+  // Drop the target fill level by one fragment after this long without underruns
+  constexpr uInt32 STABLE_SECONDS = 30;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 SoundSDL2::SoundSDL2(OSystem& osystem, AudioSettings& audioSettings)
   : Sound(osystem),
@@ -145,6 +157,19 @@ void SoundSDL2::open(shared_ptr<AudioQueue> audioQueue,
   myUnderrun = true;
   myCurrentFragment = nullptr;
 
+  // The smallest target that covers one hardware fragment; we start out with
+  // the configured headroom on top and adapt from there
+  myDynamicRate = myAudioSettings.dynamicRate();
+  myMinTargetFill = std::max(
+    myEmulationTiming->prebufferFragmentCount() - std::min(myAudioSettings.headroom(),
+                                                           myEmulationTiming->prebufferFragmentCount()),
+    1U);
+  myMaxTargetFill = std::max(myAudioQueue->capacity() - 1, myMinTargetFill);
+  myStableSamples = 0;
+  setTargetFill(BSPF::clamp(myEmulationTiming->prebufferFragmentCount(),
+                            myMinTargetFill, myMaxTargetFill));
+  myAverageFill = myTargetFill;
+
   // Adjust volume to that defined in settings
   setVolume(myAudioSettings.volume());
 
@@ -168,7 +193,10 @@ void SoundSDL2::close()
 
   mute(true);
 
-  if (myAudioQueue) myAudioQueue->closeSink(myCurrentFragment);
+  if (myAudioQueue) {
+    myAudioQueue->setTargetSize(0);
+    myAudioQueue->closeSink(myCurrentFragment);
+  }
   myAudioQueue.reset();
   myCurrentFragment = nullptr;
 }
@@ -293,6 +321,8 @@ string SoundSDL2::about() const
       << (0.5 * myAudioSettings.headroom()) << " frames" << endl
       << "    Buffer size:   " << std::fixed << std::setprecision(1)
       << (0.5 * myAudioSettings.bufferSize()) << " frames" << endl;
+  if (myDynamicRate)
+    buf << "    Dynamic rate:  enabled" << endl;
   return buf.str();
 }
 
@@ -303,6 +333,38 @@ void SoundSDL2::processFragment(float* stream, uInt32 length)
 
   for (uInt32 i = 0; i < length; ++i)
     stream[i] *= myVolumeFactor;
+
+  if (myDynamicRate)
+    updateRateControl(myHardwareSpec.channels > 1 ? length >> 1 : length);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundSDL2::updateRateControl(uInt32 samples)
+{
+  // A single callback only sees the queue at one point of the emulation
+  // timeslice, so we smooth the fill level before using it
+  myAverageFill += (static_cast<double>(myAudioQueue->size()) - myAverageFill) * FILL_SMOOTHING;
+
+  // Consume slightly faster while the queue is above target, and slightly
+  // slower while it is below. This absorbs any drift between the audio
+  // clock and the clock that drives emulation.
+  const double deviation = BSPF::clamp(
+    (myAverageFill - myTargetFill) / static_cast<double>(myTargetFill), -1., 1.);
+  myResampler->setRateAdjustment(1. + MAX_RATE_ADJUSTMENT * deviation);
+
+  // Try to get along with less headroom after a while without underruns
+  myStableSamples += samples;
+  if (myStableSamples >= uInt32(myHardwareSpec.freq) * STABLE_SECONDS) {
+    myStableSamples = 0;
+    if (myTargetFill > myMinTargetFill) setTargetFill(myTargetFill - 1);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundSDL2::setTargetFill(uInt32 targetFill)
+{
+  myTargetFill = targetFill;
+  myAudioQueue->setTargetSize(myDynamicRate ? myTargetFill : 0);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -310,13 +372,22 @@ void SoundSDL2::initResampler()
 {
   Resampler::NextFragmentCallback nextFragmentCallback = [this] () -> Int16* {
     Int16* nextFragment = nullptr;
+    const uInt32 prebufferFragmentCount = myDynamicRate ?
+        myTargetFill : myEmulationTiming->prebufferFragmentCount();
 
     if (myUnderrun)
-      nextFragment = myAudioQueue->size() >= myEmulationTiming->prebufferFragmentCount() ?
+      nextFragment = myAudioQueue->size() >= prebufferFragmentCount ?
           myAudioQueue->dequeue(myCurrentFragment) : nullptr;
-    else
+    else {
       nextFragment = myAudioQueue->dequeue(myCurrentFragment);
 
+      // With dynamic rate control, every underrun buys us more headroom
+      if (!nextFragment && myDynamicRate) {
+        myStableSamples = 0;
+        if (myTargetFill < myMaxTargetFill) setTargetFill(myTargetFill + 1);
+      }
+    }
+
     myUnderrun = nextFragment == nullptr;
     if (nextFragment) myCurrentFragment = nextFragment;
 
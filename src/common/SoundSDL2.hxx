@@ -129,6 +129,21 @@ class SoundSDL2 : public Sound
 
     void initResampler();
 
+    /**
+      Dynamic rate control: track the fill level of the audio queue and nudge
+      the resampling ratio towards keeping it at the target.  Called on the
+      audio thread after each fragment has been played.
+
+      @param samples  The number of (stereo / mono) samples just played
+    */
+    void updateRateControl(uInt32 samples);
+
+    /**
+      Change the number of fragments the queue should hold and let the
+      emulation know.
+    */
+    void setTargetFill(uInt32 targetFill);
+
   private:
     // Indicates if the sound device was successfully initialized
     bool myIsInitializedFlag{false};
@@ -149,6 +164,13 @@ class SoundSDL2 : public Sound
     Int16* myCurrentFragment{nullptr};
     bool myUnderrun{false};
 
+    // Dynamic rate control (see updateRateControl()); the target fill level
+    // grows with every underrun and shrinks again while playback is stable
+    bool myDynamicRate{false};
+    uInt32 myTargetFill{0}, myMinTargetFill{0}, myMaxTargetFill{0};
+    double myAverageFill{0};
+    uInt32 myStableSamples{0};
+
     unique_ptr<Resampler> myResampler;
 
     AudioSettings& myAudioSettings;
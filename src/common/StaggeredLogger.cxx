@@ -57,6 +57,9 @@ StaggeredLogger::~StaggeredLogger()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void StaggeredLogger::log()
 {
+  // Don't bother collecting events which won't be logged anyway
+  if(!Logger::enabled(myLevel)) return;
+
   std::lock_guard<std::mutex> lock(myMutex);
 
   _log();
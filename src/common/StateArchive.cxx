@@ -0,0 +1,346 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <cstdio>
+
+#if defined(ZIP_SUPPORT)
+  #include <zlib.h>
+#endif
+
+#include "Serializer.hxx"
+#include "ThreadPool.hxx"
+
+#include "StateArchive.hxx"
+
+namespace {
+  // Identifies the file format; increase the version on any change to it
+  const string ARCHIVE_MAGIC = "StellaStateArchive";
+  constexpr uInt32 ARCHIVE_VERSION = 1;
+
+  // Protects against allocating absurd amounts of memory for corrupt files
+  constexpr uInt32 MAX_CHUNKS = 100000;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StateArchive::isArchive(const string& filename)
+{
+  Serializer in(filename, Serializer::Mode::ReadOnly);
+  if(!in)
+    return false;
+
+  try
+  {
+    return in.getString() == ARCHIVE_MAGIC;
+  }
+  catch(...)
+  {
+    return false;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StateArchive::load(const string& filename)
+{
+  myHeader = "";
+  myChunks.clear();
+
+  Serializer in(filename, Serializer::Mode::ReadOnly);
+  if(!in)
+    return false;
+
+  try
+  {
+    if(in.getString() != ARCHIVE_MAGIC || in.getInt() > ARCHIVE_VERSION)
+      return false;
+
+    myHeader = in.getString();
+    const uInt32 numChunks = in.getInt();
+    if(numChunks > MAX_CHUNKS)
+      return false;
+
+    // The index
+    vector<uInt32> storedSizes(numChunks);
+    myChunks.reserve(numChunks);
+    for(uInt32 i = 0; i < numChunks; ++i)
+    {
+      auto chunk = make_shared<Chunk>();
+
+      storedSizes[i] = in.getInt();
+      chunk->size = in.getInt();
+      chunk->compression = Compression(in.getByte());
+      chunk->cycles = in.getLong();
+      chunk->message = in.getString();
+      myChunks.push_back(chunk);
+    }
+
+    // The chunks, in the same order
+    for(uInt32 i = 0; i < numChunks; ++i)
+    {
+      Chunk& chunk = *myChunks[i];
+
+      chunk.data.resize(storedSizes[i]);
+      in.getByteArray(chunk.data.data(), chunk.data.size());
+    }
+  }
+  catch(...)
+  {
+    myChunks.clear();
+    return false;
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StateArchive::save(const string& filename) const
+{
+  const string tempname = filename + ".tmp";
+
+  {
+    Serializer out(tempname, Serializer::Mode::ReadWriteTrunc);
+    if(!out)
+      return false;
+
+    try
+    {
+      out.putString(ARCHIVE_MAGIC);
+      out.putInt(ARCHIVE_VERSION);
+      out.putString(myHeader);
+      out.putInt(uInt32(myChunks.size()));
+
+      // The index
+      for(const auto& chunk: myChunks)
+      {
+        out.putInt(uInt32(chunk->data.size()));
+        out.putInt(chunk->size);
+        out.putByte(uInt8(chunk->compression));
+        out.putLong(chunk->cycles);
+        out.putString(chunk->message);
+      }
+
+      // The chunks, in the same order
+      for(const auto& chunk: myChunks)
+        out.putByteArray(chunk->data.data(), chunk->data.size());
+    }
+    catch(...)
+    {
+      std::remove(tempname.c_str());
+      return false;
+    }
+  }
+
+  // Replace the old file only now that the new one is complete
+  // (on some systems, rename fails if the target exists)
+  if(std::rename(tempname.c_str(), filename.c_str()) != 0)
+  {
+    std::remove(filename.c_str());
+    if(std::rename(tempname.c_str(), filename.c_str()) != 0)
+    {
+      std::remove(tempname.c_str());
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StateArchive::compress(ThreadPool* pool)
+{
+#if defined(ZIP_SUPPORT)
+  auto compressChunk = [this](uInt32 i) {
+    const Chunk& chunk = *myChunks[i];
+    if(chunk.compression != Compression::none || chunk.data.empty())
+      return;
+
+    auto packed = make_shared<Chunk>();
+    uLongf packedSize = compressBound(uLong(chunk.data.size()));
+
+    packed->data.resize(packedSize);
+    // Chunks which don't shrink are stored uncompressed
+    if(compress2(packed->data.data(), &packedSize, chunk.data.data(),
+                 uLong(chunk.data.size()), Z_BEST_SPEED) != Z_OK ||
+       packedSize >= chunk.data.size())
+      return;
+
+    packed->data.resize(packedSize);
+    packed->data.shrink_to_fit();
+    packed->message = chunk.message;
+    packed->cycles = chunk.cycles;
+    packed->size = chunk.size;
+    packed->compression = Compression::zlib;
+
+    myChunks[i] = packed;
+  };
+
+  if(pool)
+    pool->parallelFor(uInt32(myChunks.size()), compressChunk);
+  else
+    for(uInt32 i = 0; i < myChunks.size(); ++i)
+      compressChunk(i);
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+StateArchive::ChunkPtr StateArchive::makeChunk(Serializer& in, uInt32 size,
+                                               const string& message, uInt64 cycles)
+{
+  auto chunk = make_shared<Chunk>();
+
+  chunk->message = message;
+  chunk->cycles = cycles;
+  chunk->size = size;
+  chunk->data.resize(size);
+  in.getByteArray(chunk->data.data(), size);
+
+  return chunk;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StateArchive::extract(const Chunk& chunk, Serializer& out)
+{
+  try
+  {
+    switch(chunk.compression)
+    {
+      case Compression::none:
+        if(chunk.data.size() != chunk.size)
+          return false;
+        out.putByteArray(chunk.data.data(), chunk.size);
+        return true;
+
+    #if defined(ZIP_SUPPORT)
+      case Compression::zlib:
+      {
+        ByteArray buffer(chunk.size);
+        uLongf size = chunk.size;
+
+        if(uncompress(buffer.data(), &size, chunk.data.data(),
+                      uLong(chunk.data.size())) != Z_OK || size != chunk.size)
+          return false;
+        out.putByteArray(buffer.data(), chunk.size);
+        return true;
+      }
+    #endif
+
+      default:
+        return false;
+    }
+  }
+  catch(...)
+  {
+    return false;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+StateArchiveWriter::StateArchiveWriter()
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+StateArchiveWriter::~StateArchiveWriter()
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myQuit = true;
+  }
+
+  myWakeupCondition.notify_one();
+
+  if(myThread.joinable())
+    myThread.join();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StateArchiveWriter::submit(StateArchive archive, const string& filename,
+                                const string& doneMessage, const string& errorMessage)
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+
+    // The thread is only started when it is needed for the first time
+    if(!myThread.joinable())
+      myThread = std::thread(&StateArchiveWriter::threadMain, this);
+
+    myJobs.push_back({std::move(archive), filename, doneMessage, errorMessage});
+  }
+
+  myWakeupCondition.notify_one();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StateArchiveWriter::poll(string& message)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  if(myResults.empty())
+    return false;
+
+  message = myResults.front();
+  myResults.pop_front();
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StateArchiveWriter::finish()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+
+  myIdleCondition.wait(lock, [this] () { return myJobs.empty() && !myBusy; });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StateArchiveWriter::threadMain()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+
+  while(true)
+  {
+    myWakeupCondition.wait(lock, [this] () { return myQuit || !myJobs.empty(); });
+
+    // Pending archives are still written when quitting
+    if(myJobs.empty())
+      break;
+
+    Job job = std::move(myJobs.front());
+    myJobs.pop_front();
+    myBusy = true;
+
+    lock.unlock();
+
+    bool success = false;
+    try
+    {
+      if(!myPool)
+        myPool = make_unique<ThreadPool>();
+
+      job.archive.compress(myPool.get());
+      success = job.archive.save(job.filename);
+    }
+    catch(...)
+    {
+    }
+
+    lock.lock();
+
+    myResults.push_back(success ? job.doneMessage : job.errorMessage);
+    myBusy = false;
+    myIdleCondition.notify_all();
+  }
+}
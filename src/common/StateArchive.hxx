@@ -0,0 +1,194 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef STATE_ARCHIVE_HXX
+#define STATE_ARCHIVE_HXX
+
+class Serializer;
+class ThreadPool;
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "bspf.hxx"
+
+/**
+  A file containing one or more save states; used for the state slots and
+  for the Time Machine states.
+
+  The file starts with a versioned header and an index of all states,
+  followed by the state data.  Every state is stored in a chunk of its own
+  and (when zlib is available) compressed separately, so the chunks can be
+  compressed in parallel, and any state can be located and decompressed
+  without touching the others.  Chunks are read in their compressed form,
+  and only decompressed when the state is actually needed.
+
+  Files are written to a temporary file first, which then replaces the
+  original file, so an interrupted save never leaves a truncated file behind.
+*/
+class StateArchive
+{
+  public:
+    enum class Compression : uInt8 {
+      none = 0,
+      zlib = 1
+    };
+
+    struct Chunk {
+      string message;     // describes save state origin
+      uInt64 cycles{0};   // cycles since emulation started
+      uInt32 size{0};     // size of the uncompressed state
+      Compression compression{Compression::none};
+      ByteArray data;     // the state, as stored in the file
+    };
+    using ChunkPtr = shared_ptr<Chunk>;
+
+  public:
+    StateArchive() = default;
+    explicit StateArchive(const string& header) : myHeader(header) { }
+
+    /**
+      Answers whether the given file is a state archive, as opposed to a
+      state file in the older, uncompressed format.
+    */
+    static bool isArchive(const string& filename);
+
+    /**
+      Read the header, the index and the (still compressed) chunks of the
+      given file.
+
+      @return  False on any errors, else true
+    */
+    bool load(const string& filename);
+
+    /**
+      Write all chunks to the given file, replacing it when complete.
+
+      @return  False on any errors, else true
+    */
+    bool save(const string& filename) const;
+
+    /**
+      Compress all chunks which are not compressed yet.  The chunks are
+      replaced, not modified, since they may be shared with other archives.
+
+      @param pool  Optional thread pool to compress the chunks in parallel
+    */
+    void compress(ThreadPool* pool = nullptr);
+
+    /**
+      Create an uncompressed chunk from the next 'size' bytes of the given
+      Serializer.
+    */
+    static ChunkPtr makeChunk(Serializer& in, uInt32 size,
+                              const string& message = "", uInt64 cycles = 0);
+
+    /**
+      Decompress the chunk into the given Serializer, at its current position.
+
+      @return  False on any errors, else true
+    */
+    static bool extract(const Chunk& chunk, Serializer& out);
+
+    /**
+      The header describes the format of the states inside the archive
+      (normally STATE_HEADER).
+    */
+    const string& header() const { return myHeader; }
+
+    vector<ChunkPtr>& chunks() { return myChunks; }
+    const vector<ChunkPtr>& chunks() const { return myChunks; }
+
+  private:
+    string myHeader;
+    vector<ChunkPtr> myChunks;
+};
+
+/**
+  Compresses and writes state archives in a background thread, so saving
+  states never stalls emulation.  Archives are written in the order in which
+  they were submitted; the result of each save is reported via poll().
+*/
+class StateArchiveWriter
+{
+  public:
+    StateArchiveWriter();
+
+    /**
+      The destructor writes all archives still pending.
+    */
+    ~StateArchiveWriter();
+
+    /**
+      Queue an archive for writing.
+
+      @param archive       The archive to write
+      @param filename      The file to write to
+      @param doneMessage   Reported if the archive was written successfully
+      @param errorMessage  Reported if writing the archive failed
+    */
+    void submit(StateArchive archive, const string& filename,
+                const string& doneMessage, const string& errorMessage);
+
+    /**
+      Get the result of the next save which finished since the last call.
+
+      @return  True if a result was available
+    */
+    bool poll(string& message);
+
+    /**
+      Block until all archives submitted so far have been written; used
+      before reading a file which may still be pending.
+    */
+    void finish();
+
+  private:
+    void threadMain();
+
+  private:
+    struct Job {
+      StateArchive archive;
+      string filename;
+      string doneMessage;
+      string errorMessage;
+    };
+
+    std::deque<Job> myJobs;
+    std::deque<string> myResults;
+    bool myBusy{false};
+    bool myQuit{false};
+
+    std::thread myThread;
+    std::mutex myMutex;
+    std::condition_variable myWakeupCondition;
+    std::condition_variable myIdleCondition;
+
+    // Used for compressing the chunks; created by the writer thread
+    unique_ptr<ThreadPool> myPool;
+
+  private:
+    // Following constructors and assignment operators not supported
+    StateArchiveWriter(const StateArchiveWriter&) = delete;
+    StateArchiveWriter(StateArchiveWriter&&) = delete;
+    StateArchiveWriter& operator=(const StateArchiveWriter&) = delete;
+    StateArchiveWriter& operator=(StateArchiveWriter&&) = delete;
+};
+
+#endif
@@ -24,6 +24,7 @@
 #include "System.hxx"
 #include "Serializable.hxx"
 #include "RewindManager.hxx"
+#include "StateArchive.hxx"
 
 #include "StateManager.hxx"
 
@@ -34,6 +35,7 @@ StateManager::StateManager(OSystem& osystem)
   : myOSystem(osystem)
 {
   myRewindManager = make_unique<RewindManager>(myOSystem, *this);
+  myArchiveWriter = make_unique<StateArchiveWriter>();
   reset();
 }
 
@@ -173,6 +175,11 @@ bool StateManager::windStates(uInt32 numStates, bool unwind)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void StateManager::update()
 {
+  // Report saves which have finished in the background
+  string message;
+  while(myArchiveWriter->poll(message))
+    myOSystem.frameBuffer().showMessage(message);
+
   switch(myActiveMode)
   {
     case Mode::TimeMachine:
@@ -208,10 +215,28 @@ void StateManager::loadState(int slot)
     buf << myOSystem.stateDir()
         << myOSystem.console().properties().get(PropType::Cart_Name)
         << ".st" << slot;
+    const string filename = buf.str();
+
+    // Make sure a save into the same slot has finished
+    myArchiveWriter->finish();
 
-    // Make sure the file can be opened in read-only mode
-    Serializer in(buf.str(), Serializer::Mode::ReadOnly);
-    if(!in)
+    // Older state files contain the uncompressed state directly
+    unique_ptr<Serializer> in;
+    if(StateArchive::isArchive(filename))
+    {
+      StateArchive archive;
+      in = make_unique<Serializer>();
+      if(archive.load(filename) && !archive.chunks().empty() &&
+         StateArchive::extract(*archive.chunks().front(), *in))
+        in->rewind();
+      else
+        in.reset();
+    }
+    else
+      in = make_unique<Serializer>(filename, Serializer::Mode::ReadOnly);
+
+    // Make sure the state could be read
+    if(!in || !*in)
     {
       buf.str("");
       buf << "Can't open/load from state file " << slot;
@@ -224,11 +249,11 @@ void StateManager::loadState(int slot)
     buf.str("");
     try
     {
-      if(in.getString() != STATE_HEADER)
+      if(in->getString() != STATE_HEADER)
         buf << "Incompatible state " << slot << " file";
       else
       {
-        if(myOSystem.console().load(in))
+        if(myOSystem.console().load(*in))
           buf << "State " << slot << " loaded";
         else
           buf << "Invalid data in state " << slot << " file";
@@ -254,16 +279,11 @@ void StateManager::saveState(int slot)
     buf << myOSystem.stateDir()
         << myOSystem.console().properties().get(PropType::Cart_Name)
         << ".st" << slot;
+    const string filename = buf.str();
 
-    // Make sure the file can be opened for writing
-    Serializer out(buf.str());
-    if(!out)
-    {
-      buf.str("");
-      buf << "Can't open/save to state file " << slot;
-      myOSystem.frameBuffer().showMessage(buf.str());
-      return;
-    }
+    // The state is only taken here, compressing and writing it happens in
+    // the background
+    Serializer out;
 
     try
     {
@@ -273,6 +293,7 @@ void StateManager::saveState(int slot)
     }
     catch(...)
     {
+      buf.str("");
       buf << "Error saving state " << slot;
       myOSystem.frameBuffer().showMessage(buf.str());
       return;
@@ -280,19 +301,34 @@ void StateManager::saveState(int slot)
 
     // Do a complete state save using the Console
     buf.str("");
+    buf << "Error saving state " << slot;
     if(myOSystem.console().save(out))
     {
-      buf << "State " << slot << " saved";
+      StateArchive archive(STATE_HEADER);
+      try
+      {
+        const uInt32 size = uInt32(out.size());
+        out.rewind();
+        archive.chunks().push_back(StateArchive::makeChunk(out, size));
+      }
+      catch(...)
+      {
+        myOSystem.frameBuffer().showMessage(buf.str());
+        return;
+      }
+
+      // The result is shown once the state has been written
+      ostringstream done;
+      done << "State " << slot << " saved";
       if(myOSystem.settings().getBool("autoslot"))
       {
         myCurrentSlot = (slot + 1) % 10;
-        buf << ", switching to slot " << myCurrentSlot;
+        done << ", switching to slot " << myCurrentSlot;
       }
+      myArchiveWriter->submit(std::move(archive), filename, done.str(), buf.str());
     }
     else
-      buf << "Error saving state " << slot;
-
-    myOSystem.frameBuffer().showMessage(buf.str());
+      myOSystem.frameBuffer().showMessage(buf.str());
   }
 }
 
@@ -22,6 +22,7 @@
 
 class OSystem;
 class RewindManager;
+class StateArchiveWriter;
 
 #include "Serializer.hxx"
 
@@ -158,6 +159,11 @@ class StateManager
     */
     RewindManager& rewindManager() const { return *myRewindManager; }
 
+    /**
+      Writes the state files in the background
+    */
+    StateArchiveWriter& archiveWriter() const { return *myArchiveWriter; }
+
   private:
     // The parent OSystem object
     OSystem& myOSystem;
@@ -178,6 +184,9 @@ class StateManager
     // Stored savestates to be later rewound
     unique_ptr<RewindManager> myRewindManager;
 
+    // Compresses and writes state files without stalling emulation
+    unique_ptr<StateArchiveWriter> myArchiveWriter;
+
   private:
     // Following constructors and assignment operators not supported
     StateManager() = delete;
@@ -0,0 +1,121 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <atomic>
+#include <exception>
+
+#include "ThreadPool.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ThreadPool::ThreadPool(uInt32 numThreads)
+{
+  if (numThreads == 0)
+    numThreads = std::max(std::thread::hardware_concurrency(), 1U);
+
+  myWorkers.reserve(numThreads);
+  for (uInt32 i = 0; i < numThreads; ++i)
+    myWorkers.emplace_back(&ThreadPool::threadMain, this);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myQuit = true;
+  }
+
+  myWakeupCondition.notify_all();
+
+  for (std::thread& worker : myWorkers)
+    worker.join();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::future<void> ThreadPool::submit(std::function<void()> task)
+{
+  std::packaged_task<void()> packagedTask(std::move(task));
+  std::future<void> future = packagedTask.get_future();
+
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myTasks.push(std::move(packagedTask));
+  }
+
+  myWakeupCondition.notify_one();
+
+  return future;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThreadPool::parallelFor(uInt32 count, const std::function<void(uInt32)>& job)
+{
+  if (count == 0) return;
+
+  std::atomic<uInt32> nextIndex{0};
+  std::exception_ptr firstException;
+  std::mutex exceptionMutex;
+
+  auto work = [&] () {
+    for (uInt32 i = nextIndex++; i < count; i = nextIndex++) {
+      try {
+        job(i);
+      }
+      catch (...) {
+        std::lock_guard<std::mutex> lock(exceptionMutex);
+        if (!firstException) firstException = std::current_exception();
+      }
+    }
+  };
+
+  // The calling thread does its share of the work, so we need at most
+  // count - 1 helpers
+  const uInt32 helperCount = std::min(count - 1, size());
+  vector<std::future<void>> helpers;
+  helpers.reserve(helperCount);
+
+  for (uInt32 i = 0; i < helperCount; ++i)
+    helpers.push_back(submit(work));
+
+  work();
+
+  for (std::future<void>& helper : helpers)
+    helper.wait();
+
+  if (firstException) std::rethrow_exception(firstException);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThreadPool::threadMain()
+{
+  while (true) {
+    std::packaged_task<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(myMutex);
+
+      myWakeupCondition.wait(lock, [this] () { return myQuit || !myTasks.empty(); });
+
+      if (myTasks.empty()) return;
+
+      task = std::move(myTasks.front());
+      myTasks.pop();
+    }
+
+    task();
+  }
+}
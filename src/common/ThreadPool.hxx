@@ -0,0 +1,94 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef THREAD_POOL_HXX
+#define THREAD_POOL_HXX
+
+#include <functional>
+#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <queue>
+
+#include "bspf.hxx"
+
+/**
+ * A fixed size pool of worker threads. Tasks are queued and picked up by the
+ * first idle worker.
+ *
+ * Tasks must not block on other tasks queued to the same pool, as this may
+ * deadlock if all workers are waiting. In particular, parallelFor must not be
+ * nested.
+ */
+class ThreadPool
+{
+  public:
+
+    /**
+      Create the pool and start the workers. If numThreads is zero, one worker
+      per hardware thread is started.
+     */
+    explicit ThreadPool(uInt32 numThreads = 0);
+
+    /**
+      The destructor finishes all queued tasks and joins the workers.
+     */
+    ~ThreadPool();
+
+    /**
+      The number of worker threads.
+     */
+    uInt32 size() const { return uInt32(myWorkers.size()); }
+
+    /**
+      Queue a task for execution. The returned future becomes ready once the
+      task has finished and rethrows any exception the task threw.
+     */
+    std::future<void> submit(std::function<void()> task);
+
+    /**
+      Run job(i) for every i in [0, count) and block until all jobs have
+      finished. The calling thread takes part in the work. The first exception
+      thrown by a job is rethrown after all jobs have finished.
+     */
+    void parallelFor(uInt32 count, const std::function<void(uInt32)>& job);
+
+  private:
+
+    void threadMain();
+
+  private:
+
+    vector<std::thread> myWorkers;
+
+    std::queue<std::packaged_task<void()>> myTasks;
+
+    std::mutex myMutex;
+    std::condition_variable myWakeupCondition;
+
+    bool myQuit{false};
+
+  private:
+    // Following constructors and assignment operators not supported
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+};
+
+#endif // THREAD_POOL_HXX
@@ -17,56 +17,33 @@
 
 #if defined(ZIP_SUPPORT)
 
+#include <sys/stat.h>
 #include <zlib.h>
 
+#if defined(BSPF_WINDOWS)
+  #include <windows.h>
+  // winnt.h defines ARRAYSIZE, but we want our own one...
+  #undef ARRAYSIZE
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <unistd.h>
+#endif
+
 #include "Bankswitch.hxx"
 #include "ZipHandler.hxx"
 
+std::array<ZipHandler::ZipFilePtr, ZipHandler::CACHE_SIZE> ZipHandler::ourZipCache;
+std::mutex ZipHandler::ourZipCacheMutex;
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ZipHandler::open(const string& filename)
 {
-  // Close already open file (if any) and add to cache
-  addToCache();
-
   // Ensure we start with a nullptr result
   myZip.reset();
+  myHeader = nullptr;
 
-  ZipFilePtr ptr = findCached(filename);
-  if(ptr)
-  {
-    // Only a previously used entry will exist in the cache, so we know it's valid
-    myZip = std::move(ptr);
-
-    // Was already initialized; we just need to re-open it
-    if(!myZip->open())
-      throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-  }
-  else
-  {
-    // Allocate memory for the ZipFile structure
-    ptr = make_unique<ZipFile>(filename);
-    if(ptr == nullptr)
-      throw runtime_error(errorMessage(ZipError::OUT_OF_MEMORY));
-
-    // Open the file and initialize it
-    if(!ptr->open())
-      throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-    try
-    {
-      ptr->initialize();
-    }
-    catch(...)
-    {
-      throw;
-    }
-
-    myZip = std::move(ptr);
-
-    // Count ROM files (we do it here so it will be cached)
-    while(hasNext())
-      if(Bankswitch::isValidRomName(next()))
-        myZip->myRomfiles++;
-  }
+  myZip = findCached(filename);
 
   reset();  // Reset iterator to beginning for subsequent use
 }
@@ -75,14 +52,13 @@ void ZipHandler::open(const string& filename)
 void ZipHandler::reset()
 {
   // Reset the position and go from there
-  if(myZip)
-    myZip->myCdPos = 0;
+  myPos = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ZipHandler::hasNext() const
 {
-  return myZip && (myZip->myCdPos < myZip->myEcd.cdSize);
+  return myZip && (myPos < myZip->myHeaders.size());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -90,34 +66,38 @@ const string& ZipHandler::next()
 {
   if(hasNext())
   {
-    const ZipHeader* header = myZip->nextFile();
-    if(!header || header->uncompressedLength == 0)
-      return next();
-    else
-      return header->filename;
+    myHeader = &myZip->myHeaders[myPos++];
+    return myHeader->filename;
   }
   return EmptyString;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ZipHandler::select(const string& filename)
+{
+  if(!myZip)
+    return false;
+
+  const auto it = myZip->myIndex.find(filename);
+  if(it == myZip->myIndex.end())
+    return false;
+
+  myHeader = &myZip->myHeaders[it->second];
+  return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt64 ZipHandler::decompress(ByteBuffer& image)
 {
-  if(myZip && myZip->myHeader.uncompressedLength > 0)
+  if(myZip && myHeader && myHeader->uncompressedLength > 0)
   {
-    uInt64 length = myZip->myHeader.uncompressedLength;
+    uInt64 length = myHeader->uncompressedLength;
     image = make_unique<uInt8[]>(length);
     if(image == nullptr)
       throw runtime_error(errorMessage(ZipError::OUT_OF_MEMORY));
 
-    try
-    {
-      myZip->decompress(image, length);
-      return length;
-    }
-    catch(const ZipError& err)
-    {
-      throw runtime_error(errorMessage(err));
-    }
+    myZip->decompress(*myHeader, image.get(), length);
+    return length;
   }
   else
     throw runtime_error("Invalid ZIP archive");
@@ -141,371 +121,342 @@ string ZipHandler::errorMessage(ZipError err)
   return zip_error_s[static_cast<int>(err)];
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int64 ZipHandler::modificationTime(const string& filename)
+{
+  struct stat st;
+
+  return stat(filename.c_str(), &st) == 0 ? Int64(st.st_mtime) : 0;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 ZipHandler::ZipFilePtr ZipHandler::findCached(const string& filename)
 {
-  for(size_t cachenum = 0; cachenum < myZipCache.size(); ++cachenum)
+  const Int64 modTime = modificationTime(filename);
+
   {
-    // If we have a valid entry and it matches our filename,
-    // use it and remove from the cache
-    if(myZipCache[cachenum] && (filename == myZipCache[cachenum]->myFilename))
+    std::lock_guard<std::mutex> lock(ourZipCacheMutex);
+
+    for(size_t cachenum = 0; cachenum < ourZipCache.size(); ++cachenum)
     {
-      ZipFilePtr result;
-      std::swap(myZipCache[cachenum], result);
-      return result;
+      // If we have a valid entry and it matches our filename, move it to the
+      // front and use it, unless the file has changed since it was parsed
+      if(ourZipCache[cachenum] && (filename == ourZipCache[cachenum]->myFilename))
+      {
+        ZipFilePtr result = std::move(ourZipCache[cachenum]);
+        for( ; cachenum > 0; --cachenum)
+          ourZipCache[cachenum] = std::move(ourZipCache[cachenum - 1]);
+
+        if(result->myModTime != modTime)
+          break;
+
+        ourZipCache[0] = result;
+        return result;
+      }
     }
   }
-  return ZipFilePtr();
-}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::addToCache()
-{
-  if(myZip == nullptr)
-    return;
+  // Parsing may take a while, so don't block other handlers meanwhile
+  ZipFilePtr result = make_shared<ZipFile>(filename, modTime);
 
-  // Close the open file
-  myZip->close();
+  std::lock_guard<std::mutex> lock(ourZipCacheMutex);
 
-  // Find the first nullptr entry in the cache
+  // Find the first nullptr entry in the cache; if there is no room left,
+  // the bottommost entry is dropped
   size_t cachenum;
-  for(cachenum = 0; cachenum < myZipCache.size(); ++cachenum)
-    if(myZipCache[cachenum] == nullptr)
+  for(cachenum = 0; cachenum < ourZipCache.size() - 1; ++cachenum)
+    if(ourZipCache[cachenum] == nullptr)
       break;
 
-  // If no room left in the cache, free the bottommost entry
-  if(cachenum == myZipCache.size())
-  {
-    cachenum--;
-    myZipCache[cachenum].reset();
-  }
-
   for( ; cachenum > 0; --cachenum)
-    myZipCache[cachenum] = std::move(myZipCache[cachenum - 1]);
-  myZipCache[0] = std::move(myZip);
-
-#if 0
-  cerr << "\nCACHE contents:\n";
-    for(cachenum = 0; cachenum < myZipCache.size(); ++cachenum)
-      if(myZipCache[cachenum] != nullptr)
-        cerr << "  " << cachenum << " : " << myZipCache[cachenum]->filename << endl;
-  cerr << endl;
-#endif
-}
+    ourZipCache[cachenum] = std::move(ourZipCache[cachenum - 1]);
+  ourZipCache[0] = result;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-ZipHandler::ZipFile::ZipFile(const string& filename)
-  : myFilename(filename),
-    myBuffer(make_unique<uInt8[]>(DECOMPRESS_BUFSIZE))
-{
-  std::fill(myBuffer.get(), myBuffer.get() + DECOMPRESS_BUFSIZE, 0);
+  return result;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ZipHandler::ZipFile::open()
+ZipHandler::MappedFile::MappedFile(const string& filename)
 {
-  myStream.open(myFilename, fstream::in | fstream::binary);
-  if(!myStream.is_open())
+#if defined(BSPF_WINDOWS)
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(file == INVALID_HANDLE_VALUE)
+    throw runtime_error(errorMessage(ZipError::FILE_ERROR));
+  myFileHandle = file;
+
+  LARGE_INTEGER size;
+  if(!GetFileSizeEx(file, &size))
   {
-    myLength = 0;
-    return false;
+    CloseHandle(file);
+    throw runtime_error(errorMessage(ZipError::FILE_ERROR));
   }
-  myStream.exceptions( std::ios_base::failbit | std::ios_base::badbit | std::ios_base::eofbit );
-  myStream.seekg(0, std::ios::end);
-  myLength = myStream.tellg();
-  myStream.seekg(0, std::ios::beg);
+  mySize = uInt64(size.QuadPart);
 
-  return true;
-}
+  // Empty files can't be mapped, but they aren't valid ZIP files anyway
+  if(mySize == 0)
+    return;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::ZipFile::initialize()
-{
-  try
+  myMappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if(myMappingHandle)
+    myData = static_cast<const uInt8*>(
+      MapViewOfFile(myMappingHandle, FILE_MAP_READ, 0, 0, 0));
+  if(!myData)
   {
-    // Read ecd data
-    readEcd();
-
-    // Verify that we can work with this zipfile (no disk spanning allowed)
-    if(myEcd.diskNumber != myEcd.cdStartDiskNumber ||
-       myEcd.cdDiskEntries != myEcd.cdTotalEntries)
-      throw runtime_error(errorMessage(ZipError::UNSUPPORTED));
-
-    // Allocate memory for the central directory
-    myCd = make_unique<uInt8[]>(myEcd.cdSize + 1);
-    if(myCd == nullptr)
-      throw runtime_error(errorMessage(ZipError::OUT_OF_MEMORY));
+    if(myMappingHandle)
+      CloseHandle(myMappingHandle);
+    CloseHandle(file);
+    throw runtime_error(errorMessage(ZipError::FILE_ERROR));
+  }
+#else
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if(fd < 0)
+    throw runtime_error(errorMessage(ZipError::FILE_ERROR));
 
-    // Read the central directory
-    uInt64 read_length = 0;
-    bool success = readStream(myCd, myEcd.cdStartDiskOffset, myEcd.cdSize, read_length);
-    if(!success)
-      throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-    else if(read_length != myEcd.cdSize)
-      throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
+  struct stat st;
+  if(fstat(fd, &st) != 0)
+  {
+    ::close(fd);
+    throw runtime_error(errorMessage(ZipError::FILE_ERROR));
   }
-  catch(...)
+  mySize = uInt64(st.st_size);
+
+  // Empty files can't be mapped, but they aren't valid ZIP files anyway
+  if(mySize > 0)
   {
-    throw;
+    void* data = mmap(nullptr, mySize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(data == MAP_FAILED)
+    {
+      ::close(fd);
+      throw runtime_error(errorMessage(ZipError::FILE_ERROR));
+    }
+    myData = static_cast<const uInt8*>(data);
   }
+
+  // The mapping stays valid after closing the file
+  ::close(fd);
+#endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::ZipFile::close()
+ZipHandler::MappedFile::~MappedFile()
 {
-  if(myStream.is_open())
-    myStream.close();
+#if defined(BSPF_WINDOWS)
+  if(myData)
+    UnmapViewOfFile(myData);
+  if(myMappingHandle)
+    CloseHandle(myMappingHandle);
+  if(myFileHandle)
+    CloseHandle(myFileHandle);
+#else
+  if(myData)
+    munmap(const_cast<uInt8*>(myData), mySize);
+#endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::ZipFile::readEcd()
+ZipHandler::ZipFile::ZipFile(const string& filename, Int64 modTime)
+  : myFilename(filename),
+    myModTime(modTime),
+    myFile(filename)
 {
-  uInt64 buflen = 1024;
-  ByteBuffer buffer;
+  // Read ecd data
+  readEcd();
 
-  // We may need multiple tries
-  while(buflen < 65536)
-  {
-    uInt64 read_length;
-
-    // Max out the buf length at the size of the file
-    if(buflen > myLength)
-      buflen = myLength;
-
-    // Allocate buffer
-    buffer = make_unique<uInt8[]>(buflen + 1);
-    if(buffer == nullptr)
-      throw runtime_error(errorMessage(ZipError::OUT_OF_MEMORY));
-
-    // Read in one buffers' worth of data
-    bool success = readStream(buffer, myLength - buflen, buflen, read_length);
-    if(!success || read_length != buflen)
-      throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-
-    // Find the ECD signature
-    Int32 offset;
-		for(offset = Int32(buflen - EcdReader::minimumLength()); offset >= 0; --offset)
-    {
-      EcdReader reader(buffer.get() + offset);
-      if(reader.signatureCorrect() && ((reader.totalLength() + offset) <= buflen))
-        break;
-    }
+  // Verify that we can work with this zipfile (no disk spanning allowed)
+  if(myEcd.diskNumber != myEcd.cdStartDiskNumber ||
+     myEcd.cdDiskEntries != myEcd.cdTotalEntries)
+    throw runtime_error(errorMessage(ZipError::UNSUPPORTED));
 
-    // If we found it, fill out the data
-    if(offset >= 0)
-    {
-      // Extract ECD info
-      EcdReader const reader(buffer.get() + offset);
-      myEcd.diskNumber        = reader.thisDiskNo();
-      myEcd.cdStartDiskNumber = reader.dirStartDisk();
-      myEcd.cdDiskEntries     = reader.dirDiskEntries();
-      myEcd.cdTotalEntries    = reader.dirTotalEntries();
-      myEcd.cdSize            = reader.dirSize();
-      myEcd.cdStartDiskOffset = reader.dirOffset();
-      return;
-    }
+  // Make sure the central directory is actually present
+  if(myEcd.cdStartDiskOffset + myEcd.cdSize > myFile.size())
+    throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
 
-    // Didn't find it; expand our search
-    if(buflen < myLength)
-      buflen *= 2;
-    else
-      throw runtime_error(errorMessage(ZipError::BAD_SIGNATURE));
-  }
-  throw runtime_error(errorMessage(ZipError::OUT_OF_MEMORY));
+  readCentralDirectory();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ZipHandler::ZipFile::readStream(ByteBuffer& out, uInt64 offset,
-                                     uInt64 length, uInt64& actual)
+void ZipHandler::ZipFile::readEcd()
 {
-  try
-  {
-    myStream.seekg(offset);
-    myStream.read(reinterpret_cast<char*>(out.get()), length);
+  const uInt64 length = myFile.size();
 
-    actual = myStream.gcount();
-    return true;
-  }
-  catch(...)
+  // The ECD is at the very end, followed only by a comment of at most 64K
+  const uInt64 buflen = std::min<uInt64>(length, 65536 + EcdReader::minimumLength());
+  const uInt8* buffer = myFile.data() + length - buflen;
+
+  // Find the ECD signature
+  Int64 offset;
+  for(offset = Int64(buflen) - Int64(EcdReader::minimumLength()); offset >= 0; --offset)
   {
-    return false;
+    EcdReader reader(buffer + offset);
+    if(reader.signatureCorrect() && ((reader.totalLength() + offset) <= buflen))
+      break;
   }
+
+  if(offset < 0)
+    throw runtime_error(errorMessage(ZipError::BAD_SIGNATURE));
+
+  // Extract ECD info
+  EcdReader const reader(buffer + offset);
+  myEcd.diskNumber        = reader.thisDiskNo();
+  myEcd.cdStartDiskNumber = reader.dirStartDisk();
+  myEcd.cdDiskEntries     = reader.dirDiskEntries();
+  myEcd.cdTotalEntries    = reader.dirTotalEntries();
+  myEcd.cdSize            = reader.dirSize();
+  myEcd.cdStartDiskOffset = reader.dirOffset();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-const ZipHandler::ZipHeader* ZipHandler::ZipFile::nextFile()
+void ZipHandler::ZipFile::readCentralDirectory()
 {
+  const uInt8* cd = myFile.data() + myEcd.cdStartDiskOffset;
+  uInt64 cdPos = 0;
+
+  myHeaders.reserve(myEcd.cdTotalEntries);
+  myIndex.reserve(myEcd.cdTotalEntries);
+
   // Make sure we have enough data
   // If we're at or past the end, we're done
-  CentralDirEntryReader const reader(myCd.get() + myCdPos);
-  if(!reader.signatureCorrect() || ((myCdPos + reader.totalLength()) > myEcd.cdSize))
-    return nullptr;
-
-  // Extract file header info
-  myHeader.versionCreated     = reader.versionCreated();
-  myHeader.versionNeeded      = reader.versionNeeded();
-  myHeader.bitFlag            = reader.generalFlag();
-  myHeader.compression        = reader.compressionMethod();
-  myHeader.crc                = reader.crc32();
-  myHeader.compressedLength   = reader.compressedSize();
-  myHeader.uncompressedLength = reader.uncompressedSize();
-  myHeader.startDiskNumber    = reader.startDisk();
-  myHeader.localHeaderOffset  = reader.headerOffset();
-  myHeader.filename           = reader.filename();
-
-  // Advance the position
-  myCdPos += reader.totalLength();
-  return &myHeader;
+  while(cdPos + CentralDirEntryReader::minimumLength() <= myEcd.cdSize)
+  {
+    CentralDirEntryReader const reader(cd + cdPos);
+    if(!reader.signatureCorrect() || ((cdPos + reader.totalLength()) > myEcd.cdSize))
+      break;
+
+    // Advance the position
+    cdPos += reader.totalLength();
+
+    // Skip directories and other empty entries
+    if(reader.uncompressedSize() == 0)
+      continue;
+
+    // Extract file header info
+    ZipHeader header;
+    header.versionCreated     = reader.versionCreated();
+    header.versionNeeded      = reader.versionNeeded();
+    header.bitFlag            = reader.generalFlag();
+    header.compression        = reader.compressionMethod();
+    header.fileTime           = reader.modifiedTime();
+    header.fileDate           = reader.modifiedDate();
+    header.crc                = reader.crc32();
+    header.compressedLength   = reader.compressedSize();
+    header.uncompressedLength = reader.uncompressedSize();
+    header.startDiskNumber    = reader.startDisk();
+    header.localHeaderOffset  = reader.headerOffset();
+    header.filename           = reader.filename();
+
+    if(Bankswitch::isValidRomName(header.filename))
+      myRomfiles++;
+
+    // If a name is present more than once, the first one wins
+    myIndex.emplace(header.filename, myHeaders.size());
+    myHeaders.push_back(std::move(header));
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::ZipFile::decompress(ByteBuffer& out, uInt64 length)
+void ZipHandler::ZipFile::decompress(const ZipHeader& header, uInt8* out,
+                                     uInt64 length) const
 {
   // If we don't have enough buffer, error
-  if(length < myHeader.uncompressedLength)
+  if(length < header.uncompressedLength)
     throw runtime_error(errorMessage(ZipError::BUFFER_TOO_SMALL));
 
   // Make sure the info in the header aligns with what we know
-  if(myHeader.startDiskNumber != myEcd.diskNumber)
+  if(header.startDiskNumber != myEcd.diskNumber)
     throw runtime_error(errorMessage(ZipError::UNSUPPORTED));
 
-  try
-  {
-    // Get the compressed data offset
-    uInt64 offset = getCompressedDataOffset();
+  // Get the compressed data offset
+  uInt64 offset = getCompressedDataOffset(header);
 
-    // Handle compression types
-    switch(myHeader.compression)
-    {
-      case 0:
-        decompressDataType0(offset, out, length);
-        break;
+  // Handle compression types
+  switch(header.compression)
+  {
+    case 0:
+      decompressDataType0(header, offset, out, length);
+      break;
 
-      case 8:
-        decompressDataType8(offset, out, length);
-        break;
+    case 8:
+      decompressDataType8(header, offset, out, length);
+      break;
 
-      case 14:
-        // FIXME - LZMA format not yet supported
-        throw runtime_error(errorMessage(ZipError::LZMA_UNSUPPORTED));
+    case 14:
+      // FIXME - LZMA format not yet supported
+      throw runtime_error(errorMessage(ZipError::LZMA_UNSUPPORTED));
 
-      default:
-        throw runtime_error(errorMessage(ZipError::UNSUPPORTED));
-    }
-  }
-  catch(...)
-  {
-    throw;
+    default:
+      throw runtime_error(errorMessage(ZipError::UNSUPPORTED));
   }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt64 ZipHandler::ZipFile::getCompressedDataOffset()
+uInt64 ZipHandler::ZipFile::getCompressedDataOffset(const ZipHeader& header) const
 {
   // Don't support a number of features
-  GeneralFlagReader const flags(myHeader.bitFlag);
-  if(myHeader.startDiskNumber != myEcd.diskNumber ||
-     myHeader.versionNeeded > 63 || flags.patchData() ||
+  GeneralFlagReader const flags(header.bitFlag);
+  if(header.startDiskNumber != myEcd.diskNumber ||
+     header.versionNeeded > 63 || flags.patchData() ||
      flags.encrypted() || flags.strongEncryption())
     throw runtime_error(errorMessage(ZipError::UNSUPPORTED));
 
-  // Read the fixed-sized part of the local file header
-  uInt64 read_length = 0;
-  bool success = readStream(myBuffer, myHeader.localHeaderOffset, 0x1e, read_length);
-  if(!success)
-    throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-  else if(read_length != LocalFileHeaderReader::minimumLength())
+  // Check the fixed-sized part of the local file header
+  if(header.localHeaderOffset + LocalFileHeaderReader::minimumLength() > myFile.size())
     throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
 
   // Compute the final offset
-  LocalFileHeaderReader reader(&myBuffer[0]);
+  LocalFileHeaderReader reader(myFile.data() + header.localHeaderOffset);
   if(!reader.signatureCorrect())
     throw runtime_error(errorMessage(ZipError::BAD_SIGNATURE));
 
-  return myHeader.localHeaderOffset + reader.totalLength();
+  uInt64 offset = header.localHeaderOffset + reader.totalLength();
+  if(offset + header.compressedLength > myFile.size())
+    throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
+
+  return offset;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::ZipFile::decompressDataType0(
-    uInt64 offset, ByteBuffer& out, uInt64 length)
+void ZipHandler::ZipFile::decompressDataType0(const ZipHeader& header,
+    uInt64 offset, uInt8* out, uInt64 length) const
 {
-  // The data is uncompressed; just read it
-  uInt64 read_length = 0;
-  bool success = readStream(out, offset, myHeader.compressedLength, read_length);
-  if(!success)
-    throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-  else if(read_length != myHeader.compressedLength)
-    throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
+  // The data is uncompressed; just copy it
+  if(header.compressedLength > length)
+    throw runtime_error(errorMessage(ZipError::BUFFER_TOO_SMALL));
+
+  std::copy_n(myFile.data() + offset, header.compressedLength, out);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::ZipFile::decompressDataType8(
-    uInt64 offset, ByteBuffer& out, uInt64 length)
+void ZipHandler::ZipFile::decompressDataType8(const ZipHeader& header,
+    uInt64 offset, uInt8* out, uInt64 length) const
 {
-  uInt64 input_remaining = myHeader.compressedLength;
-
-  // Reset the stream
-	z_stream stream;
-	stream.zalloc = Z_NULL;
-	stream.zfree = Z_NULL;
-	stream.opaque = Z_NULL;
-	stream.avail_in = 0;
-	stream.next_out = reinterpret_cast<Bytef *>(out.get());
-	stream.avail_out = uInt32(length); // TODO - use zip64
+  // Reset the stream; all of the compressed data is available at once
+  z_stream stream;
+  stream.zalloc = Z_NULL;
+  stream.zfree = Z_NULL;
+  stream.opaque = Z_NULL;
+  stream.next_in = const_cast<Bytef*>(myFile.data() + offset);
+  stream.avail_in = uInt32(header.compressedLength); // TODO - use zip64
+  stream.next_out = reinterpret_cast<Bytef *>(out);
+  stream.avail_out = uInt32(length); // TODO - use zip64
+
+  // Add a dummy byte at end of compressed data, if the file has one
+  if(offset + header.compressedLength < myFile.size())
+    stream.avail_in++;
 
   // Initialize the decompressor
   int zerr = inflateInit2(&stream, -MAX_WBITS);
   if(zerr != Z_OK)
     throw runtime_error(errorMessage(ZipError::DECOMPRESS_ERROR));
 
-  // Loop until we're done
-  for(;;)
-  {
-    // Read in the next chunk of data
-    uInt64 read_length = 0;
-    bool success = readStream(myBuffer, offset,
-          std::min(input_remaining, uInt64(sizeof(myBuffer.get()))), read_length);
-    if(!success)
-    {
-      inflateEnd(&stream);
-      throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-    }
-    offset += read_length;
-
-    // If we read nothing, but still have data left, the file is truncated
-    if(read_length == 0 && input_remaining > 0)
-    {
-      inflateEnd(&stream);
-      throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
-    }
-
-    // Fill out the input data
-    stream.next_in = myBuffer.get();
-    stream.avail_in = uInt32(read_length); // TODO - use zip64
-    input_remaining -= read_length;
-
-    // Add a dummy byte at end of compressed data
-    if(input_remaining == 0)
-      stream.avail_in++;
-
-    // Now inflate
-    zerr = inflate(&stream, Z_NO_FLUSH);
-    if(zerr == Z_STREAM_END)
-      break;
-    else if(zerr != Z_OK)
-    {
-      inflateEnd(&stream);
-      throw runtime_error(errorMessage(ZipError::DECOMPRESS_ERROR));
-    }
-  }
+  // Now inflate
+  zerr = inflate(&stream, Z_FINISH);
 
   // Finish decompression
-  zerr = inflateEnd(&stream);
-  if(zerr != Z_OK)
-    throw runtime_error(errorMessage(ZipError::DECOMPRESS_ERROR));
+  const bool finished = inflateEnd(&stream) == Z_OK && zerr == Z_STREAM_END;
 
   // If anything looks funny, report an error
-  if(stream.avail_out > 0 || input_remaining > 0)
+  if(!finished || stream.avail_out > 0)
     throw runtime_error(errorMessage(ZipError::DECOMPRESS_ERROR));
 }
 
@@ -20,12 +20,21 @@
 #ifndef ZIP_HANDLER_HXX
 #define ZIP_HANDLER_HXX
 
+#include <mutex>
+#include <unordered_map>
+
 #include "bspf.hxx"
 
 /**
   This class implements a thin wrapper around the zip file management code
   from the MAME project.
 
+  The central directory of each ZIP file is parsed only once into an index,
+  which is cached (and invalidated when the file changes on disk), and the
+  file contents are accessed through a memory mapping.  The parsed archives
+  are immutable, so any number of handlers (one per thread) can look up and
+  decompress files from the same archive concurrently.
+
   @author  Original code by Aaron Giles, ZipHandler wrapper class and heavy
            modifications/refactoring by Stephen Anthony.
 */
@@ -43,6 +52,10 @@ class ZipHandler
     bool hasNext() const;  // Answer whether there are more files present
     const string& next();  // Get next file
 
+    // Select the given file for decompression, without iterating
+    // Answer whether the file is present in the ZIP file
+    bool select(const string& filename);
+
     // Decompress the currently selected file and return its length
     // An exception will be thrown on any errors
     uInt64 decompress(ByteBuffer& image);
@@ -94,56 +107,71 @@ class ZipHandler
       uInt64 cdStartDiskOffset{0}; // offset of start of central directory with respect to the starting disk number
     };
 
-    // Describes an open ZIP file
-    struct ZipFile
+    // A read-only memory mapping of a complete file
+    class MappedFile
     {
-      string  myFilename;     // copy of ZIP filename (for caching)
-      fstream myStream;       // C++ fstream file handle
-      uInt64  myLength{0};    // length of zip file
-      uInt16  myRomfiles{0};  // number of ROM files in central directory
+      public:
+        /** Map the file; an exception will be thrown on any errors */
+        explicit MappedFile(const string& filename);
+        ~MappedFile();
 
-      ZipEcd  myEcd;          // end of central directory
+        const uInt8* data() const { return myData; }
+        uInt64 size() const { return mySize; }
 
-      ByteBuffer myCd;        // central directory raw data
-      uInt64    myCdPos{0};   // position in central directory
-      ZipHeader myHeader;     // current file header
+      private:
+        const uInt8* myData{nullptr};
+        uInt64 mySize{0};
+      #if defined(BSPF_WINDOWS)
+        void* myFileHandle{nullptr};
+        void* myMappingHandle{nullptr};
+      #endif
 
-      ByteBuffer myBuffer;    // buffer for decompression
+      private:
+        // Following constructors and assignment operators not supported
+        MappedFile() = delete;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile(MappedFile&&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile& operator=(MappedFile&&) = delete;
+    };
 
-      /** Constructor */
-      explicit ZipFile(const string& filename);
+    // Describes a parsed ZIP file; this is never modified after construction
+    struct ZipFile
+    {
+      string     myFilename;      // copy of ZIP filename (for caching)
+      Int64      myModTime{0};    // modification time when the file was parsed
+      MappedFile myFile;          // contents of the file
+      uInt16     myRomfiles{0};   // number of ROM files in central directory
 
-      /** Open the file and set up the internal stream buffer*/
-      bool open();
+      ZipEcd     myEcd;           // end of central directory
 
-      /** Read the ZIP contents from the internal stream buffer */
-      void initialize();
+      vector<ZipHeader> myHeaders;  // all non-empty files, in directory order
+      std::unordered_map<string, size_t> myIndex;  // filename -> myHeaders
 
-      /** Close previously opened internal stream buffer */
-      void close();
+      /** Constructor; parses the central directory */
+      ZipFile(const string& filename, Int64 modTime);
 
       /** Read the ECD data */
       void readEcd();
 
-      /** Read data from stream */
-      bool readStream(ByteBuffer& out, uInt64 offset, uInt64 length, uInt64& actual);
-
-      /** Return the next entry in the ZIP file */
-      const ZipHeader* nextFile();
+      /** Parse the central directory into myHeaders and myIndex */
+      void readCentralDirectory();
 
-      /** Decompress the most recently found file in the ZIP into target buffer */
-      void decompress(ByteBuffer& out, uInt64 length);
+      /** Decompress the given file in the ZIP into target buffer */
+      void decompress(const ZipHeader& header, uInt8* out, uInt64 length) const;
 
       /** Return the offset of the compressed data */
-      uInt64 getCompressedDataOffset();
+      uInt64 getCompressedDataOffset(const ZipHeader& header) const;
 
       /** Decompress type 0 data (which is uncompressed) */
-      void decompressDataType0(uInt64 offset, ByteBuffer& out, uInt64 length);
+      void decompressDataType0(const ZipHeader& header, uInt64 offset,
+                               uInt8* out, uInt64 length) const;
 
       /** Decompress type 8 data (which is deflated) */
-      void decompressDataType8(uInt64 offset, ByteBuffer& out, uInt64 length);
+      void decompressDataType8(const ZipHeader& header, uInt64 offset,
+                               uInt8* out, uInt64 length) const;
     };
-    using ZipFilePtr = unique_ptr<ZipFile>;
+    using ZipFilePtr = shared_ptr<const ZipFile>;
 
     /** Classes to parse the ZIP metadata in an abstracted way */
     class ReaderBase
@@ -290,18 +318,22 @@ class ZipHandler
     /** Get message for given ZipError enumeration */
     static string errorMessage(ZipError err);
 
-    /** Search cache for given ZIP file */
-    ZipFilePtr findCached(const string& filename);
+    /** Get the modification time of the given file (0 if not available) */
+    static Int64 modificationTime(const string& filename);
 
-    /** Close a ZIP file and add it to the cache */
-    void addToCache();
+    /** Search cache for given ZIP file, parse and cache it if necessary */
+    static ZipFilePtr findCached(const string& filename);
 
   private:
-    static constexpr uInt32 DECOMPRESS_BUFSIZE = 16_KB;
-    static constexpr uInt32 CACHE_SIZE = 8; // number of open files to cache
+    static constexpr uInt32 CACHE_SIZE = 8; // number of parsed files to cache
 
     ZipFilePtr myZip;
-    std::array<ZipFilePtr, CACHE_SIZE> myZipCache;
+    size_t myPos{0};                    // iterator position in myZip->myHeaders
+    const ZipHeader* myHeader{nullptr}; // currently selected file
+
+    // Shared by all handlers; most recently used first
+    static std::array<ZipFilePtr, CACHE_SIZE> ourZipCache;
+    static std::mutex ourZipCacheMutex;
 
   private:
     // Following constructors and assignment operators not supported
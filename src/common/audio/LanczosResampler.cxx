@@ -18,6 +18,7 @@
 #include <cmath>
 
 #include "LanczosResampler.hxx"
+#include "PerfCounters.hxx"
 
 namespace {
 
@@ -71,6 +72,7 @@ LanczosResampler::LanczosResampler(
   // -> we find N from fully reducing the fraction.
   myPrecomputedKernelCount(reducedDenominator(formatFrom.sampleRate, formatTo.sampleRate)),
   myKernelSize(2 * kernelParameter),
+  myKernelTimeStep(formatTo.sampleRate / myPrecomputedKernelCount),
   myKernelParameter(kernelParameter),
   myHighPassL(HIGH_PASS_CUT_OFF, float(formatFrom.sampleRate)),
   myHighPassR(HIGH_PASS_CUT_OFF, float(formatFrom.sampleRate)),
@@ -93,9 +95,12 @@ LanczosResampler::LanczosResampler(
 void LanczosResampler::precomputeKernels()
 {
   // timeIndex = time * formatFrom.sampleRate * formatTo.sampleRAte
-  uInt32 timeIndex = 0;
-
+  //
+  // The kernels are stored in order of increasing time offset, so that the kernel for a given
+  // time can be looked up directly; this keeps working when the rate is adjusted slightly and
+  // the time no longer hits the offsets exactly (the kernel just below is used in that case).
   for (uInt32 i = 0; i < myPrecomputedKernelCount; ++i) {
+    const uInt32 timeIndex = i * myKernelTimeStep;
     float* kernel = myPrecomputedKernels.get() + myKernelSize * i;
     // The kernel is normalized such to be evaluate on time * formatFrom.sampleRate
     float center =
@@ -106,19 +111,6 @@ void LanczosResampler::precomputeKernels()
           center - static_cast<float>(j) + static_cast<float>(myKernelParameter) - 1.F, myKernelParameter
         ) * CLIPPING_FACTOR;
     }
-
-    // Next step: time += 1 / formatTo.sampleRate
-    //
-    // By construction, we limit the argument during kernel evaluation to 0 .. 1, which
-    // corresponds to 0 .. 1 / formatFrom.sampleRate for time. To implement this, we decompose
-    // time as follows:
-    //
-    // time = N / formatFrom.sampleRate + delta
-    // timeIndex = N * formatTo.sampleRate + delta * formatTo.sampleRate * formatFrom.sampleRate
-    //
-    // with N integral and delta < 0. From this, it follows that we replace
-    // time with delta, i.e. take the modulus of timeIndex.
-    timeIndex = (timeIndex + myFormatFrom.sampleRate) % myFormatTo.sampleRate;
   }
 }
 
@@ -143,8 +135,11 @@ void LanczosResampler::fillFragment(float* fragment, uInt32 length)
   const uInt32 outputSamples = myFormatTo.stereo ? (length >> 1) : length;
 
   for (uInt32 i = 0; i < outputSamples; ++i) {
-    float* kernel = myPrecomputedKernels.get() + (myCurrentKernelIndex * myKernelSize);
-    myCurrentKernelIndex = (myCurrentKernelIndex + 1) % myPrecomputedKernelCount;
+    // By construction, we limit the argument during kernel evaluation to 0 .. 1, which
+    // corresponds to 0 .. 1 / formatFrom.sampleRate for time. myTimeIndex is kept in
+    // this range below, so it directly selects the kernel to use.
+    float* kernel = myPrecomputedKernels.get() +
+      (myTimeIndex / TIME_SCALE / myKernelTimeStep) * myKernelSize;
 
     if (myFormatFrom.stereo) {
       float sampleL = myBufferL->convoluteWith(kernel);
@@ -165,12 +160,21 @@ void LanczosResampler::fillFragment(float* fragment, uInt32 length)
         fragment[i] = sample;
     }
 
-    myTimeIndex += myFormatFrom.sampleRate;
+    // Next step: time += 1 / formatTo.sampleRate
+    //
+    // We decompose time as follows:
+    //
+    // time = N / formatFrom.sampleRate + delta
+    // timeIndex = N * formatTo.sampleRate + delta * formatTo.sampleRate * formatFrom.sampleRate
+    //
+    // with N integral and delta < 1 / formatFrom.sampleRate. We shift in N samples and
+    // replace time with delta, i.e. take the modulus of timeIndex.
+    myTimeIndex += myTimeStep;
 
-    uInt32 samplesToShift = myTimeIndex / myFormatTo.sampleRate;
+    uInt32 samplesToShift = myTimeIndex / (myFormatTo.sampleRate * TIME_SCALE);
     if (samplesToShift == 0) continue;
 
-    myTimeIndex %= myFormatTo.sampleRate;
+    myTimeIndex %= myFormatTo.sampleRate * TIME_SCALE;
     shiftSamples(samplesToShift);
   }
 }
@@ -198,6 +202,7 @@ inline void LanczosResampler::shiftSamples(uInt32 samplesToShift)
       } else {
         myUnderrunLogger.log();
         myIsUnderrun = true;
+        PERF_COUNT(audioUnderruns, 1);
       }
     }
   }
@@ -45,7 +45,9 @@ class LanczosResampler : public Resampler
 
     uInt32 myPrecomputedKernelCount{0};
     uInt32 myKernelSize{0};
-    uInt32 myCurrentKernelIndex{0};
+    // The time (in units of 1 / (formatFrom.sampleRate * formatTo.sampleRate))
+    // between the offsets of two adjacent precomputed kernels
+    uInt32 myKernelTimeStep{0};
     unique_ptr<float[]> myPrecomputedKernels;
 
     uInt32 myKernelParameter{0};
@@ -19,6 +19,7 @@
 #define RESAMPLER_HXX
 
 #include <functional>
+#include <cmath>
 
 #include "bspf.hxx"
 #include "StaggeredLogger.hxx"
@@ -55,11 +56,24 @@ class Resampler {
       myFormatFrom(formatFrom),
       myFormatTo(formatTo),
       myNextFragmentCallback(nextFragmentCallback),
-      myUnderrunLogger("audio buffer underrun", Logger::Level::INFO)
+      myUnderrunLogger("audio buffer underrun", Logger::Level::INFO),
+      myTimeStep(formatFrom.sampleRate * TIME_SCALE)
     {}
 
     virtual void fillFragment(float* fragment, uInt32 length) = 0;
 
+    /**
+      Dynamic rate control: consume input samples faster (factor > 1) or
+      slower (factor < 1) than the nominal ratio of the two sample rates.
+      The factor is meant to stay very close to 1, so that the change in
+      pitch is inaudible.
+
+      @param factor  The adjustment applied to the input sample rate
+    */
+    void setRateAdjustment(double factor) {
+      myTimeStep = uInt32(std::round(myFormatFrom.sampleRate * TIME_SCALE * factor));
+    }
+
     virtual ~Resampler() = default;
 
   protected:
@@ -71,6 +85,15 @@ class Resampler {
 
     StaggeredLogger myUnderrunLogger;
 
+    // The resamplers keep track of time in units of
+    // 1 / (formatFrom.sampleRate * formatTo.sampleRate * TIME_SCALE) seconds;
+    // the extra resolution allows for fine grained rate adjustments
+    static constexpr uInt32 TIME_SCALE = 1 << 12;
+
+    // The time that passes with each output sample (nominally
+    // formatFrom.sampleRate * TIME_SCALE)
+    uInt32 myTimeStep{0};
+
   private:
 
     Resampler() = delete;
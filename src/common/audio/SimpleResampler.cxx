@@ -16,6 +16,7 @@
 //============================================================================
 
 #include "SimpleResampler.hxx"
+#include "PerfCounters.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 SimpleResampler::SimpleResampler(
@@ -46,7 +47,8 @@ void SimpleResampler::fillFragment(float* fragment, uInt32 length)
 
   const uInt32 outputSamples = myFormatTo.stereo ? (length >> 1) : length;
 
-  // For the following math, remember that myTimeIndex = time * myFormatFrom.sampleRate * myFormatTo.sampleRate
+  // For the following math, remember that
+  // myTimeIndex = time * myFormatFrom.sampleRate * myFormatTo.sampleRate * TIME_SCALE
   for (uInt32 i = 0; i < outputSamples; ++i) {
     if (myFormatFrom.stereo) {
       float sampleL = static_cast<float>(myCurrentFragment[2*myFragmentIndex]) / static_cast<float>(0x7fff);
@@ -68,13 +70,13 @@ void SimpleResampler::fillFragment(float* fragment, uInt32 length)
     }
 
     // time += 1 / myFormatTo.sampleRate
-    myTimeIndex += myFormatFrom.sampleRate;
+    myTimeIndex += myTimeStep;
 
     // time >= 1 / myFormatFrom.sampleRate
-    if (myTimeIndex >= myFormatTo.sampleRate) {
+    if (myTimeIndex >= myFormatTo.sampleRate * TIME_SCALE) {
       // myFragmentIndex += time * myFormatFrom.sampleRate
-      myFragmentIndex += myTimeIndex / myFormatTo.sampleRate;
-      myTimeIndex %= myFormatTo.sampleRate;
+      myFragmentIndex += myTimeIndex / (myFormatTo.sampleRate * TIME_SCALE);
+      myTimeIndex %= myFormatTo.sampleRate * TIME_SCALE;
     }
 
     if (myFragmentIndex >= myFormatFrom.fragmentSize) {
@@ -86,6 +88,7 @@ void SimpleResampler::fillFragment(float* fragment, uInt32 length)
       else {
         myUnderrunLogger.log();
         myIsUnderrun = true;
+        PERF_COUNT(audioUnderruns, 1);
       }
     }
   }
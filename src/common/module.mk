@@ -2,9 +2,6 @@ MODULE := src/common
 
 MODULE_OBJS := \
 	src/common/Base.o \
-	src/common/EventHandlerSDL2.o \
-	src/common/FBSurfaceSDL2.o \
-	src/common/FrameBufferSDL2.o \
 	src/common/FSNodeZIP.o \
 	src/common/JoyMap.o \
 	src/common/KeyMap.o \
@@ -17,19 +14,29 @@ MODULE_OBJS := \
 	src/common/PKeyboardHandler.o \
 	src/common/PNGLibrary.o \
 	src/common/RewindManager.o \
-	src/common/SoundSDL2.o \
+	src/common/StateArchive.o \
 	src/common/StateManager.o \
 	src/common/TimerManager.o \
 	src/common/ZipHandler.o \
 	src/common/AudioQueue.o \
 	src/common/AudioSettings.o \
 	src/common/FpsMeter.o \
+	src/common/PerfCounters.o \
 	src/common/ThreadDebugging.o \
+	src/common/ThreadPool.o \
 	src/common/StaggeredLogger.o \
-	src/common/repository/KeyValueRepositoryConfigfile.o \
+	src/common/repository/KeyValueRepositoryConfigfile.o
+
+ifndef HEADLESS
+MODULE_OBJS += \
+	src/common/EventHandlerSDL2.o \
+	src/common/FBSurfaceSDL2.o \
+	src/common/FrameBufferSDL2.o \
+	src/common/SoundSDL2.o \
 	src/common/sdl_blitter/BilinearBlitter.o \
 	src/common/sdl_blitter/QisBlitter.o \
-	src/common/sdl_blitter/BlitterFactory.o \
+	src/common/sdl_blitter/BlitterFactory.o
+endif
 
 MODULE_DIRS += \
 	src/common
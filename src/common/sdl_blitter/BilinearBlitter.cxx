@@ -57,6 +57,9 @@ void BilinearBlitter::reinitialize(
    myDstRect.y = myFB.scaleY(destRect.y);
    myDstRect.w = myFB.scaleX(destRect.w);
    myDstRect.h = myFB.scaleY(destRect.h);
+
+   myTextureDirtyLines.add(0, mySrcRect.h, mySrcRect.h);
+   mySecondaryTextureDirtyLines.add(0, mySrcRect.h, mySrcRect.h);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -79,7 +82,7 @@ void BilinearBlitter::free()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void BilinearBlitter::blit(SDL_Surface& surface)
+void BilinearBlitter::blit(SDL_Surface& surface, uInt32 dirtyFirstLine, uInt32 dirtyLineCount)
 {
   ASSERT_MAIN_THREAD;
 
@@ -88,9 +91,28 @@ void BilinearBlitter::blit(SDL_Surface& surface)
   SDL_Texture* texture = myTexture;
 
   if(myStaticData == nullptr) {
-    SDL_UpdateTexture(myTexture, &mySrcRect, surface.pixels, surface.pitch);
-    myTexture = mySecondaryTexture;
-    mySecondaryTexture = texture;
+    myTextureDirtyLines.add(dirtyFirstLine, dirtyLineCount, mySrcRect.h);
+    mySecondaryTextureDirtyLines.add(dirtyFirstLine, dirtyLineCount, mySrcRect.h);
+
+    // The secondary texture holds the last upload; if nothing changed since
+    // then, we can just show it again
+    if(mySecondaryTextureDirtyLines.empty())
+      texture = mySecondaryTexture;
+    else {
+      // Upload only the lines that changed since this texture was last used
+      SDL_Rect dirtyRect = mySrcRect;
+      dirtyRect.y += myTextureDirtyLines.top;
+      dirtyRect.h = myTextureDirtyLines.bottom - myTextureDirtyLines.top;
+
+      SDL_UpdateTexture(myTexture, &dirtyRect,
+        static_cast<uInt8*>(surface.pixels) + myTextureDirtyLines.top * surface.pitch,
+        surface.pitch);
+      myTextureDirtyLines.clear();
+
+      myTexture = mySecondaryTexture;
+      mySecondaryTexture = texture;
+      std::swap(myTextureDirtyLines, mySecondaryTextureDirtyLines);
+    }
   }
 
   SDL_RenderCopy(myFB.renderer(), texture, &mySrcRect, &myDstRect);
@@ -137,6 +159,9 @@ void BilinearBlitter::recreateTexturesIfNecessary()
     }
   }
 
+  myTextureDirtyLines.add(0, mySrcRect.h, mySrcRect.h);
+  mySecondaryTextureDirtyLines.add(0, mySrcRect.h, mySrcRect.h);
+
   myRecreateTextures = false;
   myTexturesAreAllocated = true;
 }
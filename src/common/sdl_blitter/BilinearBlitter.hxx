@@ -37,13 +37,14 @@ class BilinearBlitter : public Blitter {
       SDL_Surface* staticData = nullptr
     ) override;
 
-    virtual void blit(SDL_Surface& surface) override;
+    virtual void blit(SDL_Surface& surface, uInt32 dirtyFirstLine, uInt32 dirtyLineCount) override;
 
   private:
     FrameBufferSDL2& myFB;
 
     SDL_Texture* myTexture{nullptr};
     SDL_Texture* mySecondaryTexture{nullptr};
+    DirtyLines myTextureDirtyLines, mySecondaryTextureDirtyLines;
     SDL_Rect mySrcRect{0, 0, 0, 0}, myDstRect{0, 0, 0, 0};
     FBSurface::Attributes myAttributes;
 
@@ -35,10 +35,41 @@ class Blitter {
       SDL_Surface* staticData = nullptr
     ) = 0;
 
-    virtual void blit(SDL_Surface& surface) = 0;
+    /**
+      Blit the source rectangle of the surface. Only lines
+      [dirtyFirstLine, dirtyFirstLine + dirtyLineCount) of the source
+      rectangle have been modified since the last blit.
+     */
+    virtual void blit(SDL_Surface& surface, uInt32 dirtyFirstLine, uInt32 dirtyLineCount) = 0;
 
   protected:
 
+    /**
+      The range of source lines that has been modified since a texture was
+      last updated.
+     */
+    struct DirtyLines {
+      uInt32 top{0}, bottom{0};
+
+      bool empty() const { return top >= bottom; }
+
+      void add(uInt32 first, uInt32 count, uInt32 height) {
+        const uInt32 last = count > height - std::min(first, height) ?
+          height : first + count;
+        if (first >= last) return;
+
+        if (empty()) {
+          top = first;
+          bottom = last;
+        } else {
+          top = std::min(top, first);
+          bottom = std::max(bottom, last);
+        }
+      }
+
+      void clear() { top = bottom = 0; }
+    };
+
     Blitter() = default;
 
   private:
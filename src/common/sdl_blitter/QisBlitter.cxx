@@ -64,6 +64,9 @@ void QisBlitter::reinitialize(
    myDstRect.y = myFB.scaleY(destRect.y);
    myDstRect.w = myFB.scaleX(destRect.w);
    myDstRect.h = myFB.scaleY(destRect.h);
+
+   mySrcTextureDirtyLines.add(0, mySrcRect.h, mySrcRect.h);
+   mySecondarySrcTextureDirtyLines.add(0, mySrcRect.h, mySrcRect.h);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -88,7 +91,7 @@ void QisBlitter::free()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void QisBlitter::blit(SDL_Surface& surface)
+void QisBlitter::blit(SDL_Surface& surface, uInt32 dirtyFirstLine, uInt32 dirtyLineCount)
 {
   ASSERT_MAIN_THREAD;
 
@@ -97,16 +100,34 @@ void QisBlitter::blit(SDL_Surface& surface)
   SDL_Texture* intermediateTexture = myIntermediateTexture;
 
   if(myStaticData == nullptr) {
-    SDL_UpdateTexture(mySrcTexture, &mySrcRect, surface.pixels, surface.pitch);
-
-    blitToIntermediate();
-
-    myIntermediateTexture = mySecondaryIntermedateTexture;
-    mySecondaryIntermedateTexture = intermediateTexture;
-
-    SDL_Texture* temporary = mySrcTexture;
-    mySrcTexture = mySecondarySrcTexture;
-    mySecondarySrcTexture = temporary;
+    mySrcTextureDirtyLines.add(dirtyFirstLine, dirtyLineCount, mySrcRect.h);
+    mySecondarySrcTextureDirtyLines.add(dirtyFirstLine, dirtyLineCount, mySrcRect.h);
+
+    // The secondary textures hold the last upload; if nothing changed since
+    // then, we can just show them again
+    if(mySecondarySrcTextureDirtyLines.empty())
+      intermediateTexture = mySecondaryIntermedateTexture;
+    else {
+      // Upload only the lines that changed since this texture was last used
+      SDL_Rect dirtyRect = mySrcRect;
+      dirtyRect.y += mySrcTextureDirtyLines.top;
+      dirtyRect.h = mySrcTextureDirtyLines.bottom - mySrcTextureDirtyLines.top;
+
+      SDL_UpdateTexture(mySrcTexture, &dirtyRect,
+        static_cast<uInt8*>(surface.pixels) + mySrcTextureDirtyLines.top * surface.pitch,
+        surface.pitch);
+      mySrcTextureDirtyLines.clear();
+
+      blitToIntermediate();
+
+      myIntermediateTexture = mySecondaryIntermedateTexture;
+      mySecondaryIntermedateTexture = intermediateTexture;
+
+      SDL_Texture* temporary = mySrcTexture;
+      mySrcTexture = mySecondarySrcTexture;
+      mySecondarySrcTexture = temporary;
+      std::swap(mySrcTextureDirtyLines, mySecondarySrcTextureDirtyLines);
+    }
   }
 
   SDL_RenderCopy(myFB.renderer(), intermediateTexture, &myIntermediateRect, &myDstRect);
@@ -193,6 +214,9 @@ void QisBlitter::recreateTexturesIfNecessary()
     }
   }
 
+  mySrcTextureDirtyLines.add(0, mySrcRect.h, mySrcRect.h);
+  mySecondarySrcTextureDirtyLines.add(0, mySrcRect.h, mySrcRect.h);
+
   myRecreateTextures = false;
   myTexturesAreAllocated = true;
 }
@@ -39,7 +39,7 @@ class QisBlitter : public Blitter {
       SDL_Surface* staticData = nullptr
     ) override;
 
-    virtual void blit(SDL_Surface& surface) override;
+    virtual void blit(SDL_Surface& surface, uInt32 dirtyFirstLine, uInt32 dirtyLineCount) override;
 
   private:
 
@@ -49,6 +49,7 @@ class QisBlitter : public Blitter {
     SDL_Texture* mySecondarySrcTexture{nullptr};
     SDL_Texture* myIntermediateTexture{nullptr};
     SDL_Texture* mySecondaryIntermedateTexture{nullptr};
+    DirtyLines mySrcTextureDirtyLines, mySecondarySrcTextureDirtyLines;
 
     SDL_Rect mySrcRect{0, 0, 0, 0}, myIntermediateRect{0, 0, 0, 0}, myDstRect{0, 0, 0, 0};
     FBSurface::Attributes myAttributes;
@@ -31,6 +31,173 @@
   #endif
 #endif
 
+// SIMD implementations of the inner loop (SSE2 and NEON are part of the
+// x86-64 and ARMv8 baselines, AVX2 is detected at runtime)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define ATARI_NTSC_SSE2
+  #include <emmintrin.h>
+  #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define ATARI_NTSC_AVX2
+    #include <immintrin.h>
+  #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+  #define ATARI_NTSC_NEON
+  #include <arm_neon.h>
+#endif
+
+namespace {
+  /*
+    Each chunk turns two input pixels into seven output pixels.  Output
+    pixel n is the sum of four kernel entries, which are contiguous for
+    n = 0..3 and n = 4..6:
+
+      out[0..3] = k0[0..3] + k1[17..20] + kx0[ 7..10] + kx1[24..27]
+      out[4..6] = k0[4..6] + k1[14..16] + kx0[11..13] + kx1[21..23]
+
+    where k1 and kx1 are advanced in between (see ATARI_NTSC_COLOR_IN).
+    The SIMD versions compute out[4..7]; out[7] is overwritten by the next
+    chunk, or by the final pixels of the row.  Clamping and packing are
+    the same integer operations as in ATARI_NTSC_RGB_OUT_8888.
+  */
+  constexpr uInt32 ENTRY_SIZE = 28;
+
+#ifdef ATARI_NTSC_SSE2
+  inline __m128i clampAndPackSSE2(__m128i raw, __m128i clampMask, __m128i clampAdd)
+  {
+    const __m128i sub = _mm_and_si128(_mm_srli_epi32(raw, 9), clampMask);
+    __m128i clamp = _mm_sub_epi32(clampAdd, sub);
+    raw = _mm_or_si128(raw, clamp);
+    clamp = _mm_sub_epi32(clamp, sub);
+    raw = _mm_and_si128(raw, clamp);
+
+    return _mm_or_si128(_mm_or_si128(
+      _mm_and_si128(_mm_srli_epi32(raw, 5), _mm_set1_epi32(0x00FF0000)),
+      _mm_and_si128(_mm_srli_epi32(raw, 3), _mm_set1_epi32(0x0000FF00))),
+      _mm_and_si128(_mm_srli_epi32(raw, 1), _mm_set1_epi32(0x000000FF)));
+  }
+
+  inline __m128i load4(const uInt32* p)
+  {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  }
+
+  void renderChunksSSE2(const uInt32* table, const uInt8* line_in,
+      uInt32* line_out, uInt32 chunks, uInt32 clamp_mask, uInt32 clamp_add,
+      const uInt32*& kernel0, const uInt32*& kernel1, const uInt32*& kernelx1)
+  {
+    const __m128i clampMask = _mm_set1_epi32(Int32(clamp_mask)),
+                  clampAdd  = _mm_set1_epi32(Int32(clamp_add));
+    const uInt32 *k0 = kernel0, *k1 = kernel1, *kx0 = nullptr, *kx1 = kernelx1;
+
+    for(; chunks; --chunks)
+    {
+      kx0 = k0;  k0 = table + line_in[0] * ENTRY_SIZE;
+      __m128i raw = _mm_add_epi32(_mm_add_epi32(load4(k0), load4(k1 + 17)),
+                                  _mm_add_epi32(load4(kx0 + 7), load4(kx1 + 24)));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(line_out),
+                       clampAndPackSSE2(raw, clampMask, clampAdd));
+
+      kx1 = k1;  k1 = table + line_in[1] * ENTRY_SIZE;
+      raw = _mm_add_epi32(_mm_add_epi32(load4(k0 + 4), load4(k1 + 14)),
+                          _mm_add_epi32(load4(kx0 + 11), load4(kx1 + 21)));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(line_out + 4),
+                       clampAndPackSSE2(raw, clampMask, clampAdd));
+
+      line_in += 2;
+      line_out += 7;
+    }
+    kernel0 = k0;  kernel1 = k1;  kernelx1 = kx1;
+  }
+#endif
+
+#ifdef ATARI_NTSC_AVX2
+  __attribute__((target("avx2")))
+  void renderChunksAVX2(const uInt32* table, const uInt8* line_in,
+      uInt32* line_out, uInt32 chunks, uInt32 clamp_mask, uInt32 clamp_add,
+      const uInt32*& kernel0, const uInt32*& kernel1, const uInt32*& kernelx1)
+  {
+    const __m256i clampMask = _mm256_set1_epi32(Int32(clamp_mask)),
+                  clampAdd  = _mm256_set1_epi32(Int32(clamp_add));
+    const uInt32 *k0 = kernel0, *k1 = kernel1, *kx0 = nullptr, *kx1 = kernelx1;
+
+    // Both halves of a chunk in one register: the k0 and kx0 entries are
+    // contiguous over out[0..7], the k1 and kx1 entries are not
+    for(; chunks; --chunks)
+    {
+      kx0 = k0;  k0 = table + line_in[0] * ENTRY_SIZE;
+      const uInt32* k1_hi = table + line_in[1] * ENTRY_SIZE;
+
+      const __m256i t0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(k0));
+      const __m256i t2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kx0 + 7));
+      const __m256i t1 = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(load4(k1 + 17)), load4(k1_hi + 14), 1);
+      const __m256i t3 = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(load4(kx1 + 24)), load4(k1 + 21), 1);
+      __m256i raw = _mm256_add_epi32(_mm256_add_epi32(t0, t1), _mm256_add_epi32(t2, t3));
+
+      const __m256i sub = _mm256_and_si256(_mm256_srli_epi32(raw, 9), clampMask);
+      __m256i clamp = _mm256_sub_epi32(clampAdd, sub);
+      raw = _mm256_or_si256(raw, clamp);
+      clamp = _mm256_sub_epi32(clamp, sub);
+      raw = _mm256_and_si256(raw, clamp);
+
+      raw = _mm256_or_si256(_mm256_or_si256(
+        _mm256_and_si256(_mm256_srli_epi32(raw, 5), _mm256_set1_epi32(0x00FF0000)),
+        _mm256_and_si256(_mm256_srli_epi32(raw, 3), _mm256_set1_epi32(0x0000FF00))),
+        _mm256_and_si256(_mm256_srli_epi32(raw, 1), _mm256_set1_epi32(0x000000FF)));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(line_out), raw);
+
+      kx1 = k1;  k1 = k1_hi;
+      line_in += 2;
+      line_out += 7;
+    }
+    kernel0 = k0;  kernel1 = k1;  kernelx1 = kx1;
+  }
+#endif
+
+#ifdef ATARI_NTSC_NEON
+  inline uint32x4_t clampAndPackNEON(uint32x4_t raw, uint32x4_t clampMask, uint32x4_t clampAdd)
+  {
+    const uint32x4_t sub = vandq_u32(vshrq_n_u32(raw, 9), clampMask);
+    uint32x4_t clamp = vsubq_u32(clampAdd, sub);
+    raw = vorrq_u32(raw, clamp);
+    clamp = vsubq_u32(clamp, sub);
+    raw = vandq_u32(raw, clamp);
+
+    return vorrq_u32(vorrq_u32(
+      vandq_u32(vshrq_n_u32(raw, 5), vdupq_n_u32(0x00FF0000)),
+      vandq_u32(vshrq_n_u32(raw, 3), vdupq_n_u32(0x0000FF00))),
+      vandq_u32(vshrq_n_u32(raw, 1), vdupq_n_u32(0x000000FF)));
+  }
+
+  void renderChunksNEON(const uInt32* table, const uInt8* line_in,
+      uInt32* line_out, uInt32 chunks, uInt32 clamp_mask, uInt32 clamp_add,
+      const uInt32*& kernel0, const uInt32*& kernel1, const uInt32*& kernelx1)
+  {
+    const uint32x4_t clampMask = vdupq_n_u32(clamp_mask),
+                     clampAdd  = vdupq_n_u32(clamp_add);
+    const uInt32 *k0 = kernel0, *k1 = kernel1, *kx0 = nullptr, *kx1 = kernelx1;
+
+    for(; chunks; --chunks)
+    {
+      kx0 = k0;  k0 = table + line_in[0] * ENTRY_SIZE;
+      uint32x4_t raw = vaddq_u32(vaddq_u32(vld1q_u32(k0), vld1q_u32(k1 + 17)),
+                                 vaddq_u32(vld1q_u32(kx0 + 7), vld1q_u32(kx1 + 24)));
+      vst1q_u32(line_out, clampAndPackNEON(raw, clampMask, clampAdd));
+
+      kx1 = k1;  k1 = table + line_in[1] * ENTRY_SIZE;
+      raw = vaddq_u32(vaddq_u32(vld1q_u32(k0 + 4), vld1q_u32(k1 + 14)),
+                      vaddq_u32(vld1q_u32(kx0 + 11), vld1q_u32(kx1 + 21)));
+      vst1q_u32(line_out + 4, clampAndPackNEON(raw, clampMask, clampAdd));
+
+      line_in += 2;
+      line_out += 7;
+    }
+    kernel0 = k0;  kernel1 = k1;  kernelx1 = kx1;
+  }
+#endif
+}  // namespace
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AtariNTSC::initialize(const Setup& setup)
 {
@@ -99,6 +266,43 @@ void AtariNTSC::enableThreading(bool enable)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool AtariNTSC::isSupported(Kernel kernel)
+{
+  switch(kernel)
+  {
+    case Kernel::SCALAR:
+      return true;
+  #ifdef ATARI_NTSC_SSE2
+    case Kernel::SSE2:
+      return true;
+  #endif
+  #ifdef ATARI_NTSC_AVX2
+    case Kernel::AVX2:
+      return __builtin_cpu_supports("avx2");
+  #endif
+  #ifdef ATARI_NTSC_NEON
+    case Kernel::NEON:
+      return true;
+  #endif
+    default:
+      return false;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AtariNTSC::Kernel AtariNTSC::bestKernel()
+{
+  static const Kernel best = [] {
+    for(auto kernel: { Kernel::AVX2, Kernel::SSE2, Kernel::NEON })
+      if(isSupported(kernel))
+        return kernel;
+    return Kernel::SCALAR;
+  }();
+
+  return best;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AtariNTSC::render(const uInt8* atari_in, const uInt32 in_width, const uInt32 in_height,
   void* rgb_out, const uInt32 out_pitch, uInt32* rgb_in)
@@ -125,6 +329,54 @@ void AtariNTSC::render(const uInt8* atari_in, const uInt32 in_width, const uInt3
     memcpy(rgb_out, rgb_in, in_height * out_pitch);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::renderChunks(const uInt8* line_in, uInt32* line_out, uInt32 chunks,
+  uInt32 const*& kernel0, uInt32 const*& kernel1, uInt32 const*& kernelx1) const
+{
+  switch(myKernel)
+  {
+  #ifdef ATARI_NTSC_SSE2
+    case Kernel::SSE2:
+      renderChunksSSE2(myColorTable[0].data(), line_in, line_out, chunks,
+        atari_ntsc_clamp_mask, atari_ntsc_clamp_add, kernel0, kernel1, kernelx1);
+      return;
+  #endif
+  #ifdef ATARI_NTSC_AVX2
+    case Kernel::AVX2:
+      renderChunksAVX2(myColorTable[0].data(), line_in, line_out, chunks,
+        atari_ntsc_clamp_mask, atari_ntsc_clamp_add, kernel0, kernel1, kernelx1);
+      return;
+  #endif
+  #ifdef ATARI_NTSC_NEON
+    case Kernel::NEON:
+      renderChunksNEON(myColorTable[0].data(), line_in, line_out, chunks,
+        atari_ntsc_clamp_mask, atari_ntsc_clamp_add, kernel0, kernel1, kernelx1);
+      return;
+  #endif
+    default:
+      break;
+  }
+
+  uInt32 const* kernelx0;
+  for(uInt32 n = chunks; n; --n)
+  {
+    // order of input and output pixels must not be altered
+    ATARI_NTSC_COLOR_IN(0, line_in[0])
+    ATARI_NTSC_RGB_OUT_8888(0, line_out[0])
+    ATARI_NTSC_RGB_OUT_8888(1, line_out[1])
+    ATARI_NTSC_RGB_OUT_8888(2, line_out[2])
+    ATARI_NTSC_RGB_OUT_8888(3, line_out[3])
+
+    ATARI_NTSC_COLOR_IN(1, line_in[1])
+    ATARI_NTSC_RGB_OUT_8888(4, line_out[4])
+    ATARI_NTSC_RGB_OUT_8888(5, line_out[5])
+    ATARI_NTSC_RGB_OUT_8888(6, line_out[6])
+
+    line_in += 2;
+    line_out += 7;
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AtariNTSC::renderThread(const uInt8* atari_in, const uInt32 in_width,
   const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum,
@@ -149,23 +401,9 @@ void AtariNTSC::renderThread(const uInt8* atari_in, const uInt32 in_width,
     line_out[0] = line_out[1] = 0;
     line_out += 2;
 
-    for(uInt32 n = chunk_count; n; --n)
-    {
-      // order of input and output pixels must not be altered
-      ATARI_NTSC_COLOR_IN(0, line_in[0])
-      ATARI_NTSC_RGB_OUT_8888(0, line_out[0])
-      ATARI_NTSC_RGB_OUT_8888(1, line_out[1])
-      ATARI_NTSC_RGB_OUT_8888(2, line_out[2])
-      ATARI_NTSC_RGB_OUT_8888(3, line_out[3])
-
-      ATARI_NTSC_COLOR_IN(1, line_in[1])
-      ATARI_NTSC_RGB_OUT_8888(4, line_out[4])
-      ATARI_NTSC_RGB_OUT_8888(5, line_out[5])
-      ATARI_NTSC_RGB_OUT_8888(6, line_out[6])
-
-      line_in += 2;
-      line_out += 7;
-    }
+    renderChunks(line_in, line_out, chunk_count, kernel0, kernel1, kernelx1);
+    line_in += chunk_count * PIXEL_in_chunk;
+    line_out += chunk_count * PIXEL_out_chunk;
 
     // finish final pixels
     ATARI_NTSC_COLOR_IN(0, line_in[0])
@@ -225,23 +463,9 @@ void AtariNTSC::renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_
     line_out[0] = line_out[1] = 0;
     line_out += 2;
 
-    for(uInt32 n = chunk_count; n; --n)
-    {
-      // order of input and output pixels must not be altered
-      ATARI_NTSC_COLOR_IN(0, line_in[0])
-      ATARI_NTSC_RGB_OUT_8888(0, line_out[0])
-      ATARI_NTSC_RGB_OUT_8888(1, line_out[1])
-      ATARI_NTSC_RGB_OUT_8888(2, line_out[2])
-      ATARI_NTSC_RGB_OUT_8888(3, line_out[3])
-
-      ATARI_NTSC_COLOR_IN(1, line_in[1])
-      ATARI_NTSC_RGB_OUT_8888(4, line_out[4])
-      ATARI_NTSC_RGB_OUT_8888(5, line_out[5])
-      ATARI_NTSC_RGB_OUT_8888(6, line_out[6])
-
-      line_in += 2;
-      line_out += 7;
-    }
+    renderChunks(line_in, line_out, chunk_count, kernel0, kernel1, kernelx1);
+    line_in += chunk_count * PIXEL_in_chunk;
+    line_out += chunk_count * PIXEL_out_chunk;
 
     // finish final pixels
     ATARI_NTSC_COLOR_IN(0, line_in[0])
@@ -87,6 +87,18 @@ class AtariNTSC
     // Set up threading
     void enableThreading(bool enable);
 
+    // Implementations of the inner rendering loop; all of them produce
+    // identical output.  By default, the fastest one the CPU supports is used.
+    enum class Kernel { SCALAR, SSE2, AVX2, NEON };
+
+    // Whether the given implementation is compiled in and supported by the CPU
+    static bool isSupported(Kernel kernel);
+    // The fastest supported implementation
+    static Kernel bestKernel();
+
+    void setKernel(Kernel kernel) { myKernel = isSupported(kernel) ? kernel : bestKernel(); }
+    Kernel kernel() const { return myKernel; }
+
     // Filters one or more rows of pixels. Input pixels are 8-bit Atari
     // palette colors.
     //  In_row_width is the number of pixels to get to the next input row.
@@ -111,6 +123,11 @@ class AtariNTSC
     void renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_width,
       const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum, uInt32* rgb_in, void* rgb_out, const uInt32 out_pitch);
 
+    // Render the full chunks of a row; the kernel pointers are updated
+    // exactly as the unrolled scalar code does
+    void renderChunks(const uInt8* line_in, uInt32* line_out, uInt32 chunks,
+      uInt32 const*& kernel0, uInt32 const*& kernel1, uInt32 const*& kernelx1) const;
+
   private:
     static constexpr Int32
       PIXEL_in_chunk  = 2,   // number of input pixels read per chunk
@@ -154,6 +171,9 @@ class AtariNTSC
     std::array<uInt8, palette_size*3> myRGBPalette;
     BSPF::array2D<uInt32, palette_size, entry_size> myColorTable;
 
+    // Implementation of the inner rendering loop
+    Kernel myKernel{bestKernel()};
+
     // Rendering threads
     unique_ptr<std::thread[]> myThreads;  // NOLINT
     // Number of rendering and total threads
@@ -81,6 +81,8 @@ CartDebug::CartDebug(Debugger& dbg, Console& console, const OSystem& osystem)
 
   info.size = 128;  // ZP RAM
   myBankInfo.push_back(info);
+  myDisassemblyCache.resize(myBankInfo.size());
+  mySaveDisassemblyCache.resize(myBankInfo.size());
 
   // We know the address for the startup bank right now
   myBankInfo[myConsole.cartridge().startBank()].addressList.push_front(
@@ -269,7 +271,7 @@ bool CartDebug::disassemble(bool force)
 
     // Always attempt to resolve code sections unless it's been
     // specifically disabled
-    bool found = fillDisassemblyList(info, PC);
+    bool found = fillDisassemblyList(info, PC, force);
     if(!found && DiStella::settings.resolveCode)
     {
       // Temporarily turn off code resolution
@@ -283,16 +285,16 @@ bool CartDebug::disassemble(bool force)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDebug::fillDisassemblyList(BankInfo& info, uInt16 search)
+bool CartDebug::fillDisassemblyList(BankInfo& info, uInt16 search, bool force)
 {
   // An empty address list means that DiStella can't do a disassembly
   if(info.addressList.size() == 0)
     return false;
 
-  myDisassembly.list.clear();
+  CachedDisassembly& cache = myDisassemblyCache[&info - myBankInfo.data()];
+  disassembleBank(info, cache, force);
+  myDisassembly.list = cache.list;
   myDisassembly.fieldwidth = 24 + myLabelLength;
-  DiStella distella(*this, myDisassembly.list, info, DiStella::settings,
-                    myDisLabels, myDisDirectives, myReserved);
 
   // Parts of the disassembly will be accessed later in different ways
   // We place those parts in separate maps, to speed up access
@@ -318,6 +320,69 @@ bool CartDebug::fillDisassemblyList(BankInfo& info, uInt16 search)
   return found;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartDebug::disassembleBank(BankInfo& info, CachedDisassembly& cache,
+                                bool force)
+{
+  // Only run DiStella if anything the disassembly depends on has changed
+  // since this bank was last disassembled
+  const uInt64 key = disassemblyKey(info);
+
+  if(force || !cache.valid || cache.key != key)
+  {
+    cache.list.clear();
+    DiStella distella(*this, cache.list, info, DiStella::settings,
+                      myDisLabels, myDisDirectives, myReserved);
+
+    cache.key = key;
+    cache.valid = true;
+    cache.labels = myDisLabels;
+    cache.directives = myDisDirectives;
+    cache.breakFound = myReserved.breakFound;
+  }
+  else
+  {
+    myDisLabels = cache.labels;
+    myDisDirectives = cache.directives;
+    myReserved.breakFound = cache.breakFound;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 CartDebug::disassemblyKey(const BankInfo& info) const
+{
+  // FNV-1a over the contents and access flags of the address space, and
+  // all settings, directives and labels which affect the disassembly
+  uInt64 key = 0xcbf29ce484222325ULL;
+  const auto add = [&key] (uInt64 value) {
+    key = (key ^ value) * 0x100000001b3ULL;
+  };
+
+  add(&info - myBankInfo.data());
+  add(info.offset);
+  for(uInt16 addr: info.addressList)
+    add(addr);
+  for(const auto& tag: info.directiveList)
+    add((uInt64(tag.type) << 32) | (uInt64(tag.start) << 16) | tag.end);
+
+  const DiStella::Settings& settings = DiStella::settings;
+  add(uInt64(settings.gfxFormat));
+  add((settings.resolveCode << 0) | (settings.showAddresses << 1) |
+      (settings.aFlag << 2) | (settings.fFlag << 3) |
+      (settings.rFlag << 4) | (settings.bFlag << 5));
+  add(settings.bytesWidth);
+  add(myLabelChanges);
+  add(myReserved.Label.size());
+
+  const bool isROM = !info.addressList.empty() && (info.addressList.front() & 0x1000);
+  const uInt16 start = isROM ? 0x1000 : 0x0080,
+               end   = isROM ? 0x2000 : 0x0100;
+  for(uInt16 addr = start; addr < end; ++addr)
+    add((uInt64(mySystem.peek(addr)) << 8) | mySystem.getAccessFlags(addr));
+
+  return key;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 int CartDebug::addressToLine(uInt16 address) const
 {
@@ -536,6 +601,7 @@ bool CartDebug::addLabel(const string& label, uInt16 address)
       myUserLabels.emplace(address, label);
       myLabelLength = std::max(myLabelLength, uInt16(label.size()));
       mySystem.setDirtyPage(address);
+      ++myLabelChanges;
       return true;
   }
 }
@@ -555,6 +621,7 @@ bool CartDebug::removeLabel(const string& label)
     // Erase the label itself
     mySystem.setDirtyPage(iter->second);
     myUserAddresses.erase(iter);
+    ++myLabelChanges;
 
     return true;
   }
@@ -772,6 +839,7 @@ string CartDebug::loadSymbolFile()
 
   myUserAddresses.clear();
   myUserLabels.clear();
+  ++myLabelChanges;
 
   while(!in.eof())
   {
@@ -990,8 +1058,10 @@ string CartDebug::saveDisassembly()
   settings.bytesWidth = 8+1;  // same as Stella debugger
   settings.bFlag = DiStella::settings.bFlag; // process break routine (TODO)
 
-  Disassembly disasm;
-  disasm.list.reserve(2048);
+  // Temporarily switch to these settings; they are part of the cache key
+  const DiStella::Settings debuggerSettings = DiStella::settings;
+  DiStella::settings = settings;
+
   for(int bank = 0; bank < myConsole.cartridge().bankCount(); ++bank)
   {
     BankInfo& info = myBankInfo[bank];
@@ -999,21 +1069,22 @@ string CartDebug::saveDisassembly()
     if(info.addressList.size() == 0)
       continue;
 
-    // Disassemble bank
-    disasm.list.clear();
-    DiStella distella(*this, disasm.list, info, settings,
-                      myDisLabels, myDisDirectives, myReserved);
+    // Disassemble bank, or reuse the result of the last 'savedis' if the
+    // bank hasn't changed since
+    disassembleBank(info, mySaveDisassemblyCache[bank]);
+    const DisassemblyList& list = mySaveDisassemblyCache[bank].list;
 
-    if (myReserved.breakFound)
+    // Redefining the label would invalidate all cached disassemblies
+    if (myReserved.breakFound && getAddress("Break") != myDebugger.dpeek(0xfffe))
       addLabel("Break", myDebugger.dpeek(0xfffe));
 
     buf << "    SEG     CODE\n"
         << "    ORG     $" << Base::HEX4 << info.offset << "\n\n";
 
     // Format in 'distella' style
-    for(uInt32 i = 0; i < disasm.list.size(); ++i)
+    for(uInt32 i = 0; i < list.size(); ++i)
     {
-      const DisassemblyTag& tag = disasm.list[i];
+      const DisassemblyTag& tag = list[i];
 
       // Add label (if any)
       if(tag.label != "")
@@ -1066,6 +1137,7 @@ string CartDebug::saveDisassembly()
       buf << "\n";
     }
   }
+  DiStella::settings = debuggerSettings;
 
   // Some boilerplate, similar to what DiStella adds
   auto timeinfo = BSPF::localTime();
@@ -290,9 +290,28 @@ class CartDebug : public DebuggerSystem
     };
     ReservedEquates myReserved;
 
+    // The last DiStella result for a bank, so that switching back to a bank
+    // which hasn't changed doesn't disassemble it again
+    struct CachedDisassembly {
+      uInt64 key{0};               // hash of everything DiStella depends on
+      bool valid{false};
+      DisassemblyList list;
+      AddrTypeArray labels, directives;
+      bool breakFound{false};
+    };
+
     // Actually call DiStella to fill the DisassemblyList structure
+    // (or take it from the cache, unless 'force' is set)
     // Return whether the search address was actually in the list
-    bool fillDisassemblyList(BankInfo& bankinfo, uInt16 search);
+    bool fillDisassemblyList(BankInfo& bankinfo, uInt16 search, bool force = false);
+
+    // Disassemble the given bank into 'cache', unless the cached result
+    // is still valid (and 'force' isn't set)
+    void disassembleBank(BankInfo& info, CachedDisassembly& cache,
+                         bool force = false);
+
+    // Calculate the cache key for disassembling the given bank
+    uInt64 disassemblyKey(const BankInfo& info) const;
 
     // Analyze of bank of ROM, generating a list of Distella directives
     // based on its disassembly
@@ -325,6 +344,15 @@ class CartDebug : public DebuggerSystem
     std::map<uInt16, int> myAddrToLineList;
     bool myAddrToLineIsROM{true};
 
+    // Cached disassembly for each entry in myBankInfo, as shown in the
+    // debugger and as written by 'savedis' (which uses other settings)
+    vector<CachedDisassembly> myDisassemblyCache;
+    vector<CachedDisassembly> mySaveDisassemblyCache;
+
+    // Incremented whenever user-defined labels change, since these are
+    // part of the disassembly
+    uInt32 myLabelChanges{0};
+
     // Mappings from label to address (and vice versa) for items
     // defined by the user (either through a DASM symbol file or manually
     // from the commandline in the debugger)
@@ -0,0 +1,136 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <fstream>
+
+#include "Base.hxx"
+#include "CartDebug.hxx"
+
+#include "CycleProfiler.hxx"
+
+using Common::Base;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+CycleProfiler::CycleProfiler(uInt32 numBanks, bool scanlines)
+  : myNumBanks(std::max(numBanks, 1u)),
+    myScanlines(scanlines),
+    myCounters((myNumBanks + 1) * BANK_SIZE),
+    myOrigin(myNumBanks + 1, 0x1000)
+{
+  // Code outside of the cartridge address space is counted at its address
+  myOrigin[myNumBanks] = 0x0000;
+
+  if(myScanlines)
+  {
+    myLineRows.resize(myCounters.size(), 0);
+    myLineCounters.reserve(ROW_RESERVE * MAX_SCANLINES);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 CycleProfiler::totalCycles() const
+{
+  uInt64 total = 0;
+  for(const auto& c: myCounters)
+    total += c.cycles;
+
+  return total;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 CycleProfiler::totalInstructions() const
+{
+  uInt64 total = 0;
+  for(const auto& c: myCounters)
+    total += c.instructions;
+
+  return total;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string CycleProfiler::save(const string& filename, const string& command,
+                           const CartDebug& cartDebug) const
+{
+  std::ofstream out(filename);
+  if(!out.is_open())
+    return "unable to write " + filename;
+
+  out << "# callgrind format" << endl
+      << "version: 1" << endl
+      << "creator: Stella" << endl
+      << "cmd: " << command << endl
+      << "positions: instr" << (myScanlines ? " line" : "") << endl
+      << "events: Cycles Instructions" << endl
+      << "summary: " << totalCycles() << " " << totalInstructions() << endl;
+
+  // The last 'bank' holds the code executed from RAM
+  for(uInt32 bank = 0; bank <= myNumBanks; ++bank)
+  {
+    const uInt32 base = bank * BANK_SIZE;
+    string function, lastFunction;
+
+    for(uInt32 offset = 0; offset < BANK_SIZE; ++offset)
+    {
+      const uInt16 address = uInt16(myOrigin[bank] | offset);
+
+      // Every label starts a new function; code before the first label
+      // is named after its address
+      const string& label = cartDebug.getLabel(address, true);
+      if(!label.empty())
+        function = label;
+
+      const Counter& c = myCounters[base + offset];
+      if(c.instructions == 0)
+        continue;
+
+      if(lastFunction.empty())
+      {
+        if(bank < myNumBanks)
+          out << "\nfl=bank " << bank << "\n";
+        else
+          out << "\nfl=RAM\n";
+      }
+      if(function.empty())
+        function = "$" + Base::toString(address, Base::Fmt::_16_4);
+      if(function != lastFunction)
+      {
+        out << "fn=" << function << "\n";
+        lastFunction = function;
+      }
+
+      if(myScanlines)
+      {
+        const LineCounter* lines =
+          &myLineCounters[(myLineRows[base + offset] - 1) * MAX_SCANLINES];
+        for(uInt32 line = 0; line < MAX_SCANLINES; ++line)
+        {
+          const LineCounter& l = lines[line];
+          if(l.instructions > 0)
+            out << "0x" << std::hex << address << std::dec << " " << line << " "
+                << l.cycles << " " << l.instructions << "\n";
+        }
+      }
+      else
+        out << "0x" << std::hex << address << std::dec << " "
+            << c.cycles << " " << c.instructions << "\n";
+    }
+  }
+
+  ostringstream buf;
+  buf << "profile of " << totalCycles() << " cycles written to " << filename;
+  return buf.str();
+}
@@ -0,0 +1,157 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef CYCLE_PROFILER_HXX
+#define CYCLE_PROFILER_HXX
+
+class CartDebug;
+
+#include "bspf.hxx"
+
+/**
+  This class attributes the CPU cycles executed to the ROM address and
+  bank of each instruction, and optionally to the scanline on which the
+  instruction started.
+
+  The counters live in a flat array with 4K entries per bank, plus 4K
+  entries for code executed outside of the cartridge address space (i.e.
+  from RIOT RAM).  With scanlines enabled, each address that is executed
+  gets a row of per-scanline counters on its first execution.  The rows
+  are taken from a pool which is reserved up front and only grows once
+  more than ROW_RESERVE addresses have been executed.  The cycles an
+  instruction halts the CPU (i.e. STA WSYNC) are attributed to that
+  instruction.
+
+  The result is written in the callgrind format, so it can be viewed with
+  tools like KCachegrind.  Functions are named after the labels defined
+  by the symbol and list files; every bank is a separate file, and so is
+  the code executed from RAM.  With scanlines enabled, the 'line'
+  position is the scanline.
+*/
+class CycleProfiler
+{
+  public:
+    static constexpr uInt32 BANK_SIZE = 4096;
+    static constexpr uInt32 MAX_SCANLINES = 320;  // larger values are clamped
+    static constexpr uInt32 ROW_RESERVE = 4096;   // scanline rows reserved
+
+    /**
+      @param numBanks   The number of banks of the cartridge
+      @param scanlines  Also attribute cycles to scanlines
+    */
+    CycleProfiler(uInt32 numBanks, bool scanlines);
+
+    bool scanlines() const { return myScanlines; }
+
+    /**
+      Called before each instruction is executed.
+    */
+    void begin(uInt16 pc, uInt16 bank, uInt64 cycles)
+    {
+      if(pc & 0x1000)
+      {
+        if(bank >= myNumBanks)
+          bank = uInt16(myNumBanks - 1);
+
+        myIndex = bank * BANK_SIZE + (pc & (BANK_SIZE - 1));
+        myOrigin[bank] = pc & ~(BANK_SIZE - 1);
+      }
+      else
+        myIndex = myNumBanks * BANK_SIZE + (pc & (BANK_SIZE - 1));
+
+      myStartCycles = cycles;
+    }
+    void setScanline(uInt32 scanline)
+    {
+      myScanline = std::min(scanline, MAX_SCANLINES - 1);
+    }
+
+    /**
+      Called after each instruction has been executed.
+    */
+    void end(uInt64 cycles)
+    {
+      const uInt32 spent = uInt32(cycles - myStartCycles);
+
+      myCounters[myIndex].cycles += spent;
+      ++myCounters[myIndex].instructions;
+
+      if(myScanlines)
+      {
+        uInt32& row = myLineRows[myIndex];
+        if(row == 0)
+        {
+          myLineCounters.resize(myLineCounters.size() + MAX_SCANLINES);
+          row = uInt32(myLineCounters.size() / MAX_SCANLINES);
+        }
+        LineCounter& c = myLineCounters[(row - 1) * MAX_SCANLINES + myScanline];
+        c.cycles += spent;
+        ++c.instructions;
+      }
+    }
+
+    uInt64 totalCycles() const;
+    uInt64 totalInstructions() const;
+
+    /**
+      Write the profile in callgrind format.
+
+      @param filename  The file to write to
+      @param command   Describes the profiled program (usually the ROM name)
+      @return  A message describing the result
+    */
+    string save(const string& filename, const string& command,
+                const CartDebug& cartDebug) const;
+
+  private:
+    struct Counter {
+      uInt64 cycles{0};
+      uInt64 instructions{0};
+    };
+    struct LineCounter {
+      uInt32 cycles{0};
+      uInt32 instructions{0};
+    };
+
+    uInt32 myNumBanks{1};
+    bool myScanlines{false};
+
+    // One counter per address and bank, followed by the RAM addresses
+    vector<Counter> myCounters;
+    // For each entry of myCounters, its row in myLineCounters plus one
+    // (0 = not executed yet)
+    vector<uInt32> myLineRows;
+    // Rows of MAX_SCANLINES counters, one row per executed address
+    vector<LineCounter> myLineCounters;
+    // The address range each bank was last executed in (RAM uses $0000)
+    vector<uInt16> myOrigin;
+
+    // The instruction currently executed
+    uInt32 myIndex{0};
+    uInt32 myScanline{0};
+    uInt64 myStartCycles{0};
+
+  private:
+    // Following constructors and assignment operators not supported
+    CycleProfiler() = delete;
+    CycleProfiler(const CycleProfiler&) = delete;
+    CycleProfiler(CycleProfiler&&) = delete;
+    CycleProfiler& operator=(const CycleProfiler&) = delete;
+    CycleProfiler& operator=(CycleProfiler&&) = delete;
+};
+
+#endif
@@ -41,6 +41,7 @@
 #include "CpuDebug.hxx"
 #include "RiotDebug.hxx"
 #include "TIADebug.hxx"
+#include "RamSearch.hxx"
 
 #include "TiaInfoWidget.hxx"
 #include "TiaOutputWidget.hxx"
@@ -73,6 +74,7 @@ Debugger::Debugger(OSystem& osystem, Console& console)
   myCartDebug = make_unique<CartDebug>(*this, myConsole, osystem);
   myRiotDebug = make_unique<RiotDebug>(*this, myConsole);
   myTiaDebug  = make_unique<TIADebug>(*this, myConsole);
+  myRamSearch = make_unique<RamSearch>(osystem, *this);
 
   // Allow access to this object from any class
   // Technically this violates pure OO programming, but since I know
@@ -38,6 +38,7 @@ class CartDebug;
 class CpuDebug;
 class RiotDebug;
 class TIADebug;
+class RamSearch;
 class DebuggerParser;
 class RewindManager;
 
@@ -145,6 +146,11 @@ class Debugger : public DialogContainer
     */
     TIADebug& tiaDebug() const { return *myTiaDebug; }
 
+    /**
+      The RAM search over all Time Machine states
+    */
+    RamSearch& ramSearch() const { return *myRamSearch; }
+
     const GUI::Font& lfont() const      { return myDialog->lfont();     }
     const GUI::Font& nlfont() const     { return myDialog->nfont();     }
     DebuggerParser& parser() const      { return *myParser;             }
@@ -344,6 +350,7 @@ class Debugger : public DialogContainer
     unique_ptr<CpuDebug>       myCpuDebug;
     unique_ptr<RiotDebug>      myRiotDebug;
     unique_ptr<TIADebug>       myTiaDebug;
+    unique_ptr<RamSearch>      myRamSearch;
 
     static Debugger* myStaticDebugger;
 
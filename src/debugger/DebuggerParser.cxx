@@ -19,11 +19,13 @@
 
 #include "Dialog.hxx"
 #include "Debugger.hxx"
+#include "Cart.hxx"
 #include "CartDebug.hxx"
 #include "CpuDebug.hxx"
 #include "RiotDebug.hxx"
 #include "ControlLowLevel.hxx"
 #include "TIADebug.hxx"
+#include "RamSearch.hxx"
 #include "TiaOutputWidget.hxx"
 #include "DebuggerParser.hxx"
 #include "YaccParser.hxx"
@@ -35,6 +37,7 @@
 #include "RomWidget.hxx"
 #include "ProgressDialog.hxx"
 #include "TimerManager.hxx"
+#include "PerfCounters.hxx"
 #include "Vec.hxx"
 
 #include "Base.hxx"
@@ -1626,6 +1629,30 @@ void DebuggerParser::executePc()
   debugger.cpuDebug().setPC(args[0]);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "perf"
+void DebuggerParser::executePerf()
+{
+  if(!PerfCounters::enabled())
+  {
+    commandResult << red("performance counters not compiled in "
+                         "(configure with --enable-perfcounters)");
+    return;
+  }
+
+  const PerfCounters::Sampler& sampler = debugger.myOSystem.perfSampler();
+  commandResult << "Last second of emulation:";
+  for(const string& line: PerfCounters::summary(sampler.lastInterval(),
+                                                sampler.lastIntervalSeconds()))
+    commandResult << endl << "  " << line;
+
+  const PerfCounters::Values values = PerfCounters::values();
+  commandResult << endl << "Totals:";
+  for(uInt32 i = 0; i < PerfCounters::NUM_COUNTERS; ++i)
+    commandResult << endl << "  " << setw(18) << std::left
+                  << PerfCounters::name(PerfCounters::Counter(i)) << dec << values[i];
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "pgfx"
 void DebuggerParser::executePGfx()
@@ -1655,6 +1682,53 @@ void DebuggerParser::executePrint()
   commandResult << eval();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "profile"
+void DebuggerParser::executeProfile()
+{
+  M6502& cpu = debugger.m6502();
+  const CycleProfiler* profiler = cpu.profiler();
+
+  if(argCount == 0)
+  {
+    if(profiler)
+      commandResult << "profiling, " << dec << profiler->totalCycles()
+                    << " cycles in " << profiler->totalInstructions()
+                    << " instructions";
+    else
+      commandResult << "not profiling";
+    return;
+  }
+
+  const string& mode = argStrings[0];
+  const string& cartName =
+    debugger.myOSystem.console().properties().get(PropType::Cart_Name);
+
+  if(mode == "start")
+  {
+    const bool lines = argCount > 1 && argStrings[1] == "lines";
+    cpu.setProfiler(make_unique<CycleProfiler>(
+        debugger.myOSystem.console().cartridge().bankCount(), lines));
+    commandResult << "profiling started" << (lines ? " (with scanlines)" : "");
+  }
+  else if(mode == "save" || mode == "stop")
+  {
+    if(!profiler)
+    {
+      commandResult << "not profiling";
+      return;
+    }
+    // 'callgrind.out.' is the prefix tools like KCachegrind look for
+    const string file = FilesystemNode(debugger.myOSystem.defaultSaveDir() +
+                                       "callgrind.out." + cartName).getPath();
+    commandResult << profiler->save(file, cartName, debugger.cartDebug());
+    if(mode == "stop")
+      cpu.setProfiler(nullptr);
+  }
+  else
+    outputCommandError("invalid mode " + mode, myCommand);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "ram"
 void DebuggerParser::executeRam()
@@ -1665,6 +1739,86 @@ void DebuggerParser::executeRam()
     commandResult << debugger.setRAM(args);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "ramsearch"
+void DebuggerParser::executeRamsearch()
+{
+  RamSearch& search = debugger.ramSearch();
+
+  if(argCount == 0 || argStrings[0] == "list")
+  {
+    commandResult << search.summary();
+    if(search.active())
+      commandResult << endl << search.list(argCount == 0 ? 32 : 1024);
+    return;
+  }
+
+  const string& mode = argStrings[0];
+  if(mode == "start")
+  {
+    commandResult << search.start();
+    if(search.active())
+      commandResult << endl << search.summary();
+    return;
+  }
+  else if(!search.active())
+  {
+    commandResult << red("no search started, use 'ramsearch start'");
+    return;
+  }
+
+  for(uInt32 i = 1; i < argCount; ++i)
+    if(args[i] < 0)
+    {
+      commandResult << red("invalid argument ") << argStrings[i];
+      return;
+    }
+
+  // States are given in decimal and numbered as in the Time Machine dialog,
+  // starting at 1 (values and amounts are hex, like everywhere else)
+  auto state = [&](uInt32 i) {
+    const int s = BSPF::stringToInt(argStrings[i]);
+    return s > 0 ? uInt32(s - 1) : search.numStates();
+  };
+
+  if(mode == "eq" || mode == "ne")
+  {
+    if(argCount < 2 || argCount > 3 || args[1] > 0xff)
+    {
+      outputCommandError("specify a byte value and an optional state", myCommand);
+      return;
+    }
+    commandResult << search.filter(mode == "eq" ? RamSearch::Filter::equal
+                                                : RamSearch::Filter::notEqual,
+                                   0, argCount == 3 ? state(2) : search.numStates() - 1,
+                                   args[1]);
+  }
+  else if(mode == "inc" || mode == "dec")
+  {
+    if(argCount < 3 || argCount > 4 || (argCount == 4 && args[3] > 0xff))
+    {
+      outputCommandError("specify two states and an optional amount", myCommand);
+      return;
+    }
+    commandResult << search.filter(mode == "inc" ? RamSearch::Filter::increased
+                                                 : RamSearch::Filter::decreased,
+                                   state(1), state(2), argCount == 4 ? args[3] : -1);
+  }
+  else if(mode == "same" || mode == "changed")
+  {
+    if(argCount != 3)
+    {
+      outputCommandError("specify two states", myCommand);
+      return;
+    }
+    commandResult << search.filter(mode == "same" ? RamSearch::Filter::same
+                                                  : RamSearch::Filter::changed,
+                                   state(1), state(2));
+  }
+  else
+    outputCommandError("invalid search mode " + mode, myCommand);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "reset"
 void DebuggerParser::executeReset()
@@ -1967,6 +2121,68 @@ void DebuggerParser::executeTrace()
   commandResult << "executed " << dec << debugger.trace() << " cycles";
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "tracerec"
+void DebuggerParser::executeTracerec()
+{
+  M6502& cpu = debugger.m6502();
+  const TraceRecorder* recorder = cpu.traceRecorder();
+
+  if(argCount == 0)
+  {
+    if(recorder)
+      commandResult << "recording to " << recorder->filename() << ", "
+                    << dec << recorder->numRecords() << " records";
+    else
+      commandResult << "not recording";
+    return;
+  }
+
+  const string& mode = argStrings[0];
+  const string traceFile = FilesystemNode(debugger.myOSystem.defaultSaveDir() +
+    debugger.myOSystem.console().properties().get(PropType::Cart_Name) + ".trace").getPath();
+
+  if(mode == "start")
+  {
+    const bool bus = argCount > 1 && argStrings[1] == "bus";
+    cpu.setTraceRecorder(nullptr);  // finish a running trace first
+
+    auto newRecorder = make_unique<TraceRecorder>(traceFile, bus);
+    if(!newRecorder->isOpen())
+    {
+      commandResult << red("unable to create ") << traceFile;
+      return;
+    }
+    cpu.setTraceRecorder(std::move(newRecorder));
+    commandResult << "recording to " << traceFile
+                  << (bus ? " (with bus accesses)" : "");
+  }
+  else if(mode == "stop")
+  {
+    if(!recorder)
+    {
+      commandResult << "not recording";
+      return;
+    }
+    const uInt64 numRecords = recorder->numRecords();
+    const string file = recorder->filename();
+    cpu.setTraceRecorder(nullptr);
+    commandResult << "wrote " << dec << numRecords << " records to " << file;
+  }
+  else if(mode == "decode")
+  {
+    const string file = argCount > 1 ? FilesystemNode(argStrings[1]).getPath() : traceFile;
+    if(recorder && recorder->filename() == file)
+    {
+      commandResult << red("stop recording first");
+      return;
+    }
+    commandResult << TraceRecorder::decode(file, file + ".txt", debugger.cartDebug());
+  }
+  else
+    outputCommandError("invalid mode " + mode, myCommand);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "trap"
 void DebuggerParser::executeTrap()
@@ -2300,7 +2516,7 @@ void DebuggerParser::executeZ()
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // List of all commands available to the parser
-std::array<DebuggerParser::Command, 95> DebuggerParser::commands = { {
+std::array<DebuggerParser::Command, 99> DebuggerParser::commands = { {
   {
     "a",
     "Set Accumulator to <value>",
@@ -2847,6 +3063,17 @@ std::array<DebuggerParser::Command, 95> DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executePc)
   },
 
+  {
+    "perf",
+    "Show performance counters",
+    "Needs a build configured with --enable-perfcounters\n"
+    "Example: perf (no parameters)",
+    false,
+    false,
+    { Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executePerf)
+  },
+
   {
     "pgfx",
     "Mark 'PGFX' range in disassembly",
@@ -2868,6 +3095,18 @@ std::array<DebuggerParser::Command, 95> DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executePrint)
   },
 
+  {
+    "profile",
+    "Profile the cycles executed per ROM address",
+    "Modes: start [lines] (also per scanline), save, stop (saves too)\n"
+    "Writes callgrind.out.<rom name> to the save directory, named after labels\n"
+    "Example: profile start, profile start lines, profile stop",
+    false,
+    false,
+    { Parameters::ARG_LABEL, Parameters::ARG_MULTI_BYTE },
+    std::mem_fn(&DebuggerParser::executeProfile)
+  },
+
   {
     "ram",
     "Show ZP RAM, or set address xx to yy1 [yy2 ...]",
@@ -2878,6 +3117,18 @@ std::array<DebuggerParser::Command, 95> DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executeRam)
   },
 
+  {
+    "ramsearch",
+    "Search RAM over all Time Machine states",
+    "Modes: start, list, eq/ne xx [s], inc/dec s1 s2 [xx], same/changed s1 s2\n"
+    "States are decimal, numbered as in the Time Machine (1 = oldest)\n"
+    "Example: ramsearch start, ramsearch dec 3 4 1, ramsearch eq 5 7",
+    false,
+    false,
+    { Parameters::ARG_LABEL, Parameters::ARG_MULTI_BYTE },
+    std::mem_fn(&DebuggerParser::executeRamsearch)
+  },
+
   {
     "reset",
     "Reset system to power-on state",
@@ -3114,6 +3365,19 @@ std::array<DebuggerParser::Command, 95> DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executeTrace)
   },
 
+  {
+    "tracerec",
+    "Record a binary execution trace to a file",
+    "Modes: start [bus], stop, decode [file] (converts a trace to text)\n"
+    "Records registers, bank and beam position per instruction, and with\n"
+    "'bus' all bus reads and writes\n"
+    "Example: tracerec start, tracerec start bus, tracerec stop, tracerec decode",
+    false,
+    false,
+    { Parameters::ARG_LABEL, Parameters::ARG_MULTI_BYTE },
+    std::mem_fn(&DebuggerParser::executeTracerec)
+  },
+
   {
     "trap",
     "Trap read/write access to address(es) xx [yy]",
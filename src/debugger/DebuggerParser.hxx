@@ -97,7 +97,7 @@ class DebuggerParser
       std::array<Parameters, 10> parms;
       std::function<void (DebuggerParser*)> executor;
     };
-    static std::array<Command, 95> commands;
+    static std::array<Command, 99> commands;
 
     struct Trap
     {
@@ -195,9 +195,12 @@ class DebuggerParser
     void executeN();
     void executePalette();
     void executePc();
+    void executePerf();
     void executePGfx();
     void executePrint();
+    void executeProfile();
     void executeRam();
+    void executeRamsearch();
     void executeReset();
     void executeRewind();
     void executeRiot();
@@ -221,6 +224,7 @@ class DebuggerParser
     void executeStepwhile();
     void executeTia();
     void executeTrace();
+    void executeTracerec();
     void executeTrap();
     void executeTrapif();
     void executeTrapread();
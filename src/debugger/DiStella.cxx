@@ -179,7 +179,7 @@ FIX_LAST:
 
       // detect labels inside instructions (e.g. BIT masks)
       labelFound = false;
-      for (Uint8 i = 0; i < ourLookup[opcode].bytes - 1; i++) {
+      for (uInt8 i = 0; i < ourLookup[opcode].bytes - 1; i++) {
         if (checkBit(myPC + i, CartDebug::REFERENCED)) {
           labelFound = true;
           break;
@@ -190,7 +190,7 @@ FIX_LAST:
           // the opcode's operand address matches a label address
           if (pass == 3) {
             // output the byte of the opcode incl. cycles
-            Uint8 nextOpcode = Debugger::debugger().peek(myPC + myOffset);
+            uInt8 nextOpcode = Debugger::debugger().peek(myPC + myOffset);
 
             cycles += int(ourLookup[opcode].cycles) - int(ourLookup[nextOpcode].cycles);
             nextLine << ".byte   $" << Base::HEX2 << int(opcode) << " ;";
@@ -0,0 +1,261 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "Base.hxx"
+#include "CartDebug.hxx"
+#include "CartDebugWidget.hxx"
+#include "Console.hxx"
+#include "Debugger.hxx"
+#include "M6532.hxx"
+#include "OSystem.hxx"
+#include "RewindManager.hxx"
+#include "Serializer.hxx"
+#include "StateManager.hxx"
+#include "TIA.hxx"
+
+#include "RamSearch.hxx"
+
+using Common::Base;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RamSearch::RamSearch(OSystem& osystem, Debugger& debugger)
+  : myOSystem(osystem),
+    myDebugger(debugger)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string RamSearch::start()
+{
+  myLocations.clear();
+  myValues.clear();
+  myCandidates.clear();
+
+  RewindManager& r = myOSystem.state().rewindManager();
+  const uInt32 numStates = r.getLastIdx();
+  if(numStates == 0)
+    return "no Time Machine states to search";
+
+  // RIOT RAM
+  M6532& riot = myOSystem.console().riot();
+  vector<uInt32> offsets;
+  if(!probe(128,
+      [&](uInt32 i) { return riot.getRAM()[i]; },
+      [&](uInt32 i, uInt8 value) { riot.poke(uInt16(i), value); },
+      false, offsets))
+    return "RAM not found in save states";
+
+  for(uInt32 i = 0; i < 128; ++i)
+    myLocations.push_back({offsets[i], false, false, uInt16(0x80 + i)});
+
+  // Cartridge RAM, if the cart exposes it to the debugger
+  CartDebugWidget* cart = myDebugger.cartDebug().getDebugWidget();
+  const uInt32 cartSize = cart ? cart->internalRamSize() : 0;
+  bool cartFound = false;
+  if(cartSize > 0)
+  {
+    cartFound = probe(cartSize,
+      [&](uInt32 i) { return cart->internalRamGetValue(int(i)); },
+      [&](uInt32 i, uInt8 value) { cart->internalRamSetValue(int(i), value); },
+      true, offsets);
+
+    if(cartFound)
+      for(uInt32 i = 0; i < cartSize; ++i)
+        myLocations.push_back({offsets[i], true, true,
+                               uInt16(cart->internalRamRPort(int(i)))});
+  }
+
+  // Decode all states; every job only writes the values of its own state
+  myValues.resize(numStates);
+  r.visitStates([&](uInt32 idx, const uInt8* data, uInt32 size) {
+    for(const auto& loc: myLocations)
+      if(loc.fromEnd ? loc.offset > size : loc.offset >= size)
+        return;
+
+    ByteArray& values = myValues[idx];
+    values.resize(myLocations.size());
+    for(uInt32 i = 0; i < myLocations.size(); ++i)
+    {
+      const Location& loc = myLocations[i];
+      values[i] = data[loc.fromEnd ? size - loc.offset : loc.offset];
+    }
+  });
+
+  myCandidates.resize(myLocations.size());
+  for(uInt32 i = 0; i < myCandidates.size(); ++i)
+    myCandidates[i] = i;
+
+  ostringstream buf;
+  buf << "searching " << std::dec << numStates << " states, "
+      << myLocations.size() << " addresses";
+  if(cartSize > 0 && !cartFound)
+    buf << " (cart RAM not found in save states)";
+
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string RamSearch::filter(Filter filter, uInt32 from, uInt32 to, Int32 value)
+{
+  if(!active())
+    return "no search started";
+
+  const bool needFrom = filter != Filter::equal && filter != Filter::notEqual;
+  if(to >= numStates() || (needFrom && from >= numStates()))
+    return "no such state";
+
+  const ByteArray& a = myValues[needFrom ? from : to];
+  const ByteArray& b = myValues[to];
+  if(a.empty() || b.empty())
+    return "state could not be decoded";
+
+  auto matches = [&](uInt32 i) {
+    switch(filter)
+    {
+      case Filter::equal:     return b[i] == value;
+      case Filter::notEqual:  return b[i] != value;
+      case Filter::increased:
+        return value < 0 ? b[i] > a[i] : uInt8(b[i] - a[i]) == value;
+      case Filter::decreased:
+        return value < 0 ? b[i] < a[i] : uInt8(a[i] - b[i]) == value;
+      case Filter::same:      return b[i] == a[i];
+      case Filter::changed:   return b[i] != a[i];
+    }
+    return false;
+  };
+
+  myCandidates.erase(std::remove_if(myCandidates.begin(), myCandidates.end(),
+      [&](uInt32 i) { return !matches(i); }), myCandidates.end());
+
+  return summary();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string RamSearch::summary() const
+{
+  if(!active())
+    return "no search started";
+
+  constexpr uInt32 MAX_INLINE = 8;
+  ostringstream buf;
+
+  buf << std::dec << myCandidates.size()
+      << (myCandidates.size() == 1 ? " candidate" : " candidates");
+  if(!myCandidates.empty() && myCandidates.size() <= MAX_INLINE)
+  {
+    buf << ":";
+    for(uInt32 i: myCandidates)
+      buf << " " << describe(myLocations[i]);
+  }
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string RamSearch::list(uInt32 max) const
+{
+  // Show the values of the newest state which could be decoded
+  const ByteArray* values = nullptr;
+  for(auto it = myValues.rbegin(); it != myValues.rend() && !values; ++it)
+    if(!it->empty())
+      values = &*it;
+
+  ostringstream buf;
+  uInt32 count = 0;
+  for(uInt32 i: myCandidates)
+  {
+    if(count++ == max)
+    {
+      buf << "  ..." << endl;
+      break;
+    }
+    buf << "  " << describe(myLocations[i]);
+    if(values)
+      buf << " = $" << Base::toString((*values)[i], Base::Fmt::_16_2);
+    buf << endl;
+  }
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RamSearch::probe(uInt32 size, const Getter& get, const Setter& set,
+                      bool fromEnd, vector<uInt32>& offsets)
+{
+  if(size == 0 || size > 0x10000)
+    return false;
+
+  ByteArray original(size);
+  for(uInt32 i = 0; i < size; ++i)
+    original[i] = get(i);
+
+  // Low byte of the index, its complement and the high byte of the index;
+  // the first two differ in every bit only where the RAM is stored
+  std::array<ByteArray, 3> states;
+  bool ok = true;
+  for(uInt32 p = 0; p < states.size() && ok; ++p)
+  {
+    for(uInt32 i = 0; i < size; ++i)
+      set(i, p == 0 ? uInt8(i) : p == 1 ? uInt8(~i) : uInt8(i >> 8));
+    ok = snapshot(states[p]);
+  }
+
+  for(uInt32 i = 0; i < size; ++i)
+    set(i, original[i]);
+
+  if(!ok || states[0].size() != states[1].size() ||
+     states[0].size() != states[2].size())
+    return false;
+
+  const uInt32 stateSize = uInt32(states[0].size());
+  constexpr uInt32 NOT_FOUND = ~0u;
+  offsets.assign(size, NOT_FOUND);
+  for(uInt32 o = 0; o < stateSize; ++o)
+  {
+    if(uInt8(states[0][o] ^ states[1][o]) != 0xff)
+      continue;
+
+    const uInt32 idx = states[0][o] | (states[2][o] << 8);
+    if(idx < size && offsets[idx] == NOT_FOUND)
+      offsets[idx] = fromEnd ? stateSize - o : o;
+  }
+
+  return std::find(offsets.begin(), offsets.end(), NOT_FOUND) == offsets.end();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RamSearch::snapshot(ByteArray& data)
+{
+  Serializer s;
+  if(!s || !myOSystem.state().saveState(s) ||
+     !myOSystem.console().tia().saveDisplay(s))
+    return false;
+
+  data.resize(s.size());
+  s.rewind();
+  s.getByteArray(data.data(), data.size());
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string RamSearch::describe(const Location& loc) const
+{
+  // Cart RAM is shown with the addresses used by the cart RAM widget
+  if(!loc.cart)
+    return "$" + Base::toString(loc.address, Base::Fmt::_16_2);
+  else
+    return "cart $" + Base::toString(loc.address, Base::Fmt::_16_4);
+}
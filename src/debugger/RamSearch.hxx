@@ -0,0 +1,148 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef RAM_SEARCH_HXX
+#define RAM_SEARCH_HXX
+
+class OSystem;
+class Debugger;
+
+#include <functional>
+
+#include "bspf.hxx"
+
+/**
+  This class searches for RAM locations (RIOT and cartridge RAM) across
+  all states currently held by the Time Machine, similar to the search and
+  compare functions of the RAM widgets, but over the whole history instead
+  of only the current and the previous state.
+
+  Starting a search decodes the RAM of every state, in parallel; all
+  addresses are candidates at first.  Each filter then narrows the
+  candidates by a constraint between states, e.g. 'the value decreased by
+  one between state 3 and 4' or 'the value is 5 in state 7'.
+
+  The RAM is located within the serialized states by probing the current
+  console: the RAM is filled with known patterns, and the states saved
+  from it are compared.  RIOT RAM is found relative to the start of a
+  state, cartridge RAM relative to its end, since the TIA state in between
+  is of variable size.
+
+  States are numbered from zero (the oldest state).
+*/
+class RamSearch
+{
+  public:
+    enum class Filter {
+      equal,      // value in 'to' equals 'value'
+      notEqual,   // value in 'to' differs from 'value'
+      increased,  // value increased from 'from' to 'to' (by 'value', if >= 0)
+      decreased,  // value decreased from 'from' to 'to' (by 'value', if >= 0)
+      same,       // value is the same in 'from' and 'to'
+      changed     // value changed from 'from' to 'to'
+    };
+
+    RamSearch(OSystem& osystem, Debugger& debugger);
+
+    /**
+      Decode the RAM of all Time Machine states and make all addresses
+      candidates.
+
+      @return  A message describing the result
+    */
+    string start();
+
+    /**
+      Keep only the candidates matching the given filter.
+
+      @return  A message describing the result
+    */
+    string filter(Filter filter, uInt32 from, uInt32 to, Int32 value = -1);
+
+    /**
+      Answers whether a search has been started (and there are states).
+    */
+    bool active() const { return !myValues.empty(); }
+
+    uInt32 numStates() const     { return uInt32(myValues.size()); }
+    uInt32 numCandidates() const { return uInt32(myCandidates.size()); }
+
+    /**
+      A one line summary; if there are only a few candidates left, their
+      addresses are included.
+    */
+    string summary() const;
+
+    /**
+      The candidates and their values in the newest state, one per line.
+
+      @param max  The maximum number of candidates listed
+    */
+    string list(uInt32 max) const;
+
+  private:
+    struct Location {
+      uInt32 offset{0};     // offset in the serialized state
+      bool fromEnd{false};  // offset counted backwards from the end
+      bool cart{false};     // cartridge RAM (else RIOT RAM)
+      uInt16 address{0};    // address shown to the user
+    };
+
+    using Getter = std::function<uInt8(uInt32)>;
+    using Setter = std::function<void(uInt32, uInt8)>;
+
+    /**
+      Locate 'size' bytes of RAM in the current state, by filling them with
+      patterns (using 'set') and comparing the resulting states.  The RAM
+      is restored afterwards.
+
+      @return  False if not all bytes could be located, else true
+    */
+    bool probe(uInt32 size, const Getter& get, const Setter& set,
+               bool fromEnd, vector<uInt32>& offsets);
+
+    /**
+      Serialize the current state the way the Time Machine does.
+    */
+    bool snapshot(ByteArray& data);
+
+    string describe(const Location& loc) const;
+
+  private:
+    OSystem& myOSystem;
+    Debugger& myDebugger;
+
+    // All searchable locations
+    vector<Location> myLocations;
+
+    // One value per location for each state; empty for states which
+    // couldn't be decoded
+    vector<ByteArray> myValues;
+
+    // Indices into the locations which still match all filters
+    vector<uInt32> myCandidates;
+
+  private:
+    // Following constructors and assignment operators not supported
+    RamSearch() = delete;
+    RamSearch(const RamSearch&) = delete;
+    RamSearch(RamSearch&&) = delete;
+    RamSearch& operator=(const RamSearch&) = delete;
+    RamSearch& operator=(RamSearch&&) = delete;
+};
+
+#endif
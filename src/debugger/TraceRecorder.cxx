@@ -0,0 +1,158 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <chrono>
+
+#include "Base.hxx"
+#include "CartDebug.hxx"
+
+#include "TraceRecorder.hxx"
+
+using Common::Base;
+
+namespace {
+  // Identifies the file format; the version is increased whenever the
+  // record layout changes
+  constexpr char TRACE_MAGIC[8] = { 'S', 't', 'e', 'l', 'T', 'r', 'c', '2' };
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TraceRecorder::TraceRecorder(const string& filename, bool busAccesses)
+  : myFilename(filename),
+    myFile(filename, std::ios::binary | std::ios::trunc),
+    myBusAccesses(busAccesses),
+    myRing(RING_SIZE)
+{
+  if(!myFile.is_open())
+    return;
+
+  const uInt32 recordSize = sizeof(Record);
+  myFile.write(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+  myFile.write(reinterpret_cast<const char*>(&recordSize), sizeof(recordSize));
+
+  myWriter = std::thread([this] { writerMain(); });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TraceRecorder::~TraceRecorder()
+{
+  if(myWriter.joinable())
+  {
+    myQuit = true;
+    myWriter.join();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TraceRecorder::writerMain()
+{
+  for(;;)
+  {
+    const uInt64 tail = myTail.load(std::memory_order_relaxed);
+    const uInt64 head = myHead.load(std::memory_order_acquire);
+
+    if(head == tail)
+    {
+      // Only quit once everything has been written
+      if(myQuit)
+        break;
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      continue;
+    }
+
+    // Write the pending records up to the end of the ring at most
+    const uInt64 end = std::min(head, (tail | (RING_SIZE - 1)) + 1);
+    myFile.write(reinterpret_cast<const char*>(&myRing[tail & (RING_SIZE - 1)]),
+                 (end - tail) * sizeof(Record));
+
+    myTail.store(end, std::memory_order_release);
+  }
+  myFile.close();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string TraceRecorder::decode(const string& traceFile, const string& textFile,
+                             const CartDebug& cartDebug)
+{
+  std::ifstream in(traceFile, std::ios::binary);
+  if(!in.is_open())
+    return "unable to read trace file " + traceFile;
+
+  char magic[sizeof(TRACE_MAGIC)];
+  uInt32 recordSize = 0;
+  in.read(magic, sizeof(magic));
+  in.read(reinterpret_cast<char*>(&recordSize), sizeof(recordSize));
+  if(!in || !std::equal(magic, magic + sizeof(magic), TRACE_MAGIC) ||
+     recordSize != sizeof(Record))
+    return "invalid trace file " + traceFile;
+
+  std::ofstream out(textFile);
+  if(!out.is_open())
+    return "unable to write " + textFile;
+
+  out << "       cycle  line/clk  bank  address  label              "
+         "A  X  Y  SP PS" << endl;
+
+  constexpr uInt32 BLOCK_SIZE = 4096;
+  vector<Record> block(BLOCK_SIZE);
+  uInt64 count = 0;
+  for(;;)
+  {
+    in.read(reinterpret_cast<char*>(block.data()), BLOCK_SIZE * sizeof(Record));
+    const uInt32 numRecords = uInt32(in.gcount() / sizeof(Record));
+    if(numRecords == 0)
+      break;
+
+    for(uInt32 i = 0; i < numRecords; ++i)
+    {
+      const Record& r = block[i];
+      out << std::dec << std::right << std::setw(12) << r.cycles << "  ";
+      if(r.kind == Kind::instruction)
+      {
+        string flags = "NV-BDIZC";
+        for(int bit = 0; bit < 8; ++bit)
+          if(!(r.ps & (0x80 >> bit)))
+            flags[bit] = '.';
+
+        out << std::setw(4) << r.scanline << "/" << std::left << std::setw(3)
+            << int(r.clock) << "  #" << std::setw(2) << (r.value | (r.bankHigh << 8))
+            << "  $" << Base::toString(r.address, Base::Fmt::_16_4) << "    "
+            << std::setw(18) << cartDebug.getLabel(r.address, true) << " "
+            << Base::toString(r.a, Base::Fmt::_16_2) << " "
+            << Base::toString(r.x, Base::Fmt::_16_2) << " "
+            << Base::toString(r.y, Base::Fmt::_16_2) << " "
+            << Base::toString(r.sp, Base::Fmt::_16_2) << " " << flags;
+      }
+      else
+      {
+        const bool read = r.kind == Kind::read;
+        out << std::setw(20) << (read ? "R" : "W") << "  $"
+            << Base::toString(r.address, Base::Fmt::_16_4) << "    "
+            << std::left << std::setw(18) << cartDebug.getLabel(r.address, read)
+            << " = $" << Base::toString(r.value, Base::Fmt::_16_2);
+      }
+      // No endl, flushing every line would slow down long traces
+      out << '\n';
+    }
+    count += numRecords;
+  }
+
+  ostringstream buf;
+  buf << "decoded " << std::dec << count << " records to " << textFile;
+  return buf.str();
+}
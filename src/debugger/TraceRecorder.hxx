@@ -0,0 +1,165 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef TRACE_RECORDER_HXX
+#define TRACE_RECORDER_HXX
+
+class CartDebug;
+
+#include <atomic>
+#include <fstream>
+#include <thread>
+
+#include "bspf.hxx"
+
+/**
+  This class records an execution trace of the 6502 to a binary file, at
+  close to full emulation speed.
+
+  For every instruction, the CPU registers, the bank, the system cycles
+  and the TIA beam position are recorded before the instruction executes;
+  optionally, every bus read and write is recorded as well.  The records
+  have a fixed size and are put into a lock-free ring buffer, which a
+  background thread drains to disk.  When the buffer is full, the
+  emulation waits for the writer, so no records are ever lost.
+
+  The file starts with a short header, followed by the raw records (in
+  host byte order).  decode() converts a trace into text, annotated with
+  the labels known to the debugger.
+*/
+class TraceRecorder
+{
+  public:
+    enum class Kind : uInt8 {
+      instruction = 0,
+      read        = 1,
+      write       = 2
+    };
+
+    struct Record {
+      uInt64 cycles{0};     // system cycles
+      uInt16 address{0};    // PC or bus address
+      uInt16 scanline{0};   // scanline (instructions only)
+      Kind kind{Kind::instruction};
+      uInt8 value{0};       // bank (low byte) for instructions, else bus data
+      uInt8 clock{0};       // color clock within scanline (instructions only)
+      uInt8 a{0}, x{0}, y{0}, sp{0}, ps{0};  // registers (instructions only)
+      uInt8 bankHigh{0};    // bank (high byte) for instructions
+    };
+    static_assert(sizeof(Record) == 24, "unexpected trace record size");
+
+  public:
+    /**
+      Create the file and start the writer thread.
+
+      @param filename     The file to record to
+      @param busAccesses  Also record all bus reads and writes
+    */
+    TraceRecorder(const string& filename, bool busAccesses);
+
+    /**
+      Write all pending records and close the file.
+    */
+    ~TraceRecorder();
+
+    bool isOpen() const { return myFile.is_open(); }
+    bool busAccesses() const { return myBusAccesses; }
+    const string& filename() const { return myFilename; }
+
+    /**
+      The number of records produced so far.
+    */
+    uInt64 numRecords() const { return myHead.load(std::memory_order_relaxed); }
+
+    void recordInstruction(uInt16 pc, uInt16 bank, uInt8 a, uInt8 x, uInt8 y,
+                           uInt8 sp, uInt8 ps, uInt64 cycles,
+                           uInt32 scanline, uInt32 clock)
+    {
+      Record& r = next();
+      r.cycles = cycles;
+      r.address = pc;
+      r.scanline = uInt16(scanline);
+      r.kind = Kind::instruction;
+      r.value = uInt8(bank);
+      r.bankHigh = uInt8(bank >> 8);
+      r.clock = uInt8(clock);
+      r.a = a;  r.x = x;  r.y = y;  r.sp = sp;  r.ps = ps;
+      commit();
+    }
+
+    void recordAccess(Kind kind, uInt16 address, uInt8 value, uInt64 cycles)
+    {
+      Record& r = next();
+      r = Record();
+      r.cycles = cycles;
+      r.address = address;
+      r.kind = kind;
+      r.value = value;
+      commit();
+    }
+
+    /**
+      Convert the given binary trace into text, using the labels of the
+      debugger.
+
+      @return  A message describing the result
+    */
+    static string decode(const string& traceFile, const string& textFile,
+                         const CartDebug& cartDebug);
+
+  private:
+    // The ring is only written by the emulation thread and only read by
+    // the writer thread; both positions increase monotonically
+    Record& next()
+    {
+      const uInt64 head = myHead.load(std::memory_order_relaxed);
+      while(head - myTail.load(std::memory_order_acquire) >= RING_SIZE)
+        std::this_thread::yield();
+
+      return myRing[head & (RING_SIZE - 1)];
+    }
+    void commit()
+    {
+      myHead.store(myHead.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_release);
+    }
+
+    void writerMain();
+
+  private:
+    static constexpr uInt32 RING_SIZE = 1 << 16;  // must be a power of two
+
+    string myFilename;
+    std::ofstream myFile;
+    bool myBusAccesses{false};
+
+    vector<Record> myRing;
+    std::atomic<uInt64> myHead{0}, myTail{0};
+    std::atomic<bool> myQuit{false};
+
+    std::thread myWriter;
+
+  private:
+    // Following constructors and assignment operators not supported
+    TraceRecorder() = delete;
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder(TraceRecorder&&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(TraceRecorder&&) = delete;
+};
+
+#endif
@@ -228,11 +228,11 @@ void CartridgeBUSWidget::saveOldState()
     myOldState.addressmaps.push_back(0);
 
   for(uInt32 i = 0; i < 3; ++i)
-    myOldState.mcounters.push_back(myCart.myMusicCounters[i]);
+    myOldState.mcounters.push_back(myCart.myMusic.counter(i));
 
   for(uInt32 i = 0; i < 3; ++i)
   {
-    myOldState.mfreqs.push_back(myCart.myMusicFrequencies[i]);
+    myOldState.mfreqs.push_back(myCart.myMusic.frequency(i));
     myOldState.mwaves.push_back(myCart.getWaveform(i) >> 5);
     myOldState.mwavesizes.push_back(myCart.getWaveformSize((i)));
   }
@@ -317,16 +317,16 @@ void CartridgeBUSWidget::loadConfig()
   alist.clear();  vlist.clear();  changed.clear();
   for(int i = 0; i < 3; ++i)
   {
-    alist.push_back(0);  vlist.push_back(myCart.myMusicCounters[i]);
-    changed.push_back(myCart.myMusicCounters[i] != uInt32(myOldState.mcounters[i]));
+    alist.push_back(0);  vlist.push_back(myCart.myMusic.counter(i));
+    changed.push_back(myCart.myMusic.counter(i) != uInt32(myOldState.mcounters[i]));
   }
   myMusicCounters->setList(alist, vlist, changed);
 
   alist.clear();  vlist.clear();  changed.clear();
   for(int i = 0; i < 3; ++i)
   {
-    alist.push_back(0);  vlist.push_back(myCart.myMusicFrequencies[i]);
-    changed.push_back(myCart.myMusicFrequencies[i] != uInt32(myOldState.mfreqs[i]));
+    alist.push_back(0);  vlist.push_back(myCart.myMusic.frequency(i));
+    changed.push_back(myCart.myMusic.frequency(i) != uInt32(myOldState.mfreqs[i]));
   }
   myMusicFrequencies->setList(alist, vlist, changed);
 
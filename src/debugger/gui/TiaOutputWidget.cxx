@@ -75,17 +75,15 @@ void TiaOutputWidget::saveSnapshot(int execDepth, const string& execPrefix)
   sspath << std::hex << std::setw(8) << std::setfill('0')
          << uInt32(TimerManager::getTicks()/1000) << ".png";
 
-  const uInt32 width  = instance().console().tia().width(),
-               height = instance().console().tia().height();
-  FBSurface& s = dialog().surface();
+  if(mySurface == nullptr)
+    drawWidget(false);
 
-  // to skip borders, add 1 to origin
-  int x = _x + 1, y = _y + 1;
-  Common::Rect rect(x, y, x + width*2, y + height);
+  const Common::Rect& src = mySurface->srcRect();
+  Common::Rect rect(0, 0, src.w(), src.h());
   string message = "Snapshot saved";
   try
   {
-    instance().png().saveImage(sspath.str(), s, rect);
+    instance().png().saveImage(sspath.str(), *mySurface, rect);
   }
   catch(const runtime_error& e)
   {
@@ -172,29 +170,69 @@ void TiaOutputWidget::drawWidget(bool hilite)
   s.vLine(_x + _w + 1, _y, height, kColor);
   s.hLine(_x, _y + height + 1, _x +_w + 1, kColor);
 
+  // The image is drawn into its own surface, which is then scaled and
+  // blitted over the dialog in one go
+  if(mySurface == nullptr)
+  {
+    mySurface = instance().frameBuffer().allocateSurface(
+        TIAConstants::H_PIXEL * 2, FrameManager::Metrics::baseHeightPAL);
+    mySurface->applyAttributes();
+
+    dialog().addSurface(mySurface);
+  }
+  const uInt32 scale = instance().frameBuffer().hidpiScaleFactor();
+  const Common::Rect& s_dst = s.dstRect();
+  mySurface->setSrcSize(width << 1, height);
+  mySurface->setDstSize((width << 1) * scale, height * scale);
+  mySurface->setDstPos((_x + 1) * scale + s_dst.x(), (_y + 1) * scale + s_dst.y());
+
   // Get current scanline position
   // This determines where the frame greying should start, and where a
   // scanline 'pointer' should be drawn
   uInt32 scanx, scany, scanoffset;
   bool visible = instance().console().tia().electronBeamPos(scanx, scany);
   scanoffset = width * scany + scanx;
-  uInt8* tiaOutputBuffer = instance().console().tia().outputBuffer();
+  // Below the beam, the last completed frame is shown
+  const uInt8* tiaOutputBuffer = instance().console().tia().outputBuffer();
+  const uInt8* tiaLastFrame = instance().console().tia().lastFrameBuffer();
   TIASurface& tiaSurface(instance().frameBuffer().tiaSurface());
 
+  // The surface itself serves as the cache of what was shown last time;
+  // only the lines that actually differ are written and uploaded again
+  uInt32 *buffer, pitch;
+  mySurface->basePtr(buffer, pitch);
+  uInt32 dirtyFirst = height, dirtyLast = 0;
+
   for(uInt32 y = 0, i = yStart * width; y < height; ++y)
   {
-    uInt32* line_ptr = myLineBuffer.data();
+    uInt32* line_ptr = buffer + y * pitch;
+    bool changed = false;
     for(uInt32 x = 0; x < width; ++x, ++i)
     {
       uInt8 shift = i >= scanoffset ? 1 : 0;
-      uInt32 pixel = tiaSurface.mapIndexedPixel(tiaOutputBuffer[i], shift);
-      *line_ptr++ = pixel;
-      *line_ptr++ = pixel;
+      uInt32 pixel = tiaSurface.mapIndexedPixel(shift ? tiaLastFrame[i] : tiaOutputBuffer[i], shift);
+      if(line_ptr[0] != pixel || line_ptr[1] != pixel)
+      {
+        line_ptr[0] = line_ptr[1] = pixel;
+        changed = true;
+      }
+      line_ptr += 2;
+    }
+    if(changed)
+    {
+      dirtyFirst = std::min(dirtyFirst, y);
+      dirtyLast = y;
     }
-    s.drawPixels(myLineBuffer.data(), _x + 1, _y + 1 + y, width << 1);
   }
 
   // Show electron beam position
   if(visible && scanx < width && scany+2U < height)
-    s.fillRect(_x + 1 + (scanx<<1), _y + 1 + scany, 3, 3, kColorInfo);
+  {
+    mySurface->fillRect(scanx << 1, scany, 3, 3, kColorInfo);
+    dirtyFirst = std::min(dirtyFirst, scany);
+    dirtyLast = std::max(dirtyLast, scany + 2);
+  }
+
+  mySurface->setDirtyLines(dirtyFirst,
+      dirtyFirst <= dirtyLast ? dirtyLast - dirtyFirst + 1 : 0);
 }
@@ -53,9 +53,9 @@ class TiaOutputWidget : public Widget, public CommandSender
 
     int myClickX{0}, myClickY{0};
 
-    // Create this buffer once, instead of allocating it each time the
-    // TIA image is redrawn
-    std::array<uInt32, 320> myLineBuffer;
+    // The TIA image is expanded into this surface and blitted on top of
+    // the dialog; its pixels are only updated where the image changed
+    shared_ptr<FBSurface> mySurface;
 
   private:
     void handleMouseDown(int x, int y, MouseButton b, int clickCount) override;
@@ -28,6 +28,7 @@
 #include "GuiObject.hxx"
 #include "ContextMenu.hxx"
 #include "FrameManager.hxx"
+#include "TIASurface.hxx"
 #include "TiaZoomWidget.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -292,27 +293,65 @@ void TiaZoomWidget::drawWidget(bool hilite)
   s.frameRect(_x, _y, _w, _h, hilite ? kWidColorHi : kColor);
 
   // Draw the zoomed image
-  // This probably isn't as efficient as it can be, but it's a small area
-  // and I don't have time to make it faster :)
+  // The visible part of the image is copied into a separate surface, which
+  // is then scaled to the zoom level and blitted over the dialog in one go
   const uInt8* currentFrame  = instance().console().tia().outputBuffer();
+  const uInt8* lastFrame     = instance().console().tia().lastFrameBuffer();
   const int width = instance().console().tia().width(),
             wzoom = myZoomLevel << 1,
             hzoom = myZoomLevel;
+  const int xStart = myOffX >> 1, xEnd = (myNumCols + myOffX) >> 1;
+  const uInt32 cols = std::max(xEnd - xStart, 1), rows = std::max(myNumRows, 1);
+
+  if(mySurface == nullptr)
+  {
+    mySurface = instance().frameBuffer().allocateSurface(
+        TIAConstants::H_PIXEL, FrameManager::Metrics::maxHeight);
+    mySurface->applyAttributes();
+
+    dialog().addSurface(mySurface);
+  }
+  const uInt32 scale = instance().frameBuffer().hidpiScaleFactor();
+  const Common::Rect& s_dst = s.dstRect();
+  mySurface->setSrcSize(cols, rows);
+  mySurface->setDstSize(cols * wzoom * scale, rows * hzoom * scale);
+  mySurface->setDstPos((_x + 1) * scale + s_dst.x(), (_y + 1) * scale + s_dst.y());
 
   // Get current scanline position
   // This determines where the frame greying should start
   uInt32 scanx, scany, scanoffset;
   instance().console().tia().electronBeamPos(scanx, scany);
   scanoffset = width * scany + scanx;
+  TIASurface& tiaSurface(instance().frameBuffer().tiaSurface());
+
+  // Only the lines which differ from what the surface already holds are
+  // written and uploaded again
+  uInt32 *buffer, pitch;
+  mySurface->basePtr(buffer, pitch);
+  uInt32 dirtyFirst = rows, dirtyLast = 0;
 
-  int x, y, col, row;
-  for(y = myOffY, row = 0; y < myNumRows+myOffY; ++y, row += hzoom)
+  for(uInt32 row = 0; row < uInt32(myNumRows); ++row)
   {
-    for(x = myOffX >> 1, col = 0; x < (myNumCols+myOffX) >> 1; ++x, col += wzoom)
+    uInt32* line_ptr = buffer + row * pitch;
+    bool changed = false;
+    for(int x = xStart; x < xEnd; ++x, ++line_ptr)
     {
-      uInt32 idx = y*width + x;
-      ColorId color = ColorId(currentFrame[idx] | (idx > scanoffset ? 1 : 0));
-      s.fillRect(_x + col + 1, _y + row + 1, wzoom, hzoom, color);
+      uInt32 idx = (row + myOffY) * width + x;
+      uInt32 pixel = idx > scanoffset ? tiaSurface.mapIndexedPixel(lastFrame[idx], 1)
+                                      : tiaSurface.mapIndexedPixel(currentFrame[idx]);
+      if(*line_ptr != pixel)
+      {
+        *line_ptr = pixel;
+        changed = true;
+      }
+    }
+    if(changed)
+    {
+      dirtyFirst = std::min(dirtyFirst, row);
+      dirtyLast = row;
     }
   }
+
+  mySurface->setDirtyLines(dirtyFirst,
+      dirtyFirst <= dirtyLast ? dirtyLast - dirtyFirst + 1 : 0);
 }
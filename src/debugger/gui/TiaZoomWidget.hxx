@@ -20,6 +20,7 @@
 
 class GuiObject;
 class ContextMenu;
+class FBSurface;
 
 #include "Widget.hxx"
 #include "Command.hxx"
@@ -55,6 +56,10 @@ class TiaZoomWidget : public Widget, public CommandSender
   private:
     unique_ptr<ContextMenu> myMenu;
 
+    // The visible part of the TIA image, one surface pixel per TIA pixel;
+    // it is scaled to the zoom level when blitted on top of the dialog
+    shared_ptr<FBSurface> mySurface;
+
     int myZoomLevel{0};
     int myNumCols{0}, myNumRows{0};
     int myOffX{0}, myOffY{0};
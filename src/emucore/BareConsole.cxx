@@ -0,0 +1,105 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "BareConsole.hxx"
+#include "FSNode.hxx"
+#include "CartDetector.hxx"
+#include "MD5.hxx"
+#include "Joystick.hxx"
+#include "Props.hxx"
+#include "Serializer.hxx"
+#include "Settings.hxx"
+#include "frame-manager/FrameLayoutDetector.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+BareConsole::BareConsole(unique_ptr<Cartridge> cart, Settings& settings,
+                         const Properties& props,
+                         const Cartridge::StartBankFromPropsFunc& startBank)
+  : myCart(std::move(cart)),
+    myCpu(settings),
+    myRiot(myIO, settings),
+    myTIA(myIO, [this]() { return myTiming; }, settings),
+    mySystem(myRandom, myCpu, myRiot, myTIA, *myCart)
+{
+  myIO.myLeftControl = make_unique<Joystick>(Controller::Jack::Left, myEvent, mySystem);
+  myIO.myRightControl = make_unique<Joystick>(Controller::Jack::Right, myEvent, mySystem);
+  myIO.mySwitches = make_unique<Switches>(myEvent, props, settings);
+
+  myTIA.bindToControllers();
+  myCart->setStartBankFromPropsFunc(startBank);
+  mySystem.initialize();
+
+  myTIA.setFrameManager(&myFrameManager);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+BareConsole::~BareConsole() = default;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+unique_ptr<Cartridge> BareConsole::createCartridge(const FilesystemNode& romFile,
+    const ByteBuffer& image, size_t size, Settings& settings, const string& type)
+{
+  string md5 = MD5::hash(image, size);
+  unique_ptr<Cartridge> cartridge =
+    CartDetector::create(romFile, image, size, md5, type, settings);
+
+  if(!cartridge)
+    throw runtime_error("unable to determine cartridge type");
+
+  return cartridge;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FrameLayout BareConsole::detectFrameLayout(const std::atomic<bool>* cancel)
+{
+  FrameLayoutDetector frameLayoutDetector;
+  myTIA.setFrameManager(&frameLayoutDetector);
+  mySystem.reset(true);
+  myRiot.update();
+
+  for(int i = 0; i < 60 && !(cancel && *cancel); ++i)
+    myTIA.update();
+
+  myTIA.setFrameManager(&myFrameManager);
+
+  return frameLayoutDetector.detectedLayout();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BareConsole::setFrameLayout(FrameLayout layout)
+{
+  myTiming = layout == FrameLayout::pal ? ConsoleTiming::pal : ConsoleTiming::ntsc;
+
+  myTIA.setLayout(layout);
+  mySystem.consoleChanged(myTiming);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool BareConsole::save(Serializer& out) const
+{
+  return mySystem.save(out) &&
+    myIO.myLeftControl->save(out) && myIO.myRightControl->save(out) &&
+    myIO.mySwitches->save(out);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool BareConsole::load(Serializer& in)
+{
+  return mySystem.load(in) &&
+    myIO.myLeftControl->load(in) && myIO.myRightControl->load(in) &&
+    myIO.mySwitches->load(in);
+}
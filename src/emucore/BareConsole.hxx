@@ -0,0 +1,139 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef BARE_CONSOLE_HXX
+#define BARE_CONSOLE_HXX
+
+#include <atomic>
+
+class FilesystemNode;
+class Serializer;
+class Settings;
+class Properties;
+
+#include "bspf.hxx"
+#include "Cart.hxx"
+#include "Control.hxx"
+#include "ConsoleIO.hxx"
+#include "ConsoleTiming.hxx"
+#include "Event.hxx"
+#include "Random.hxx"
+#include "Switches.hxx"
+#include "M6502.hxx"
+#include "M6532.hxx"
+#include "TIA.hxx"
+#include "System.hxx"
+#include "frame-manager/FrameManager.hxx"
+#include "FrameLayout.hxx"
+
+/**
+  The bare emulation core of a console: cartridge, CPU, RIOT, TIA and
+  System, with a joystick in each port and the console switches, but
+  without the sound, video and event subsystems of a full Console.  This
+  is the stack that ProfilingRunner::runOne builds, for code that runs the
+  core on its own (StellaEnvironment, DifferentialRunner and
+  ConsolePreloader).
+
+  The components are public, so that the owner can drive them directly.
+  The settings and properties passed in must outlive the console.
+*/
+class BareConsole
+{
+  public:
+    /**
+      Create the core around the given cartridge.
+
+      @param cart       The cartridge (see createCartridge())
+      @param settings   The settings used by all components
+      @param props      The properties used by the console switches
+      @param startBank  Returns the start bank from the properties, or -1
+    */
+    BareConsole(unique_ptr<Cartridge> cart, Settings& settings,
+                const Properties& props,
+                const Cartridge::StartBankFromPropsFunc& startBank =
+                  []() { return -1; });
+
+    ~BareConsole();
+
+    /**
+      Create a cartridge from the given image, in the same way as a
+      Console is created from it.
+
+      @param type  The bankswitching type; empty or 'AUTO' to detect it
+
+      Throws runtime_error if no cartridge can be created.
+    */
+    static unique_ptr<Cartridge> createCartridge(const FilesystemNode& romFile,
+        const ByteBuffer& image, size_t size, Settings& settings,
+        const string& type = "");
+
+    /**
+      Reset the system and detect the frame layout over 60 frames, just
+      like Console::autodetectFrameLayout() does.  The console is left in
+      the state after the detection.
+
+      @param cancel  If given, the detection stops early once it is set
+
+      @return  The detected frame layout
+    */
+    FrameLayout detectFrameLayout(const std::atomic<bool>* cancel = nullptr);
+
+    /**
+      Switch the TIA and the system timing to the given frame layout.
+    */
+    void setFrameLayout(FrameLayout layout);
+
+    /**
+      Save/load the system, the controllers and the switches.
+    */
+    bool save(Serializer& out) const;
+    bool load(Serializer& in);
+
+  public:
+    struct IO: public ConsoleIO {
+        Controller& leftController() const override { return *myLeftControl; }
+        Controller& rightController() const override { return *myRightControl; }
+        Switches& switches() const override { return *mySwitches; }
+
+        unique_ptr<Controller> myLeftControl;
+        unique_ptr<Controller> myRightControl;
+        unique_ptr<Switches> mySwitches;
+    };
+
+    IO myIO;
+    Random myRandom{0};
+    Event myEvent;
+    ConsoleTiming myTiming{ConsoleTiming::ntsc};
+
+    unique_ptr<Cartridge> myCart;
+    M6502 myCpu;
+    M6532 myRiot;
+    TIA myTIA;
+    System mySystem;
+
+    FrameManager myFrameManager;
+
+  private:
+    // Following constructors and assignment operators not supported
+    BareConsole() = delete;
+    BareConsole(const BareConsole&) = delete;
+    BareConsole(BareConsole&&) = delete;
+    BareConsole& operator=(const BareConsole&) = delete;
+    BareConsole& operator=(BareConsole&&) = delete;
+};
+
+#endif
@@ -113,15 +113,39 @@ void Cartridge::pokeRAM(uInt8& dest, uInt16 address, uInt8 value)
   dest = value;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Cartridge::enableDebugging()
+{
+  myDebuggingEnabled = true;
+
+  if(myRomImage)
+    myRomImage->unshare();
+  createCodeAccessBase(myCodeAccessSize);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Cartridge::createCodeAccessBase(size_t size)
 {
+  myCodeAccessSize = size;
+
 #ifdef DEBUGGER_SUPPORT
-  myCodeAccessBase = make_unique<uInt8[]>(size);
-  std::fill_n(myCodeAccessBase.get(), size, CartDebug::ROW);
-#else
-  myCodeAccessBase = nullptr;
+  if(myDebuggingEnabled && size > 0)
+  {
+    myCodeAccessBase = make_unique<uInt8[]>(size);
+    std::fill_n(myCodeAccessBase.get(), size, CartDebug::ROW);
+  }
+  else
 #endif
+    myCodeAccessBase = nullptr;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Cartridge::shareImage(RomImage& image)
+{
+  myRomImage = &image;
+
+  if(!myDebuggingEnabled)
+    image.share();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
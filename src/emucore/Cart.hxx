@@ -27,6 +27,7 @@ class GuiObject;
 #include "bspf.hxx"
 #include "Device.hxx"
 #include "Settings.hxx"
+#include "RomImage.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "Font.hxx"
 #endif
@@ -69,6 +70,17 @@ class Cartridge : public Device
     */
     bool saveROM(ofstream& out) const;
 
+    /**
+      Prepare this cart for the debugger and cheats: it gets a private
+      copy of its ROM image, which can then be patched, and the array
+      holding code-access information is created.  Otherwise, the image
+      is shared with all other carts of the same ROM, and no code-access
+      information is kept.
+
+      This must be called before the cart is installed in a system.
+    */
+    void enableDebugging();
+
     /**
       Lock/unlock bankswitching capability.  The debugger will lock
       the banks before querying the cart state, otherwise reading values
@@ -269,12 +281,32 @@ class Cartridge : public Device
     /**
       Create an array that holds code-access information for every byte
       of the ROM (indicated by 'size').  Note that this is only used by
-      the debugger, and is unavailable otherwise.
+      the debugger, and is unavailable otherwise.  The array is created
+      once debugging is enabled.
 
       @param size  The size of the code-access array to create
     */
     void createCodeAccessBase(size_t size);
 
+    /**
+      Get a pointer into the code-access array.
+
+      @param offset  The offset into the array
+      @return  The pointer, or nullptr if there is no code-access array
+    */
+    uInt8* codeAccess(size_t offset) const {
+      return myCodeAccessBase ? &myCodeAccessBase[offset] : nullptr;
+    }
+
+    /**
+      Share the ROM image of the cart with all other carts holding the same
+      image, unless debugging is enabled.  This should be called from the
+      c'tor, once the image has been filled in.
+
+      @param image  The ROM image of the cart
+    */
+    void shareImage(RomImage& image);
+
     /**
       Fill the given RAM array with (possibly random) data.
 
@@ -347,6 +379,13 @@ class Cartridge : public Device
     // Used when we want the 'Cartridge.StartBank' ROM property
     StartBankFromPropsFunc myStartBankFromPropsFunc;
 
+    // The (possibly shared) ROM image, as registered by the derived class
+    RomImage* myRomImage{nullptr};
+
+    // The size of the code-access array, created when debugging is enabled
+    size_t myCodeAccessSize{0};
+    bool myDebuggingEnabled{false};
+
     // Contains
     ShortArray myRAMAccesses;
 
@@ -16,6 +16,7 @@
 //============================================================================
 
 #include "System.hxx"
+#include "PerfCounters.hxx"
 #include "Cart0840.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -127,6 +128,8 @@ bool Cartridge0840::bank(uInt16 bank)
 {
   if(bankLocked()) return false;
 
+  PERF_COUNT(bankSwitches, 1);
+
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
@@ -137,7 +140,7 @@ bool Cartridge0840::bank(uInt16 bank)
   for(uInt16 addr = 0x1000; addr < 0x2000; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
+    access.codeAccessBase = codeAccess(myBankOffset + (addr & 0x0FFF));
     mySystem->setPageAccess(addr, access);
   }
   return myBankChanged = true;
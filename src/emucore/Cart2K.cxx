@@ -33,7 +33,7 @@ Cartridge2K::Cartridge2K(const ByteBuffer& image, size_t size,
 
   // Initialize ROM with illegal 6502 opcode that causes a real 6502 to jam
   size_t bufSize = std::max<size_t>(mySize, System::PAGE_SIZE);
-  myImage = make_unique<uInt8[]>(bufSize);
+  myImage.allocate(bufSize);
   std::fill_n(myImage.get(), bufSize, 0x02);
 
   // Handle cases where ROM is smaller than the page size
@@ -51,6 +51,7 @@ Cartridge2K::Cartridge2K(const ByteBuffer& image, size_t size,
     mySize = System::PAGE_SIZE;
   }
 
+  shareImage(myImage);
   createCodeAccessBase(mySize);
 
   // Set mask for accessing the image buffer
@@ -76,7 +77,7 @@ void Cartridge2K::install(System& system)
   for(uInt16 addr = 0x1000; addr < 0x2000; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myImage[addr & myMask];
-    access.codeAccessBase = &myCodeAccessBase[addr & myMask];
+    access.codeAccessBase = codeAccess(addr & myMask);
     mySystem->setPageAccess(addr, access);
   }
 }
@@ -84,6 +85,10 @@ void Cartridge2K::install(System& system)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Cartridge2K::patch(uInt16 address, uInt8 value)
 {
+  // Only a private image can be patched (see Cartridge::enableDebugging)
+  if(myImage.isShared())
+    return false;
+
   myImage[address & myMask] = value;
   return myBankChanged = true;
 }
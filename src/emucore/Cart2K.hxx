@@ -127,7 +127,7 @@ class Cartridge2K : public Cartridge
 
   private:
     // Pointer to a dynamically allocated ROM image of the cartridge
-    ByteBuffer myImage;
+    RomImage myImage;
 
     // Size of the ROM image
     size_t mySize{0};
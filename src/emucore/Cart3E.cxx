@@ -16,6 +16,7 @@
 //============================================================================
 
 #include "System.hxx"
+#include "PerfCounters.hxx"
 #include "TIA.hxx"
 #include "Cart3E.hxx"
 
@@ -26,10 +27,11 @@ Cartridge3E::Cartridge3E(const ByteBuffer& image, size_t size,
     mySize(size)
 {
   // Allocate array for the ROM image
-  myImage = make_unique<uInt8[]>(mySize);
+  myImage.allocate(mySize);
 
   // Copy the ROM image into my buffer
   std::copy_n(image.get(), mySize, myImage.get());
+  shareImage(myImage);
   createCodeAccessBase(mySize + myRAM.size());
 }
 
@@ -59,7 +61,7 @@ void Cartridge3E::install(System& system)
   for(uInt16 addr = 0x1800; addr < 0x2000; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myImage[(mySize - 2048) + (addr & 0x07FF)];
-    access.codeAccessBase = &myCodeAccessBase[(mySize - 2048) + (addr & 0x07FF)];
+    access.codeAccessBase = codeAccess((mySize - 2048) + (addr & 0x07FF));
     mySystem->setPageAccess(addr, access);
   }
 
@@ -135,6 +137,8 @@ bool Cartridge3E::bank(uInt16 bank)
 {
   if(bankLocked()) return false;
 
+  PERF_COUNT(bankSwitches, 1);
+
   if(bank < 256)
   {
     // Make sure the bank they're asking for is reasonable
@@ -158,7 +162,7 @@ bool Cartridge3E::bank(uInt16 bank)
     for(uInt16 addr = 0x1000; addr < 0x1800; addr += System::PAGE_SIZE)
     {
       access.directPeekBase = &myImage[offset + (addr & 0x07FF)];
-      access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x07FF)];
+      access.codeAccessBase = codeAccess(offset + (addr & 0x07FF));
       mySystem->setPageAccess(addr, access);
     }
   }
@@ -177,7 +181,7 @@ bool Cartridge3E::bank(uInt16 bank)
     for(uInt16 addr = 0x1000; addr < 0x1400; addr += System::PAGE_SIZE)
     {
       access.directPeekBase = &myRAM[offset + (addr & 0x03FF)];
-      access.codeAccessBase = &myCodeAccessBase[mySize + offset + (addr & 0x03FF)];
+      access.codeAccessBase = codeAccess(mySize + offset + (addr & 0x03FF));
       mySystem->setPageAccess(addr, access);
     }
 
@@ -189,7 +193,7 @@ bool Cartridge3E::bank(uInt16 bank)
     // check if RWP happens
     for(uInt16 addr = 0x1400; addr < 0x1800; addr += System::PAGE_SIZE)
     {
-      access.codeAccessBase = &myCodeAccessBase[mySize + offset + (addr & 0x03FF)];
+      access.codeAccessBase = codeAccess(mySize + offset + (addr & 0x03FF));
       mySystem->setPageAccess(addr, access);
     }
   }
@@ -219,6 +223,10 @@ uInt16 Cartridge3E::bankCount() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Cartridge3E::patch(uInt16 address, uInt8 value)
 {
+  // Only a private image can be patched (see Cartridge::enableDebugging)
+  if(myImage.isShared())
+    return false;
+
   address &= 0x0FFF;
 
   if(address < 0x0800)
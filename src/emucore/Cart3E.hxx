@@ -182,7 +182,7 @@ class Cartridge3E : public Cartridge
 
   private:
     // Pointer to a dynamically allocated ROM image of the cartridge
-    ByteBuffer myImage;
+    RomImage myImage;
 
     // RAM contents. For now every ROM gets all 32K of potential RAM
     std::array<uInt8, 32_KB> myRAM;
@@ -16,6 +16,7 @@
 //============================================================================
 
 #include "System.hxx"
+#include "PerfCounters.hxx"
 #include "TIA.hxx"
 #include "Cart3F.hxx"
 
@@ -26,10 +27,11 @@ Cartridge3F::Cartridge3F(const ByteBuffer& image, size_t size,
     mySize(size)
 {
   // Allocate array for the ROM image
-  myImage = make_unique<uInt8[]>(mySize);
+  myImage.allocate(mySize);
 
   // Copy the ROM image into my buffer
   std::copy_n(image.get(), mySize, myImage.get());
+  shareImage(myImage);
   createCodeAccessBase(mySize);
 }
 
@@ -57,7 +59,7 @@ void Cartridge3F::install(System& system)
   for(uInt16 addr = 0x1800; addr < 0x2000; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myImage[(mySize - 2048) + (addr & 0x07FF)];
-    access.codeAccessBase = &myCodeAccessBase[(mySize - 2048) + (addr & 0x07FF)];
+    access.codeAccessBase = codeAccess((mySize - 2048) + (addr & 0x07FF));
     mySystem->setPageAccess(addr, access);
   }
 
@@ -96,6 +98,8 @@ bool Cartridge3F::bank(uInt16 bank)
   if(bankLocked())
     return false;
 
+  PERF_COUNT(bankSwitches, 1);
+
   // Make sure the bank they're asking for is reasonable
   if((uInt32(bank) << 11) < mySize)
   {
@@ -117,7 +121,7 @@ bool Cartridge3F::bank(uInt16 bank)
   for(uInt16 addr = 0x1000; addr < 0x1800; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myImage[offset + (addr & 0x07FF)];
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x07FF)];
+    access.codeAccessBase = codeAccess(offset + (addr & 0x07FF));
     mySystem->setPageAccess(addr, access);
   }
   return myBankChanged = true;
@@ -141,6 +145,10 @@ uInt16 Cartridge3F::bankCount() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Cartridge3F::patch(uInt16 address, uInt8 value)
 {
+  // Only a private image can be patched (see Cartridge::enableDebugging)
+  if(myImage.isShared())
+    return false;
+
   address &= 0x0FFF;
 
   if(address < 0x0800)
@@ -184,6 +184,9 @@ bool Cartridge4A50::poke(uInt16 address, uInt8 value)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8 Cartridge4A50::getAccessFlags(uInt16 address) const
 {
+  if(!myCodeAccessBase)
+    return 0;
+
   if((address & 0x1800) == 0x1000)           // 2K region from 0x1000 - 0x17ff
   {
     if(myIsRomLow)
@@ -216,6 +219,9 @@ uInt8 Cartridge4A50::getAccessFlags(uInt16 address) const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Cartridge4A50::setAccessFlags(uInt16 address, uInt8 flags)
 {
+  if(!myCodeAccessBase)
+    return;
+
   if((address & 0x1800) == 0x1000)           // 2K region from 0x1000 - 0x17ff
   {
     if(myIsRomLow)
@@ -46,7 +46,7 @@ void Cartridge4K::install(System& system)
   for(uInt16 addr = 0x1000; addr < 0x2000; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myImage[addr & 0x0FFF];
-    access.codeAccessBase = &myCodeAccessBase[addr & 0x0FFF];
+    access.codeAccessBase = codeAccess(addr & 0x0FFF);
     mySystem->setPageAccess(addr, access);
   }
 }
@@ -49,7 +49,7 @@ void Cartridge4KSC::install(System& system)
   access.type = System::PageAccessType::WRITE;
   for(uInt16 addr = 0x1000; addr < 0x1080; addr += System::PAGE_SIZE)
   {
-    access.codeAccessBase = &myCodeAccessBase[addr & 0x007F];
+    access.codeAccessBase = codeAccess(addr & 0x007F);
     mySystem->setPageAccess(addr, access);
   }
 
@@ -58,7 +58,7 @@ void Cartridge4KSC::install(System& system)
   for(uInt16 addr = 0x1080; addr < 0x1100; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myRAM[addr & 0x007F];
-    access.codeAccessBase = &myCodeAccessBase[0x80 + (addr & 0x007F)];
+    access.codeAccessBase = codeAccess(0x80 + (addr & 0x007F));
     mySystem->setPageAccess(addr, access);
   }
 
@@ -66,7 +66,7 @@ void Cartridge4KSC::install(System& system)
   for(uInt16 addr = 0x1100; addr < 0x2000; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myImage[addr & 0x0FFF];
-    access.codeAccessBase = &myCodeAccessBase[addr & 0x0FFF];
+    access.codeAccessBase = codeAccess(addr & 0x0FFF);
     mySystem->setPageAccess(addr, access);
   }
 }
@@ -17,6 +17,7 @@
 
 #include "M6502.hxx"
 #include "System.hxx"
+#include "PerfCounters.hxx"
 #include "CartAR.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -193,6 +194,9 @@ bool CartridgeAR::poke(uInt16 addr, uInt8)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8 CartridgeAR::getAccessFlags(uInt16 address) const
 {
+  if(!myCodeAccessBase)
+    return 0;
+
   return myCodeAccessBase[(address & 0x07FF) +
            myImageOffset[(address & 0x0800) ? 1 : 0]];
 }
@@ -200,6 +204,9 @@ uInt8 CartridgeAR::getAccessFlags(uInt16 address) const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeAR::setAccessFlags(uInt16 address, uInt8 flags)
 {
+  if(!myCodeAccessBase)
+    return;
+
   myCodeAccessBase[(address & 0x07FF) +
     myImageOffset[(address & 0x0800) ? 1 : 0]] |= flags;
 }
@@ -391,10 +398,12 @@ void CartridgeAR::loadIntoRAM(uInt8 load)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CartridgeAR::bank(uInt16 bank)
 {
-  if(!bankLocked())
-    return bankConfiguration(uInt8(bank));
-  else
+  if(bankLocked())
     return false;
+
+  PERF_COUNT(bankSwitches, 1);
+
+  return bankConfiguration(uInt8(bank));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -15,151 +15,12 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
-#include "System.hxx"
 #include "CartBF.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 CartridgeBF::CartridgeBF(const ByteBuffer& image, size_t size,
                          const string& md5, const Settings& settings)
-  : Cartridge(settings, md5)
+  : CartridgeEnhanced(image, size, md5, settings,
+                      64, 0x0F80, 0, 1)
 {
-  // Copy the ROM image into my buffer
-  std::copy_n(image.get(), std::min(myImage.size(), size), myImage.begin());
-  createCodeAccessBase(myImage.size());
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void CartridgeBF::reset()
-{
-  initializeStartBank(1);
-
-  // Upon reset we switch to the startup bank
-  bank(startBank());
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void CartridgeBF::install(System& system)
-{
-  mySystem = &system;
-
-  // Install pages for the startup bank
-  bank(startBank());
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8 CartridgeBF::peek(uInt16 address)
-{
-  // Due to the way addressing is set up, we will only get here if the
-  // address is in the hotspot range ($1F80 - $1FFF)
-  address &= 0x0FFF;
-
-  // Switch banks if necessary
-  if((address >= 0x0F80) && (address <= 0x0FBF))
-    bank(address - 0x0F80);
-
-  return myImage[myBankOffset + address];
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartridgeBF::poke(uInt16 address, uInt8)
-{
-  // Due to the way addressing is set up, we will only get here if the
-  // address is in the hotspot range ($1F80 - $1FFF)
-  address &= 0x0FFF;
-
-  // Switch banks if necessary
-  if((address >= 0x0F80) && (address <= 0x0FBF))
-    bank(address - 0x0F80);
-
-  return false;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartridgeBF::bank(uInt16 bank)
-{
-  if(bankLocked()) return false;
-
-  // Remember what bank we're in
-  myBankOffset = bank << 12;
-
-  System::PageAccess access(this, System::PageAccessType::READ);
-
-  // Set the page accessing methods for the hot spots
-  for(uInt16 addr = (0x1F80 & ~System::PAGE_MASK); addr < 0x2000;
-      addr += System::PAGE_SIZE)
-  {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
-
-  // Setup the page access methods for the current bank
-  for(uInt16 addr = 0x1000; addr < static_cast<uInt16>(0x1F80U & ~System::PAGE_MASK);
-      addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
-  return myBankChanged = true;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt16 CartridgeBF::getBank(uInt16) const
-{
-  return myBankOffset >> 12;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt16 CartridgeBF::bankCount() const
-{
-  return 64;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartridgeBF::patch(uInt16 address, uInt8 value)
-{
-  myImage[myBankOffset + (address & 0x0FFF)] = value;
-  return myBankChanged = true;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-const uInt8* CartridgeBF::getImage(size_t& size) const
-{
-  size = myImage.size();
-  return myImage.data();
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartridgeBF::save(Serializer& out) const
-{
-  try
-  {
-    out.putInt(myBankOffset);
-  }
-  catch(...)
-  {
-    cerr << "ERROR: CartridgeBF::save" << endl;
-    return false;
-  }
-
-  return true;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartridgeBF::load(Serializer& in)
-{
-  try
-  {
-    myBankOffset = in.getInt();
-  }
-  catch(...)
-  {
-    cerr << "ERROR: CartridgeBF::load" << endl;
-    return false;
-  }
-
-  // Remember what bank we were in
-  bank(myBankOffset >> 12);
-
-  return true;
 }
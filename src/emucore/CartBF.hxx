@@ -21,7 +21,7 @@
 class System;
 
 #include "bspf.hxx"
-#include "Cart.hxx"
+#include "CartEnhanced.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "CartBFWidget.hxx"
 #endif
@@ -33,7 +33,7 @@ class System;
 
   @author  Mike Saarna
 */
-class CartridgeBF : public Cartridge
+class CartridgeBF : public CartridgeEnhanced
 {
   friend class CartridgeBFWidget;
 
@@ -51,71 +51,6 @@ class CartridgeBF : public Cartridge
     virtual ~CartridgeBF() = default;
 
   public:
-    /**
-      Reset device to its power-on state
-    */
-    void reset() override;
-
-    /**
-      Install cartridge in the specified system.  Invoked by the system
-      when the cartridge is attached to it.
-
-      @param system The system the device should install itself in
-    */
-    void install(System& system) override;
-
-    /**
-      Install pages for the specified bank in the system.
-
-      @param bank The bank that should be installed in the system
-    */
-    bool bank(uInt16 bank) override;
-
-    /**
-      Get the current bank.
-
-      @param address The address to use when querying the bank
-    */
-    uInt16 getBank(uInt16 address = 0) const override;
-
-    /**
-      Query the number of banks supported by the cartridge.
-    */
-    uInt16 bankCount() const override;
-
-    /**
-      Patch the cartridge ROM.
-
-      @param address  The ROM address to patch
-      @param value    The value to place into the address
-      @return    Success or failure of the patch operation
-    */
-    bool patch(uInt16 address, uInt8 value) override;
-
-    /**
-      Access the internal ROM image for this cartridge.
-
-      @param size  Set to the size of the internal ROM image data
-      @return  A pointer to the internal ROM image data
-    */
-    const uInt8* getImage(size_t& size) const override;
-
-    /**
-      Save the current state of this cart to the given Serializer.
-
-      @param out  The Serializer object to use
-      @return  False on any errors, else true
-    */
-    bool save(Serializer& out) const override;
-
-    /**
-      Load the current state of this cart from the given Serializer.
-
-      @param in  The Serializer object to use
-      @return  False on any errors, else true
-    */
-    bool load(Serializer& in) override;
-
     /**
       Get a descriptor for the device name (used in error checking).
 
@@ -135,30 +70,6 @@ class CartridgeBF : public Cartridge
     }
   #endif
 
-  public:
-    /**
-      Get the byte at the specified address.
-
-      @return The byte at the specified address
-    */
-    uInt8 peek(uInt16 address) override;
-
-    /**
-      Change the byte at the specified address to the given value
-
-      @param address The address where the value should be stored
-      @param value The value to be stored at the address
-      @return  True if the poke changed the device address space, else false
-    */
-    bool poke(uInt16 address, uInt8 value) override;
-
-  private:
-    // The 256K ROM image of the cartridge
-    std::array<uInt8, 256_KB> myImage;
-
-    // Indicates the offset into the ROM image (aligns to current bank)
-    uInt32 myBankOffset{0};
-
   private:
     // Following constructors and assignment operators not supported
     CartridgeBF() = delete;
@@ -21,6 +21,7 @@
   #include "Debugger.hxx"
 #endif
 #include "System.hxx"
+#include "PerfCounters.hxx"
 #include "M6532.hxx"
 #include "TIA.hxx"
 #include "Thumbulator.hxx"
@@ -46,14 +47,18 @@ CartridgeBUS::CartridgeBUS(const ByteBuffer& image, size_t size,
   : Cartridge(settings, md5)
 {
   // Copy the ROM image into my buffer
-  std::copy_n(image.get(), std::min(myImage.size(), size), myImage.begin());
+  myImage.allocate(32_KB);
+  std::copy_n(image.get(), std::min(myImage.size(), size), myImage.get());
+
+  // The image is shared with other carts until it is first patched
+  myImage.share();
 
   // Even though the ROM is 32K, only 28K is accessible to the 6507
   createCodeAccessBase(28_KB);
 
   // Pointer to the program ROM (28K @ 0 byte offset)
   // which starts after the 2K BUS Driver and 2K C Code
-  myProgramImage = myImage.data() + 4_KB;
+  myProgramImage = myImage.get() + 4_KB;
 
   // Pointer to BUS driver in RAM
   myBusDriverImage = myBUSRAM.data();
@@ -64,7 +69,7 @@ CartridgeBUS::CartridgeBUS(const ByteBuffer& image, size_t size,
   // Create Thumbulator ARM emulator
   bool devSettings = settings.getBool("dev.settings");
   myThumbEmulator = make_unique<Thumbulator>(
-    reinterpret_cast<uInt16*>(myImage.data()),
+    reinterpret_cast<uInt16*>(myImage.get()),
     reinterpret_cast<uInt16*>(myBUSRAM.data()),
     static_cast<uInt32>(myImage.size()),
     devSettings ? settings.getBool("dev.thumb.trapfatal") : false, Thumbulator::ConfigureFor::BUS, this
@@ -82,8 +87,8 @@ void CartridgeBUS::reset()
   initializeStartBank(6);
 
   // Update cycles to the current system cycles
-  myAudioCycles = myARMCycles = 0;
-  myFractionalClocks = 0.0;
+  myMusic.reset();
+  myARMCycles = 0;
 
   setInitialState();
 
@@ -95,7 +100,7 @@ void CartridgeBUS::reset()
 void CartridgeBUS::setInitialState()
 {
   // Copy initial BUS driver to Harmony RAM
-  std::copy_n(myImage.begin(), 2_KB, myBusDriverImage);
+  std::copy_n(myImage.get(), 2_KB, myBusDriverImage);
 
   myMusicWaveformSize.fill(27);
 
@@ -134,24 +139,6 @@ void CartridgeBUS::install(System& system)
   bank(startBank());
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-inline void CartridgeBUS::updateMusicModeDataFetchers()
-{
-  // Calculate the number of cycles since the last update
-  uInt32 cycles = uInt32(mySystem->cycles() - myAudioCycles);
-  myAudioCycles = mySystem->cycles();
-
-  // Calculate the number of BUS OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
-
-  // Let's update counters and flags of the music mode data fetchers
-  if(wholeClocks > 0)
-    for(int x = 0; x <= 2; ++x)
-      myMusicCounters[x] += myMusicFrequencies[x] * wholeClocks;
-}
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 inline void CartridgeBUS::callFunction(uInt8 value)
 {
@@ -243,12 +230,12 @@ uInt8 CartridgeBUS::peek(uInt16 address)
     {
       case 0xFEE: // AMPLITUDE
         // Update the music data fetchers (counter & flag)
-        updateMusicModeDataFetchers();
+        myMusic.update(mySystem->cycles());
 
         if DIGITAL_AUDIO_ON
         {
           // retrieve packed sample (max size is 2K, or 4K of unpacked data)
-          uInt32 sampleaddress = getSample() + (myMusicCounters[0] >> 21);
+          uInt32 sampleaddress = getSample() + (myMusic.counter(0) >> 21);
 
           // get sample value from ROM or RAM
           if (sampleaddress < 0x8000)
@@ -259,7 +246,7 @@ uInt8 CartridgeBUS::peek(uInt16 address)
             peekvalue = 0;
 
           // make sure current volume value is in the lower nybble
-          if ((myMusicCounters[0] & (1<<20)) == 0)
+          if ((myMusic.counter(0) & (1<<20)) == 0)
             peekvalue >>= 4;
           peekvalue &= 0x0f;
         }
@@ -267,9 +254,9 @@ uInt8 CartridgeBUS::peek(uInt16 address)
         {
           // using myDisplayImage[] instead of myProgramImage[] because waveforms
           // can be modified during runtime.
-          uInt32 i = myDisplayImage[(getWaveform(0) ) + (myMusicCounters[0] >> myMusicWaveformSize[0])] +
-                     myDisplayImage[(getWaveform(1) ) + (myMusicCounters[1] >> myMusicWaveformSize[1])] +
-                     myDisplayImage[(getWaveform(2) ) + (myMusicCounters[2] >> myMusicWaveformSize[2])];
+          uInt32 i = myDisplayImage[(getWaveform(0) ) + (myMusic.counter(0) >> myMusicWaveformSize[0])] +
+                     myDisplayImage[(getWaveform(1) ) + (myMusic.counter(1) >> myMusicWaveformSize[1])] +
+                     myDisplayImage[(getWaveform(2) ) + (myMusic.counter(2) >> myMusicWaveformSize[2])];
 
           peekvalue = uInt8(i);
         }
@@ -433,6 +420,8 @@ bool CartridgeBUS::bank(uInt16 bank)
 {
   if(bankLocked()) return false;
 
+  PERF_COUNT(bankSwitches, 1);
+
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
@@ -442,7 +431,7 @@ bool CartridgeBUS::bank(uInt16 bank)
   // Map Program ROM image into the system
   for(uInt16 addr = 0x1040; addr < 0x2000; addr += System::PAGE_SIZE)
   {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
+    access.codeAccessBase = codeAccess(myBankOffset + (addr & 0x0FFF));
     mySystem->setPageAccess(addr, access);
   }
   return myBankChanged = true;
@@ -468,6 +457,11 @@ bool CartridgeBUS::patch(uInt16 address, uInt8 value)
   // For now, we ignore attempts to patch the BUS address space
   if(address >= 0x0040)
   {
+    if(myImage.unshare())
+    {
+      myProgramImage = myImage.get() + 4_KB;
+      myThumbEmulator->setRom(reinterpret_cast<uInt16*>(myImage.get()));
+    }
     myProgramImage[myBankOffset + (address & 0x0FFF)] = value;
     return myBankChanged = true;
   }
@@ -479,7 +473,7 @@ bool CartridgeBUS::patch(uInt16 address, uInt8 value)
 const uInt8* CartridgeBUS::getImage(size_t& size) const
 {
   size = myImage.size();
-  return myImage.data();
+  return myImage.get();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -516,18 +510,18 @@ uInt32 CartridgeBUS::thumbCallback(uInt8 function, uInt32 value1, uInt32 value2)
   {
     case 0:
       // _SetNote - set the note/frequency
-      myMusicFrequencies[value1] = value2;
+      myMusic.frequency(value1) = value2;
       break;
 
       // _ResetWave - reset counter,
       // used to make sure digital samples start from the beginning
     case 1:
-      myMusicCounters[value1] = 0;
+      myMusic.counter(value1) = 0;
       break;
 
       // _GetWavePtr - return the counter
     case 2:
-      return myMusicCounters[value1];
+      return myMusic.counter(value1);
 
       // _SetWaveSize - set size of waveform buffer
     case 3:
@@ -558,13 +552,13 @@ bool CartridgeBUS::save(Serializer& out) const
     out.putShort(myJMPoperandAddress);
 
     // Save cycles and clocks
-    out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    out.putLong(myMusic.lastCycles());
+    out.putDouble(myMusic.fractionalClocks());
     out.putLong(myARMCycles);
 
     // Audio info
-    out.putIntArray(myMusicCounters.data(), myMusicCounters.size());
-    out.putIntArray(myMusicFrequencies.data(), myMusicFrequencies.size());
+    out.putIntArray(myMusic.counters().data(), myMusic.counters().size());
+    out.putIntArray(myMusic.frequencies().data(), myMusic.frequencies().size());
     out.putByteArray(myMusicWaveformSize.data(), myMusicWaveformSize.size());
 
     // Indicates current mode
@@ -599,13 +593,13 @@ bool CartridgeBUS::load(Serializer& in)
     myJMPoperandAddress = in.getShort();
 
     // Get system cycles and fractional clocks
-    myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    myMusic.setLastCycles(in.getLong());
+    myMusic.setFractionalClocks(in.getDouble());
     myARMCycles = in.getLong();
 
     // Audio info
-    in.getIntArray(myMusicCounters.data(), myMusicCounters.size());
-    in.getIntArray(myMusicFrequencies.data(), myMusicFrequencies.size());
+    in.getIntArray(myMusic.counters().data(), myMusic.counters().size());
+    in.getIntArray(myMusic.frequencies().data(), myMusic.frequencies().size());
     in.getByteArray(myMusicWaveformSize.data(), myMusicWaveformSize.size());
 
     // Indicates current mode
@@ -26,6 +26,7 @@ class Thumbulator;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "MusicSynth.hxx"
 
 /**
   Cartridge class used for BUS.
@@ -183,12 +184,6 @@ class CartridgeBUS : public Cartridge
     */
     void setInitialState();
 
-    /**
-      Updates any data fetchers in music mode based on the number of
-      CPU cycles which have passed since the last update.
-    */
-    void updateMusicModeDataFetchers();
-
     /**
       Call Special Functions
     */
@@ -211,7 +206,7 @@ class CartridgeBUS : public Cartridge
 
   private:
     // The 32K ROM image of the cartridge
-    std::array<uInt8, 32_KB> myImage;
+    RomImage myImage;
 
     // Pointer to the 28K program ROM image of the cartridge
     uInt8* myProgramImage{nullptr};
@@ -244,24 +239,16 @@ class CartridgeBUS : public Cartridge
     // *and* the next two bytes in ROM are 00 00
     uInt16 myJMPoperandAddress{0};
 
-    // System cycle count from when the last update to music data fetchers occurred
-    uInt64 myAudioCycles{0};
-
     // ARM cycle count from when the last callFunction() occurred
     uInt64 myARMCycles{0};
 
-    // The music mode counters
-    std::array<uInt32, 3> myMusicCounters{0};
-
-    // The music frequency
-    std::array<uInt32, 3> myMusicFrequencies{0};
+    // The music mode data fetchers (counters and frequencies of the voices,
+    // plus the oscillator that clocks them)
+    MusicSynth myMusic;
 
     // The music waveform sizes
     std::array<uInt8, 3> myMusicWaveformSize{0};
 
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks{0.0};
-
     // Controls mode, lower nybble sets Fast Fetch, upper nybble sets audio
     // -0 = Bus Stuffing ON
     // -F = Bus Stuffing OFF
@@ -23,6 +23,7 @@ class Thumbulator;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "MusicSynth.hxx"
 
 /**
   Cartridge class used for CDF.
@@ -185,12 +186,6 @@ class CartridgeCDF : public Cartridge
     */
     void setInitialState();
 
-    /**
-      Updates any data fetchers in music mode based on the number of
-      CPU cycles which have passed since the last update.
-    */
-    void updateMusicModeDataFetchers();
-
     /**
       Call Special Functions
     */
@@ -211,7 +206,7 @@ class CartridgeCDF : public Cartridge
 
   private:
     // The 32K ROM image of the cartridge
-    std::array<uInt8, 32_KB> myImage;
+    RomImage myImage;
 
     // Pointer to the 28K program ROM image of the cartridge
     uInt8* myProgramImage{nullptr};
@@ -234,9 +229,6 @@ class CartridgeCDF : public Cartridge
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset{0};
 
-    // System cycle count from when the last update to music data fetchers occurred
-    uInt64 myAudioCycles{0};
-
     // ARM cycle count from when the last callFunction() occurred
     uInt64 myARMCycles{0};
 
@@ -256,18 +248,13 @@ class CartridgeCDF : public Cartridge
       r13 = channel2 frequency
       r14 = timer base  */
 
-    // The music counters, ARM FIQ shadow registers r8, r9, r10
-    std::array<uInt32, 3> myMusicCounters{0};
-
-    // The music frequency, ARM FIQ shadow registers r11, r12, r13
-    std::array<uInt32, 3> myMusicFrequencies{0};
+    // The music counters (ARM FIQ shadow registers r8, r9, r10) and
+    // frequencies (r11, r12, r13), plus the oscillator that clocks them
+    MusicSynth myMusic;
 
     // The music waveform sizes
     std::array<uInt8, 3> myMusicWaveformSize{0};
 
-    // Fractional CDF music, OSC clocks unused during the last update
-    double myFractionalClocks{0.0};
-
     // Controls mode, lower nybble sets Fast Fetch, upper nybble sets audio
     // -0 = Fast Fetch ON
     // -F = Fast Fetch OFF
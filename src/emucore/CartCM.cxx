@@ -17,6 +17,7 @@
 
 #include "CompuMate.hxx"
 #include "System.hxx"
+#include "PerfCounters.hxx"
 #include "M6532.hxx"
 #include "CartCM.hxx"
 
@@ -102,6 +103,8 @@ bool CartridgeCM::bank(uInt16 bank)
 {
   if(bankLocked()) return false;
 
+  PERF_COUNT(bankSwitches, 1);
+
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
@@ -119,7 +122,7 @@ bool CartridgeCM::bank(uInt16 bank)
   for(uInt16 addr = 0x1000; addr < 0x1800; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
+    access.codeAccessBase = codeAccess(myBankOffset + (addr & 0x0FFF));
     mySystem->setPageAccess(addr, access);
   }
 
@@ -131,12 +134,12 @@ bool CartridgeCM::bank(uInt16 bank)
     if(mySWCHA & 0x10)
     {
       access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-      access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
+      access.codeAccessBase = codeAccess(myBankOffset + (addr & 0x0FFF));
     }
     else
     {
       access.directPeekBase = &myRAM[addr & 0x7FF];
-      access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x07FF)];
+      access.codeAccessBase = codeAccess(myBankOffset + (addr & 0x07FF));
     }
 
     if((mySWCHA & 0x30) == 0x20)
@@ -18,6 +18,7 @@
 #include "OSystem.hxx"
 #include "Serializer.hxx"
 #include "System.hxx"
+#include "PerfCounters.hxx"
 #include "TimerManager.hxx"
 #include "CartCTY.hxx"
 
@@ -39,9 +40,6 @@ CartridgeCTY::CartridgeCTY(const ByteBuffer& image, size_t size,
 
   // Point to the first tune
   myFrequencyImage = myTuneData.data();
-
-  myMusicCounters.fill(0);
-  myMusicFrequencies.fill(0);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -56,8 +54,7 @@ void CartridgeCTY::reset()
   myRandomNumber = 0x2B435044;
   myRamAccessTimeout = 0;
 
-  myAudioCycles = 0;
-  myFractionalClocks = 0.0;
+  myMusic.reset();
 
   // Upon reset we switch to the startup bank
   bank(startBank());
@@ -95,7 +92,7 @@ uInt8 CartridgeCTY::peek(uInt16 address)
     myLDAimmediate = false;
 
     // Update the music data fetchers (counter & flag)
-    updateMusicModeDataFetchers();
+    myMusic.update(mySystem->cycles());
 
     uInt8 i = 0;
 
@@ -107,9 +104,9 @@ uInt8 CartridgeCTY::peek(uInt16 address)
      lsl     r2, r2, #2
     */
 
-    i = myMusicCounters[0] >> 31;
-    i = i + (myMusicCounters[1] >> 31);
-    i = i + (myMusicCounters[2] >> 31);
+    i = myMusic.counter(0) >> 31;
+    i = i + (myMusic.counter(1) >> 31);
+    i = i + (myMusic.counter(2) >> 31);
     i <<= 2;
 
     return i;
@@ -188,12 +185,12 @@ bool CartridgeCTY::poke(uInt16 address, uInt8 value)
         break;
       case 0x02:  // Reset fetcher to beginning of tune
         myTunePosition = 0;
-        myMusicCounters[0] = 0;
-        myMusicCounters[1] = 0;
-        myMusicCounters[2] = 0;
-        myMusicFrequencies[0] = 0;
-        myMusicFrequencies[1] = 0;
-        myMusicFrequencies[2] = 0;
+        myMusic.counter(0) = 0;
+        myMusic.counter(1) = 0;
+        myMusic.counter(2) = 0;
+        myMusic.frequency(0) = 0;
+        myMusic.frequency(1) = 0;
+        myMusic.frequency(2) = 0;
         break;
       case 0x03:  // Advance fetcher to next tune position
         updateTune();
@@ -233,6 +230,8 @@ bool CartridgeCTY::bank(uInt16 bank)
 {
   if(bankLocked()) return false;
 
+  PERF_COUNT(bankSwitches, 1);
+
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
@@ -240,7 +239,7 @@ bool CartridgeCTY::bank(uInt16 bank)
   System::PageAccess access(this, System::PageAccessType::READ);
   for(uInt16 addr = 0x1080; addr < 0x2000; addr += System::PAGE_SIZE)
   {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
+    access.codeAccessBase = codeAccess(myBankOffset + (addr & 0x0FFF));
     mySystem->setPageAccess(addr, access);
   }
   return myBankChanged = true;
@@ -295,10 +294,10 @@ bool CartridgeCTY::save(Serializer& out) const
     out.putShort(myTunePosition);
     out.putBool(myLDAimmediate);
     out.putInt(myRandomNumber);
-    out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
-    out.putIntArray(myMusicCounters.data(), myMusicCounters.size());
-    out.putIntArray(myMusicFrequencies.data(), myMusicFrequencies.size());
+    out.putLong(myMusic.lastCycles());
+    out.putDouble(myMusic.fractionalClocks());
+    out.putIntArray(myMusic.counters().data(), myMusic.counters().size());
+    out.putIntArray(myMusic.frequencies().data(), myMusic.frequencies().size());
     out.putLong(myFrequencyImage - myTuneData.data()); // FIXME - storing pointer diff!
   }
   catch(...)
@@ -323,10 +322,10 @@ bool CartridgeCTY::load(Serializer& in)
     myTunePosition = in.getShort();
     myLDAimmediate = in.getBool();
     myRandomNumber = in.getInt();
-    myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
-    in.getIntArray(myMusicCounters.data(), myMusicCounters.size());
-    in.getIntArray(myMusicFrequencies.data(), myMusicFrequencies.size());
+    myMusic.setLastCycles(in.getLong());
+    myMusic.setFractionalClocks(in.getDouble());
+    in.getIntArray(myMusic.counters().data(), myMusic.counters().size());
+    in.getIntArray(myMusic.frequencies().data(), myMusic.frequencies().size());
     myFrequencyImage = myTuneData.data() + in.getLong();
   }
   catch(...)
@@ -474,17 +473,17 @@ void CartridgeCTY::updateTune()
 
   uInt8 note = myFrequencyImage[songPosition + 0];
   if (note)
-    myMusicFrequencies[0] = ourFrequencyTable[note];
+    myMusic.frequency(0) = ourFrequencyTable[note];
 
   note = myFrequencyImage[songPosition + 1];
   if (note)
-    myMusicFrequencies[1] = ourFrequencyTable[note];
+    myMusic.frequency(1) = ourFrequencyTable[note];
 
   note = myFrequencyImage[songPosition + 2];
   if (note == 1)
     myTunePosition = 0;
   else
-    myMusicFrequencies[2] = ourFrequencyTable[note];
+    myMusic.frequency(2) = ourFrequencyTable[note];
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -562,24 +561,6 @@ void CartridgeCTY::wipeAllScores()
   }
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-inline void CartridgeCTY::updateMusicModeDataFetchers()
-{
-  // Calculate the number of cycles since the last update
-  uInt32 cycles = uInt32(mySystem->cycles() - myAudioCycles);
-  myAudioCycles = mySystem->cycles();
-
-  // Calculate the number of CTY OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
-
-  // Let's update counters and flags of the music mode data fetchers
-  if(wholeClocks > 0)
-    for(int x = 0; x <= 2; ++x)
-      myMusicCounters[x] += myMusicFrequencies[x] * wholeClocks;
-}
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const std::array<uInt32, 63> CartridgeCTY::ourFrequencyTable =
 {
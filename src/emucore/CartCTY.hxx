@@ -22,6 +22,7 @@ class System;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "MusicSynth.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "CartCTYWidget.hxx"
 #endif
@@ -250,12 +251,6 @@ class CartridgeCTY : public Cartridge
     void saveScore(uInt8 index);
     void wipeAllScores();
 
-    /**
-      Updates any data fetchers in music mode based on the number of
-      CPU cycles which have passed since the last update.
-    */
-    void updateMusicModeDataFetchers();
-
     void updateTune();
 
   private:
@@ -278,11 +273,9 @@ class CartridgeCTY : public Cartridge
     // The counter register for the data fetcher
     uInt16 myTunePosition{0};
 
-    // The music mode counters
-    std::array<uInt32, 3> myMusicCounters{0};
-
-    // The music frequency
-    std::array<uInt32, 3> myMusicFrequencies{0};
+    // The music mode data fetchers (counters and frequencies of the voices,
+    // plus the oscillator that clocks them)
+    MusicSynth myMusic;
 
     // Flags that last byte peeked was A9 (LDA #)
     bool myLDAimmediate{false};
@@ -300,12 +293,6 @@ class CartridgeCTY : public Cartridge
     // of internal RAM to Harmony cart EEPROM
     string myEEPROMFile;
 
-    // System cycle count from when the last update to music data fetchers occurred
-    uInt64 myAudioCycles{0};
-
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks{0.0};
-
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset{0};
 
@@ -68,7 +68,7 @@ void CartridgeCV::install(System& system)
   for(uInt16 addr = 0x1800; addr < 0x2000; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myImage[addr & 0x07FF];
-    access.codeAccessBase = &myCodeAccessBase[addr & 0x07FF];
+    access.codeAccessBase = codeAccess(addr & 0x07FF);
     mySystem->setPageAccess(addr, access);
   }
 
@@ -87,7 +87,7 @@ void CartridgeCV::install(System& system)
   for(uInt16 addr = 0x1000; addr < 0x1400; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myRAM[addr & 0x03FF];
-    access.codeAccessBase = &myCodeAccessBase[2048 + (addr & 0x03FF)];
+    access.codeAccessBase = codeAccess(2048 + (addr & 0x03FF));
     mySystem->setPageAccess(addr, access);
   }
 }
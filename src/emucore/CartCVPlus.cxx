@@ -16,6 +16,7 @@
 //============================================================================
 
 #include "System.hxx"
+#include "PerfCounters.hxx"
 #include "TIA.hxx"
 #include "CartCVPlus.hxx"
 
@@ -26,10 +27,11 @@ CartridgeCVPlus::CartridgeCVPlus(const ByteBuffer& image, size_t size,
     mySize(size)
 {
   // Allocate array for the ROM image
-  myImage = make_unique<uInt8[]>(mySize);
+  myImage.allocate(mySize);
 
   // Copy the ROM image into my buffer
   std::copy_n(image.get(), mySize, myImage.get());
+  shareImage(myImage);
   createCodeAccessBase(mySize + myRAM.size());
 }
 
@@ -62,7 +64,7 @@ void CartridgeCVPlus::install(System& system)
   access.type = System::PageAccessType::WRITE;
   for(uInt16 addr = 0x1400; addr < 0x1800; addr += System::PAGE_SIZE)
   {
-    access.codeAccessBase = &myCodeAccessBase[mySize + (addr & 0x03FF)];
+    access.codeAccessBase = codeAccess(mySize + (addr & 0x03FF));
     mySystem->setPageAccess(addr, access);
   }
 
@@ -71,7 +73,7 @@ void CartridgeCVPlus::install(System& system)
   for(uInt16 addr = 0x1000; addr < 0x1400; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myRAM[addr & 0x03FF];
-    access.codeAccessBase = &myCodeAccessBase[mySize + (addr & 0x03FF)];
+    access.codeAccessBase = codeAccess(mySize + (addr & 0x03FF));
     mySystem->setPageAccess(addr, access);
   }
 
@@ -127,6 +129,8 @@ bool CartridgeCVPlus::bank(uInt16 bank)
 {
   if(bankLocked()) return false;
 
+  PERF_COUNT(bankSwitches, 1);
+
   // Make sure the bank they're asking for is reasonable
   if((uInt32(bank) << 11) < mySize)
   {
@@ -148,7 +152,7 @@ bool CartridgeCVPlus::bank(uInt16 bank)
   for(uInt16 addr = 0x1800; addr < 0x2000; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myImage[offset + (addr & 0x07FF)];
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x07FF)];
+    access.codeAccessBase = codeAccess(offset + (addr & 0x07FF));
     mySystem->setPageAccess(addr, access);
   }
 
@@ -170,6 +174,10 @@ uInt16 CartridgeCVPlus::bankCount() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CartridgeCVPlus::patch(uInt16 address, uInt8 value)
 {
+  // Only a private image can be patched (see Cartridge::enableDebugging)
+  if(myImage.isShared())
+    return false;
+
   address &= 0x0FFF;
 
   if(address < 0x0800)
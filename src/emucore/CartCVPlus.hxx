@@ -165,7 +165,7 @@ class CartridgeCVPlus : public Cartridge
 
   private:
     // Pointer to a dynamically allocated ROM image of the cartridge
-    ByteBuffer myImage;
+    RomImage myImage;
 
     // The 1024 bytes of RAM
     std::array<uInt8, 1_KB> myRAM;
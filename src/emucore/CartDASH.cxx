@@ -26,10 +26,11 @@ CartridgeDASH::CartridgeDASH(const ByteBuffer& image, size_t size,
     mySize(size)
 {
   // Allocate array for the ROM image
-  myImage = make_unique<uInt8[]>(mySize);
+  myImage.allocate(mySize);
 
   // Copy the ROM image into my buffer
   std::copy_n(image.get(), mySize, myImage.get());
+  shareImage(myImage);
   createCodeAccessBase(mySize + myRAM.size());
 }
 
@@ -204,7 +205,7 @@ void CartridgeDASH::bankRAMSlot(uInt16 bank)
     if(!upper)
       access.directPeekBase = &myRAM[startCurrentBank + (addr & (RAM_BANK_SIZE - 1))];
 
-    access.codeAccessBase = &myCodeAccessBase[mySize + startCurrentBank + (addr & (RAM_BANK_SIZE - 1))];
+    access.codeAccessBase = codeAccess(mySize + startCurrentBank + (addr & (RAM_BANK_SIZE - 1)));
     mySystem->setPageAccess(addr, access);
   }
 }
@@ -247,7 +248,7 @@ void CartridgeDASH::bankROMSlot(uInt16 bank)
   for (uInt16 addr = start; addr <= end; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myImage[startCurrentBank + (addr & (ROM_BANK_SIZE - 1))];
-    access.codeAccessBase = &myCodeAccessBase[startCurrentBank + (addr & (ROM_BANK_SIZE - 1))];
+    access.codeAccessBase = codeAccess(startCurrentBank + (addr & (ROM_BANK_SIZE - 1)));
     mySystem->setPageAccess(addr, access);
   }
 }
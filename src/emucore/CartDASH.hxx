@@ -261,7 +261,7 @@ class CartridgeDASH: public Cartridge
 
     static constexpr uInt16 RAM_WRITE_OFFSET = 0x800;
 
-    ByteBuffer myImage;  // Pointer to a dynamically allocated ROM image of the cartridge
+    RomImage myImage;   // The (possibly shared) ROM image of the cartridge
     size_t mySize{0};    // Size of the ROM image
     std::array<uInt8, RAM_TOTAL_SIZE> myRAM;
 
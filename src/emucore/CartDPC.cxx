@@ -16,6 +16,7 @@
 //============================================================================
 
 #include "System.hxx"
+#include "PerfCounters.hxx"
 #include "AudioSettings.hxx"
 #include "CartDPC.hxx"
 
@@ -39,14 +40,13 @@ CartridgeDPC::CartridgeDPC(const ByteBuffer& image, size_t size,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeDPC::reset()
 {
-  myAudioCycles = 0;
-  myFractionalClocks = 0.0;
+  myMusic.reset();
 
   // Upon reset we switch to the startup bank
   initializeStartBank(1);
   bank(startBank());
 
-  myDpcPitch = mySettings.getInt(AudioSettings::SETTING_DPC_PITCH);
+  myMusic.setRate(mySettings.getInt(AudioSettings::SETTING_DPC_PITCH));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -84,16 +84,10 @@ inline void CartridgeDPC::clockRandomNumberGenerator()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 inline void CartridgeDPC::updateMusicModeDataFetchers()
 {
-  // Calculate the number of cycles since the last update
-  uInt32 cycles = uInt32(mySystem->cycles() - myAudioCycles);
-  myAudioCycles = mySystem->cycles();
-
   // Calculate the number of DPC OSC clocks since the last update
-  double clocks = ((myDpcPitch * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  const uInt32 wholeClocks = myMusic.clocks(mySystem->cycles());
 
-  if(wholeClocks <= 0)
+  if(wholeClocks == 0)
     return;
 
   // Let's update counters and flags of the music mode data fetchers
@@ -364,6 +358,8 @@ bool CartridgeDPC::bank(uInt16 bank)
 {
   if(bankLocked()) return false;
 
+  PERF_COUNT(bankSwitches, 1);
+
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
@@ -373,7 +369,7 @@ bool CartridgeDPC::bank(uInt16 bank)
   for(uInt16 addr = (0x1FF8 & ~System::PAGE_MASK); addr < 0x2000;
       addr += System::PAGE_SIZE)
   {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
+    access.codeAccessBase = codeAccess(myBankOffset + (addr & 0x0FFF));
     mySystem->setPageAccess(addr, access);
   }
 
@@ -382,7 +378,7 @@ bool CartridgeDPC::bank(uInt16 bank)
       addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myProgramImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
+    access.codeAccessBase = codeAccess(myBankOffset + (addr & 0x0FFF));
     mySystem->setPageAccess(addr, access);
   }
   return myBankChanged = true;
@@ -449,8 +445,8 @@ bool CartridgeDPC::save(Serializer& out) const
     // The random number generator register
     out.putByte(myRandomNumber);
 
-    out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    out.putLong(myMusic.lastCycles());
+    out.putDouble(myMusic.fractionalClocks());
   }
   catch(...)
   {
@@ -489,8 +485,8 @@ bool CartridgeDPC::load(Serializer& in)
     myRandomNumber = in.getByte();
 
     // Get system cycles and fractional clocks
-    myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    myMusic.setLastCycles(in.getLong());
+    myMusic.setFractionalClocks(in.getDouble());
   }
   catch(...)
   {
@@ -22,6 +22,7 @@ class System;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "MusicSynth.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "CartDPCWidget.hxx"
 #endif
@@ -127,7 +128,7 @@ class CartridgeDPC : public Cartridge
     */
     string name() const override { return "CartridgeDPC"; }
 
-    void setDpcPitch(double pitch) { myDpcPitch = pitch; }
+    void setDpcPitch(double pitch) { myMusic.setRate(pitch); }
 
   #ifdef DEBUGGER_SUPPORT
     /**
@@ -201,18 +202,13 @@ class CartridgeDPC : public Cartridge
     // The random number generator register
     uInt8 myRandomNumber{1};  // DPC's RNG register (must be non-zero)
 
-    // System cycle count from when the last update to music data fetchers occurred
-    uInt64 myAudioCycles{0};
-
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks{0.0};
+    // The oscillator clocking the music mode data fetchers (the DPC
+    // 'voices' are the DF5 - DF7 counters, so only the clock is used)
+    MusicSynth myMusic;
 
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset{0};
 
-    // DPC pitch
-    double myDpcPitch{0.0};
-
   private:
     // Following constructors and assignment operators not supported
     CartridgeDPC() = delete;
@@ -20,6 +20,7 @@
 #endif
 #include "MD5.hxx"
 #include "System.hxx"
+#include "PerfCounters.hxx"
 #include "Thumbulator.hxx"
 #include "CartDPCPlus.hxx"
 #include "TIA.hxx"
@@ -29,17 +30,19 @@
 CartridgeDPCPlus::CartridgeDPCPlus(const ByteBuffer& image, size_t size,
                                    const string& md5, const Settings& settings)
   : Cartridge(settings, md5),
-    mySize(std::min(size, myImage.size()))
+    mySize(std::min<size_t>(size, 32_KB))
 {
   // Image is always 32K, but in the case of ROM > 29K, the image is
   // copied to the end of the buffer
-  if(mySize < myImage.size())
-    myImage.fill(0);
-  std::copy_n(image.get(), size, myImage.begin() + (myImage.size() - mySize));
+  myImage.allocate(32_KB);
+  std::copy_n(image.get(), size, myImage.get() + (myImage.size() - mySize));
   createCodeAccessBase(24_KB);
 
+  // The image is shared with other carts until it is first patched
+  myImage.share();
+
   // Pointer to the program ROM (24K @ 3K offset; ignore first 3K)
-  myProgramImage = myImage.data() + 3_KB;
+  myProgramImage = myImage.get() + 3_KB;
 
   // Pointer to the display RAM
   myDisplayImage = myDPCRAM.data() + 3_KB;
@@ -50,7 +53,7 @@ CartridgeDPCPlus::CartridgeDPCPlus(const ByteBuffer& image, size_t size,
   // Create Thumbulator ARM emulator
   bool devSettings = settings.getBool("dev.settings");
   myThumbEmulator = make_unique<Thumbulator>
-      (reinterpret_cast<uInt16*>(myImage.data()),
+      (reinterpret_cast<uInt16*>(myImage.get()),
        reinterpret_cast<uInt16*>(myDPCRAM.data()),
        static_cast<uInt32>(myImage.size()),
        devSettings ? settings.getBool("dev.thumb.trapfatal") : false,
@@ -112,8 +115,8 @@ void CartridgeDPCPlus::setInitialState()
 
   // Initialize various other parameters
   myFastFetch = myLDAimmediate = false;
-  myAudioCycles = myARMCycles = 0;
-  myFractionalClocks = 0.0;
+  myMusic.reset();
+  myARMCycles = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -153,24 +156,6 @@ inline void CartridgeDPCPlus::priorClockRandomNumberGenerator()
     (myRandomNumber << 11) | (myRandomNumber >> 21));
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-inline void CartridgeDPCPlus::updateMusicModeDataFetchers()
-{
-  // Calculate the number of cycles since the last update
-  uInt32 cycles = uInt32(mySystem->cycles() - myAudioCycles);
-  myAudioCycles = mySystem->cycles();
-
-  // Calculate the number of DPC+ OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
-
-  // Let's update counters and flags of the music mode data fetchers
-  if(wholeClocks > 0)
-    for(int x = 0; x <= 2; ++x)
-      myMusicCounters[x] += myMusicFrequencies[x] * wholeClocks;
-}
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 inline void CartridgeDPCPlus::callFunction(uInt8 value)
 {
@@ -277,13 +262,13 @@ uInt8 CartridgeDPCPlus::peek(uInt16 address)
           case 0x05: // AMPLITUDE
           {
             // Update the music data fetchers (counter & flag)
-            updateMusicModeDataFetchers();
+            myMusic.update(mySystem->cycles());
 
             // using myDisplayImage[] instead of myProgramImage[] because waveforms
             // can be modified during runtime.
-            uInt32 i = myDisplayImage[(myMusicWaveforms[0] << 5) + (myMusicCounters[0] >> 27)] +
-                       myDisplayImage[(myMusicWaveforms[1] << 5) + (myMusicCounters[1] >> 27)] +
-                       myDisplayImage[(myMusicWaveforms[2] << 5) + (myMusicCounters[2] >> 27)];
+            uInt32 i = myDisplayImage[(myMusicWaveforms[0] << 5) + (myMusic.counter(0) >> 27)] +
+                       myDisplayImage[(myMusicWaveforms[1] << 5) + (myMusic.counter(1) >> 27)] +
+                       myDisplayImage[(myMusicWaveforms[2] << 5) + (myMusic.counter(2) >> 27)];
 
             result = uInt8(i);
             break;
@@ -524,7 +509,7 @@ bool CartridgeDPCPlus::poke(uInt16 address, uInt8 value)
           case 0x06:  // NOTE1
           case 0x07:  // NOTE2
           {
-            myMusicFrequencies[index-5] = myFrequencyImage[(value<<2)] +
+            myMusic.frequency(index-5) = myFrequencyImage[(value<<2)] +
             (myFrequencyImage[(value<<2)+1]<<8) +
             (myFrequencyImage[(value<<2)+2]<<16) +
             (myFrequencyImage[(value<<2)+3]<<24);
@@ -595,6 +580,8 @@ bool CartridgeDPCPlus::bank(uInt16 bank)
 {
   if(bankLocked()) return false;
 
+  PERF_COUNT(bankSwitches, 1);
+
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
@@ -604,7 +591,7 @@ bool CartridgeDPCPlus::bank(uInt16 bank)
   // Map Program ROM image into the system
   for(uInt16 addr = 0x1080; addr < 0x2000; addr += System::PAGE_SIZE)
   {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
+    access.codeAccessBase = codeAccess(myBankOffset + (addr & 0x0FFF));
     mySystem->setPageAccess(addr, access);
   }
   return myBankChanged = true;
@@ -630,6 +617,11 @@ bool CartridgeDPCPlus::patch(uInt16 address, uInt8 value)
   // For now, we ignore attempts to patch the DPC address space
   if(address >= 0x0080)
   {
+    if(myImage.unshare())
+    {
+      myProgramImage = myImage.get() + 3_KB;
+      myThumbEmulator->setRom(reinterpret_cast<uInt16*>(myImage.get()));
+    }
     myProgramImage[myBankOffset + (address & 0x0FFF)] = value;
     return myBankChanged = true;
   }
@@ -641,7 +633,7 @@ bool CartridgeDPCPlus::patch(uInt16 address, uInt8 value)
 const uInt8* CartridgeDPCPlus::getImage(size_t& size) const
 {
   size = mySize;
-  return myImage.data() + (myImage.size() - mySize);
+  return myImage.get() + (myImage.size() - mySize);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -678,10 +670,10 @@ bool CartridgeDPCPlus::save(Serializer& out) const
     out.putByteArray(myParameter.data(), myParameter.size());
 
     // The music counters
-    out.putIntArray(myMusicCounters.data(), myMusicCounters.size());
+    out.putIntArray(myMusic.counters().data(), myMusic.counters().size());
 
     // The music frequencies
-    out.putIntArray(myMusicFrequencies.data(), myMusicFrequencies.size());
+    out.putIntArray(myMusic.frequencies().data(), myMusic.frequencies().size());
 
     // The music waveforms
     out.putShortArray(myMusicWaveforms.data(), myMusicWaveforms.size());
@@ -690,8 +682,8 @@ bool CartridgeDPCPlus::save(Serializer& out) const
     out.putInt(myRandomNumber);
 
     // Get system cycles and fractional clocks
-    out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    out.putLong(myMusic.lastCycles());
+    out.putDouble(myMusic.fractionalClocks());
 
     // Clock info for Thumbulator
     out.putLong(myARMCycles);
@@ -739,10 +731,10 @@ bool CartridgeDPCPlus::load(Serializer& in)
     in.getByteArray(myParameter.data(), myParameter.size());
 
     // The music mode counters for the data fetchers
-    in.getIntArray(myMusicCounters.data(), myMusicCounters.size());
+    in.getIntArray(myMusic.counters().data(), myMusic.counters().size());
 
     // The music mode frequency addends for the data fetchers
-    in.getIntArray(myMusicFrequencies.data(), myMusicFrequencies.size());
+    in.getIntArray(myMusic.frequencies().data(), myMusic.frequencies().size());
 
     // The music waveforms
     in.getShortArray(myMusicWaveforms.data(), myMusicWaveforms.size());
@@ -751,8 +743,8 @@ bool CartridgeDPCPlus::load(Serializer& in)
     myRandomNumber = in.getInt();
 
     // Get audio cycles and fractional clocks
-    myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    myMusic.setLastCycles(in.getLong());
+    myMusic.setFractionalClocks(in.getDouble());
 
     // Clock info for Thumbulator
     myARMCycles = in.getLong();
@@ -27,6 +27,7 @@ class System;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "MusicSynth.hxx"
 
 /**
   Cartridge class used for DPC+, derived from Pitfall II.  There are six 4K
@@ -187,12 +188,6 @@ class CartridgeDPCPlus : public Cartridge
     */
     void priorClockRandomNumberGenerator();
 
-    /**
-      Updates any data fetchers in music mode based on the number of
-      CPU cycles which have passed since the last update.
-    */
-    void updateMusicModeDataFetchers();
-
     /**
       Call Special Functions
     */
@@ -200,7 +195,7 @@ class CartridgeDPCPlus : public Cartridge
 
   private:
     // The ROM image and size
-    std::array<uInt8, 32_KB> myImage;
+    RomImage myImage;
     size_t mySize{0};
 
     // Pointer to the 24K program ROM image of the cartridge
@@ -248,11 +243,9 @@ class CartridgeDPCPlus : public Cartridge
     // Parameter pointer for special functions
     uInt8 myParameterPointer{0};
 
-    // The music mode counters
-    std::array<uInt32, 3> myMusicCounters;
-
-    // The music frequency
-    std::array<uInt32, 3> myMusicFrequencies;
+    // The music mode data fetchers (counters and frequencies of the voices,
+    // plus the oscillator that clocks them)
+    MusicSynth myMusic;
 
     // The music waveforms
     std::array<uInt16, 3> myMusicWaveforms;
@@ -260,15 +253,9 @@ class CartridgeDPCPlus : public Cartridge
     // The random number generator register
     uInt32 myRandomNumber{1};
 
-    // System cycle count from when the last update to music data fetchers occurred
-    uInt64 myAudioCycles{0};
-
     // System cycle count when the last Thumbulator::run() occurred
     uInt64 myARMCycles{0};
 
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks{0.0};
-
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset{0};
 
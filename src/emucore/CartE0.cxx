@@ -61,13 +61,13 @@ void CartridgeE0::install(System& system)
       addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myImage[0x1C00 + (addr & 0x03FF)];
-    access.codeAccessBase = &myCodeAccessBase[0x1C00 + (addr & 0x03FF)];
+    access.codeAccessBase = codeAccess(0x1C00 + (addr & 0x03FF));
     mySystem->setPageAccess(addr, access);
   }
 
   // Set the page accessing methods for the hot spots in the last segment
   access.directPeekBase = nullptr;
-  access.codeAccessBase = &myCodeAccessBase[0x1FC0]; // TJ: is this the correct address (or 0x1FE0)?
+  access.codeAccessBase = codeAccess(0x1FC0); // TJ: is this the correct address (or 0x1FE0)?
   access.type = System::PageAccessType::READ;
   for(uInt16 addr = (0x1FE0 & ~System::PAGE_MASK); addr < 0x2000;
       addr += System::PAGE_SIZE)
@@ -144,7 +144,7 @@ void CartridgeE0::segmentZero(uInt16 slice)
   for(uInt16 addr = 0x1000; addr < 0x1400; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myImage[offset + (addr & 0x03FF)];
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x03FF)];
+    access.codeAccessBase = codeAccess(offset + (addr & 0x03FF));
     mySystem->setPageAccess(addr, access);
   }
   myBankChanged = true;
@@ -165,7 +165,7 @@ void CartridgeE0::segmentOne(uInt16 slice)
   for(uInt16 addr = 0x1400; addr < 0x1800; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myImage[offset + (addr & 0x03FF)];
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x03FF)];
+    access.codeAccessBase = codeAccess(offset + (addr & 0x03FF));
     mySystem->setPageAccess(addr, access);
   }
   myBankChanged = true;
@@ -186,7 +186,7 @@ void CartridgeE0::segmentTwo(uInt16 slice)
   for(uInt16 addr = 0x1800; addr < 0x1C00; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myImage[offset + (addr & 0x03FF)];
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x03FF)];
+    access.codeAccessBase = codeAccess(offset + (addr & 0x03FF));
     mySystem->setPageAccess(addr, access);
   }
   myBankChanged = true;
@@ -0,0 +1,257 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "System.hxx"
+#include "PerfCounters.hxx"
+#include "CartEnhanced.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+CartridgeEnhanced::CartridgeEnhanced(const ByteBuffer& image, size_t size,
+                                     const string& md5, const Settings& settings,
+                                     uInt16 bankCount, uInt16 hotspot,
+                                     uInt16 ramSize, uInt16 startBank)
+  : Cartridge(settings, md5),
+    myBankCount(bankCount),
+    myHotspot(hotspot),
+    myRamSize(ramSize),
+    myDefaultStartBank(startBank)
+{
+  const size_t imageSize = size_t(myBankCount) << 12;
+
+  // Copy the ROM image into my buffer
+  myImage.allocate(imageSize);
+  std::copy_n(image.get(), std::min(imageSize, size), myImage.get());
+  shareImage(myImage);
+  createCodeAccessBase(imageSize);
+
+  if(myRamSize > 0)
+    myRAM = make_unique<uInt8[]>(myRamSize);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeEnhanced::reset()
+{
+  if(myRamSize > 0)
+    initializeRAM(myRAM.get(), myRamSize);
+  initializeStartBank(myDefaultStartBank);
+
+  // Upon reset we switch to the startup bank
+  bank(startBank());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeEnhanced::install(System& system)
+{
+  mySystem = &system;
+
+  if(myRamSize > 0)
+  {
+    System::PageAccess access(this, System::PageAccessType::READ);
+    const uInt16 ramMask = myRamSize - 1;
+
+    // Set the page accessing method for the RAM writing pages
+    // Map access to this class, since we need to inspect all accesses to
+    // check if RWP happens
+    access.type = System::PageAccessType::WRITE;
+    for(uInt16 addr = 0x1000; addr < 0x1000 + myRamSize; addr += System::PAGE_SIZE)
+    {
+      access.codeAccessBase = codeAccess(addr & ramMask);
+      mySystem->setPageAccess(addr, access);
+    }
+
+    // Set the page accessing method for the RAM reading pages
+    access.type = System::PageAccessType::READ;
+    for(uInt16 addr = 0x1000 + myRamSize; addr < 0x1000 + 2 * myRamSize;
+        addr += System::PAGE_SIZE)
+    {
+      access.directPeekBase = &myRAM[addr & ramMask];
+      access.codeAccessBase = codeAccess(myRamSize + (addr & ramMask));
+      mySystem->setPageAccess(addr, access);
+    }
+  }
+
+  // Precompute the pages of each bank, starting above the RAM ports
+  // The pages containing hotspots must be accessed through this class
+  // This is done here rather than in the c'tor, since enabling debugging
+  // moves the image and creates the code-access array
+  const uInt16 romStart = 0x1000 + 2 * myRamSize;
+  const uInt16 hotspotStart = (0x1000 + myHotspot) & ~System::PAGE_MASK;
+
+  myBankPageCount = (0x2000 - romStart) >> System::PAGE_SHIFT;
+  myBankPages.clear();
+  myBankPages.reserve(myBankCount * myBankPageCount);
+
+  for(uInt16 bank = 0; bank < myBankCount; ++bank)
+  {
+    const uInt32 offset = uInt32(bank) << 12;
+
+    for(uInt16 addr = romStart; addr < 0x2000; addr += System::PAGE_SIZE)
+    {
+      System::PageAccess access(this, System::PageAccessType::READ);
+
+      if(addr < hotspotStart)
+        access.directPeekBase = &myImage[offset + (addr & 0x0FFF)];
+      access.codeAccessBase = codeAccess(offset + (addr & 0x0FFF));
+      myBankPages.push_back(access);
+    }
+  }
+
+  // Install pages for the startup bank
+  bank(startBank());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt8 CartridgeEnhanced::peek(uInt16 address)
+{
+  uInt16 peekAddress = address;
+  address &= 0x0FFF;
+
+  // Switch banks if necessary
+  if(isHotspot(address))
+    bank(address - myHotspot);
+
+  if(address < myRamSize)  // Write port is at the start of the cart space
+    return peekRAM(myRAM[address], peekAddress);
+  else
+    return myImage[myBankOffset + address];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CartridgeEnhanced::poke(uInt16 address, uInt8 value)
+{
+  // Switch banks if necessary
+  if(isHotspot(address & 0x0FFF))
+  {
+    bank((address & 0x0FFF) - myHotspot);
+    return false;
+  }
+
+  if(myRamSize == 0)
+    return false;
+
+  if(!(address & myRamSize))
+  {
+    pokeRAM(myRAM[address & (myRamSize - 1)], address, value);
+    return true;
+  }
+  else
+  {
+    // Writing to the read port should be ignored, but trigger a break if option enabled
+    uInt8 dummy;
+
+    pokeRAM(dummy, address, value);
+    myRamWriteAccess = address;
+    return false;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CartridgeEnhanced::bank(uInt16 bank)
+{
+  if(bankLocked() || bank >= myBankCount) return false;
+
+  PERF_COUNT(bankSwitches, 1);
+
+  // Remember what bank we're in
+  myBankOffset = bank << 12;
+
+  // Install the precomputed pages of the bank; the RAM pages never change
+  mySystem->setPageAccess(0x1000 + 2 * myRamSize,
+                          &myBankPages[bank * myBankPageCount], myBankPageCount);
+
+  return myBankChanged = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt16 CartridgeEnhanced::getBank(uInt16) const
+{
+  return myBankOffset >> 12;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt16 CartridgeEnhanced::bankCount() const
+{
+  return myBankCount;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CartridgeEnhanced::patch(uInt16 address, uInt8 value)
+{
+  // Only a private image can be patched (see Cartridge::enableDebugging)
+  if(myImage.isShared())
+    return false;
+
+  address &= 0x0FFF;
+
+  if(address < 2 * myRamSize)
+  {
+    // Normally, a write to the read port won't do anything
+    // However, the patch command is special in that ignores such
+    // cart restrictions
+    myRAM[address & (myRamSize - 1)] = value;
+  }
+  else
+    myImage[myBankOffset + address] = value;
+
+  return myBankChanged = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uInt8* CartridgeEnhanced::getImage(size_t& size) const
+{
+  size = size_t(myBankCount) << 12;
+  return myImage.get();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CartridgeEnhanced::save(Serializer& out) const
+{
+  try
+  {
+    out.putShort(myBankOffset);
+    if(myRamSize > 0)
+      out.putByteArray(myRAM.get(), myRamSize);
+  }
+  catch(...)
+  {
+    cerr << "ERROR: " << name() << "::save" << endl;
+    return false;
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CartridgeEnhanced::load(Serializer& in)
+{
+  try
+  {
+    myBankOffset = in.getShort();
+    if(myRamSize > 0)
+      in.getByteArray(myRAM.get(), myRamSize);
+  }
+  catch(...)
+  {
+    cerr << "ERROR: " << name() << "::load" << endl;
+    return false;
+  }
+
+  // Remember what bank we were in
+  bank(myBankOffset >> 12);
+
+  return true;
+}
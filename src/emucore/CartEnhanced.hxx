@@ -0,0 +1,178 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef CARTRIDGE_ENHANCED_HXX
+#define CARTRIDGE_ENHANCED_HXX
+
+class System;
+
+#include "bspf.hxx"
+#include "Cart.hxx"
+#include "System.hxx"
+
+/**
+  Common base for the many schemes that switch whole 4K banks by accessing
+  a range of consecutive hotspots at the top of the cartridge space, with
+  optional Superchip-style RAM at the bottom.  The write port of the RAM
+  comes first, followed by the read port of the same size.
+
+  Bank 'n' is selected by accessing hotspot + n.  Because switching happens
+  often (sometimes several times per scanline), the pages of each bank are
+  precomputed when the cart is installed; a bankswitch then copies these pages
+  into the system in one go.
+*/
+class CartridgeEnhanced : public Cartridge
+{
+  public:
+    /**
+      Create a new cartridge using the specified image
+
+      @param image      Pointer to the ROM image
+      @param size       The size of the ROM image
+      @param md5        The md5sum of the ROM image
+      @param settings   A reference to the various settings (read-only)
+      @param bankCount  The number of 4K banks
+      @param hotspot    The address (& 0x0FFF) that selects the first bank
+      @param ramSize    The size of the RAM (0 if there is none)
+      @param startBank  The default bank to use during reset
+    */
+    CartridgeEnhanced(const ByteBuffer& image, size_t size, const string& md5,
+                      const Settings& settings, uInt16 bankCount,
+                      uInt16 hotspot, uInt16 ramSize, uInt16 startBank);
+    virtual ~CartridgeEnhanced() = default;
+
+  public:
+    /**
+      Reset device to its power-on state
+    */
+    void reset() override;
+
+    /**
+      Install cartridge in the specified system.  Invoked by the system
+      when the cartridge is attached to it.
+
+      @param system The system the device should install itself in
+    */
+    void install(System& system) override;
+
+    /**
+      Install pages for the specified bank in the system.
+
+      @param bank The bank that should be installed in the system
+    */
+    bool bank(uInt16 bank) override;
+
+    /**
+      Get the current bank.
+
+      @param address The address to use when querying the bank
+    */
+    uInt16 getBank(uInt16 address = 0) const override;
+
+    /**
+      Query the number of banks supported by the cartridge.
+    */
+    uInt16 bankCount() const override;
+
+    /**
+      Patch the cartridge ROM.
+
+      @param address  The ROM address to patch
+      @param value    The value to place into the address
+      @return    Success or failure of the patch operation
+    */
+    bool patch(uInt16 address, uInt8 value) override;
+
+    /**
+      Access the internal ROM image for this cartridge.
+
+      @param size  Set to the size of the internal ROM image data
+      @return  A pointer to the internal ROM image data
+    */
+    const uInt8* getImage(size_t& size) const override;
+
+    /**
+      Save the current state of this cart to the given Serializer.
+
+      @param out  The Serializer object to use
+      @return  False on any errors, else true
+    */
+    bool save(Serializer& out) const override;
+
+    /**
+      Load the current state of this cart from the given Serializer.
+
+      @param in  The Serializer object to use
+      @return  False on any errors, else true
+    */
+    bool load(Serializer& in) override;
+
+  public:
+    /**
+      Get the byte at the specified address.
+
+      @return The byte at the specified address
+    */
+    uInt8 peek(uInt16 address) override;
+
+    /**
+      Change the byte at the specified address to the given value
+
+      @param address The address where the value should be stored
+      @param value The value to be stored at the address
+      @return  True if the poke changed the device address space, else false
+    */
+    bool poke(uInt16 address, uInt8 value) override;
+
+  private:
+    /**
+      Answer whether the given address (& 0x0FFF) is a hotspot.
+    */
+    bool isHotspot(uInt16 address) const {
+      return uInt16(address - myHotspot) < myBankCount;
+    }
+
+  protected:
+    // The ROM image of the cartridge
+    RomImage myImage;
+
+    // The RAM (if any)
+    ByteBuffer myRAM;
+
+    // Indicates the offset into the ROM image (aligns to current bank)
+    uInt16 myBankOffset{0};
+
+  private:
+    const uInt16 myBankCount{0};
+    const uInt16 myHotspot{0};
+    const uInt16 myRamSize{0};
+    const uInt16 myDefaultStartBank{0};
+
+    // The pages of all banks, above the RAM ports; myBankPageCount per bank
+    vector<System::PageAccess> myBankPages;
+    uInt16 myBankPageCount{0};
+
+  private:
+    // Following constructors and assignment operators not supported
+    CartridgeEnhanced() = delete;
+    CartridgeEnhanced(const CartridgeEnhanced&) = delete;
+    CartridgeEnhanced(CartridgeEnhanced&&) = delete;
+    CartridgeEnhanced& operator=(const CartridgeEnhanced&) = delete;
+    CartridgeEnhanced& operator=(CartridgeEnhanced&&) = delete;
+};
+
+#endif
@@ -18,6 +18,7 @@
 #include "OSystem.hxx"
 #include "Serializer.hxx"
 #include "System.hxx"
+#include "PerfCounters.hxx"
 #include "TimerManager.hxx"
 #include "CartFA2.hxx"
 
@@ -61,7 +62,7 @@ void CartridgeFA2::install(System& system)
   access.type = System::PageAccessType::WRITE;
   for(uInt16 addr = 0x1000; addr < 0x1100; addr += System::PAGE_SIZE)
   {
-    access.codeAccessBase = &myCodeAccessBase[addr & 0x00FF];
+    access.codeAccessBase = codeAccess(addr & 0x00FF);
     mySystem->setPageAccess(addr, access);
   }
 
@@ -71,7 +72,7 @@ void CartridgeFA2::install(System& system)
   for(uInt16 addr = 0x1100; addr < 0x1200; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myRAM[addr & 0x00FF];
-    access.codeAccessBase = &myCodeAccessBase[0x100 + (addr & 0x00FF)];
+    access.codeAccessBase = codeAccess(0x100 + (addr & 0x00FF));
     mySystem->setPageAccess(addr, access);
   }
 
@@ -213,6 +214,8 @@ bool CartridgeFA2::bank(uInt16 bank)
 {
   if(bankLocked()) return false;
 
+  PERF_COUNT(bankSwitches, 1);
+
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
@@ -222,7 +225,7 @@ bool CartridgeFA2::bank(uInt16 bank)
   for(uInt16 addr = (0x1FF4 & ~System::PAGE_MASK); addr < 0x2000;
       addr += System::PAGE_SIZE)
   {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
+    access.codeAccessBase = codeAccess(myBankOffset + (addr & 0x0FFF));
     mySystem->setPageAccess(addr, access);
   }
 
@@ -231,7 +234,7 @@ bool CartridgeFA2::bank(uInt16 bank)
       addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
+    access.codeAccessBase = codeAccess(myBankOffset + (addr & 0x0FFF));
     mySystem->setPageAccess(addr, access);
   }
   return myBankChanged = true;
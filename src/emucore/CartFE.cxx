@@ -17,6 +17,7 @@
 
 #include "M6532.hxx"
 #include "System.hxx"
+#include "PerfCounters.hxx"
 #include "CartFE.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -103,6 +104,8 @@ bool CartridgeFE::bank(uInt16 bank)
   if(bankLocked())
     return false;
 
+  PERF_COUNT(bankSwitches, 1);
+
   myBankOffset = bank << 12;
   return myBankChanged = true;
 }
@@ -16,6 +16,7 @@
 //============================================================================
 
 #include "System.hxx"
+#include "PerfCounters.hxx"
 #include "CartMDM.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -25,10 +26,11 @@ CartridgeMDM::CartridgeMDM(const ByteBuffer& image, size_t size,
     mySize(size)
 {
   // Allocate array for the ROM image
-  myImage = make_unique<uInt8[]>(mySize);
+  myImage.allocate(mySize);
 
   // Copy the ROM image into my buffer
   std::copy_n(image.get(), mySize, myImage.get());
+  shareImage(myImage);
   createCodeAccessBase(mySize);
 }
 
@@ -100,6 +102,8 @@ bool CartridgeMDM::bank(uInt16 bank)
 {
   if(bankLocked() || myBankingDisabled) return false;
 
+  PERF_COUNT(bankSwitches, 1);
+
   // Remember what bank we're in
   // Wrap around to a valid bank number if necessary
   myBankOffset = (bank % bankCount()) << 12;
@@ -111,7 +115,7 @@ bool CartridgeMDM::bank(uInt16 bank)
   for(uInt16 addr = 0x1000; addr < 0x2000; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
+    access.codeAccessBase = codeAccess(myBankOffset + (addr & 0x0FFF));
     mySystem->setPageAccess(addr, access);
   }
 
@@ -136,6 +140,10 @@ uInt16 CartridgeMDM::bankCount() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CartridgeMDM::patch(uInt16 address, uInt8 value)
 {
+  // Only a private image can be patched (see Cartridge::enableDebugging)
+  if(myImage.isShared())
+    return false;
+
   myImage[myBankOffset + (address & 0x0FFF)] = value;
   return myBankChanged = true;
 }
@@ -165,7 +165,7 @@ class CartridgeMDM : public Cartridge
 
   private:
     // Pointer to a dynamically allocated ROM image of the cartridge
-    ByteBuffer myImage;
+    RomImage myImage;
 
     // Size of the ROM image
     size_t mySize{0};
@@ -16,6 +16,7 @@
 //============================================================================
 
 #include "System.hxx"
+#include "PerfCounters.hxx"
 #include "CartMNetwork.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -30,10 +31,11 @@ CartridgeMNetwork::CartridgeMNetwork(const ByteBuffer& image, size_t size,
 void CartridgeMNetwork::initialize(const ByteBuffer& image, size_t size)
 {
   // Allocate array for the ROM image
-  myImage = make_unique<uInt8[]>(size);
+  myImage.allocate(size);
 
   // Copy the ROM image into my buffer
   std::copy_n(image.get(), std::min<size_t>(romSize(), size), myImage.get());
+  shareImage(myImage);
   createCodeAccessBase(romSize() + myRAM.size());
 
   myRAMSlice = bankCount() - 1;
@@ -70,7 +72,7 @@ void CartridgeMNetwork::setAccess(uInt16 addrFrom, uInt16 size,
       access.directPeekBase = &directData[directOffset + (addr & addrMask)];
     else if(type == System::PageAccessType::WRITE)  // all RAM writes mapped to ::poke()
       access.directPokeBase = nullptr;
-    access.codeAccessBase = &myCodeAccessBase[codeOffset + (addr & addrMask)];
+    access.codeAccessBase = codeAccess(codeOffset + (addr & addrMask));
     mySystem->setPageAccess(addr, access);
   }
 }
@@ -86,7 +88,7 @@ void CartridgeMNetwork::install(System& system)
   for(uInt16 addr = (0x1FE0 & ~System::PAGE_MASK); addr < 0x2000;
       addr += System::PAGE_SIZE)
   {
-    access.codeAccessBase = &myCodeAccessBase[0x1fc0];
+    access.codeAccessBase = codeAccess(0x1fc0);
     mySystem->setPageAccess(addr, access);
   }
   /*setAccess(0x1FE0 & ~System::PAGE_MASK, System::PAGE_SIZE,
@@ -201,6 +203,8 @@ bool CartridgeMNetwork::bank(uInt16 slice)
 {
   if(bankLocked()) return false;
 
+  PERF_COUNT(bankSwitches, 1);
+
   // Remember what bank we're in
   myCurrentSlice[0] = slice;
 
@@ -231,6 +235,10 @@ uInt16 CartridgeMNetwork::getBank(uInt16 address) const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CartridgeMNetwork::patch(uInt16 address, uInt8 value)
 {
+  // Only a private image can be patched (see Cartridge::enableDebugging)
+  if(myImage.isShared())
+    return false;
+
   address = address & 0x0FFF;
 
   if(address < 0x0800)
@@ -197,7 +197,7 @@ class CartridgeMNetwork : public Cartridge
 
   private:
     // Pointer to a dynamically allocated ROM image of the cartridge
-    ByteBuffer myImage;
+    RomImage myImage;
     // The 16K ROM image of the cartridge (works for E78K too)
     //uInt8 myImage[BANK_SIZE * 8];
 
@@ -154,7 +154,7 @@ class CartridgeSB : public Cartridge
 
   private:
     // The 128-256K ROM image and size of the cartridge
-    ByteBuffer myImage;
+    RomImage myImage;
     size_t mySize{0};
 
     // Indicates the offset into the ROM image (aligns to current bank)
@@ -18,6 +18,7 @@
 #include "TIA.hxx"
 #include "M6502.hxx"
 #include "System.hxx"
+#include "PerfCounters.hxx"
 #include "CartWD.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -63,7 +64,7 @@ void CartridgeWD::install(System& system)
   for(uInt16 addr = 0x1000; addr < 0x1040; addr += System::PAGE_SIZE)
   {
     read.directPeekBase = &myRAM[addr & 0x003F];
-    read.codeAccessBase = &myCodeAccessBase[addr & 0x003F];
+    read.codeAccessBase = codeAccess(addr & 0x003F);
     mySystem->setPageAccess(addr, read);
   }
 
@@ -73,7 +74,7 @@ void CartridgeWD::install(System& system)
   System::PageAccess write(this, System::PageAccessType::WRITE);
   for(uInt16 addr = 0x1040; addr < 0x1080; addr += System::PAGE_SIZE)
   {
-    write.codeAccessBase = &myCodeAccessBase[addr & 0x003F];
+    write.codeAccessBase = codeAccess(addr & 0x003F);
     mySystem->setPageAccess(addr, write);
   }
 
@@ -158,6 +159,8 @@ bool CartridgeWD::bank(uInt16 bank)
 {
   if(bankLocked() || bank > 15) return false;
 
+  PERF_COUNT(bankSwitches, 1);
+
   myCurrentBank = bank;
 
   segmentZero(ourBankOrg[bank & 0x7].zero);
@@ -177,7 +180,7 @@ void CartridgeWD::segmentZero(uInt8 slice)
   // Skip first 128 bytes; it is always RAM
   for(uInt16 addr = 0x1080; addr < 0x1400; addr += System::PAGE_SIZE)
   {
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x03FF)];
+    access.codeAccessBase = codeAccess(offset + (addr & 0x03FF));
     mySystem->setPageAccess(addr, access);
   }
   myOffset[0] = offset;
@@ -191,7 +194,7 @@ void CartridgeWD::segmentOne(uInt8 slice)
 
   for(uInt16 addr = 0x1400; addr < 0x1800; addr += System::PAGE_SIZE)
   {
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x03FF)];
+    access.codeAccessBase = codeAccess(offset + (addr & 0x03FF));
     mySystem->setPageAccess(addr, access);
   }
   myOffset[1] = offset;
@@ -205,7 +208,7 @@ void CartridgeWD::segmentTwo(uInt8 slice)
 
   for(uInt16 addr = 0x1800; addr < 0x1C00; addr += System::PAGE_SIZE)
   {
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x03FF)];
+    access.codeAccessBase = codeAccess(offset + (addr & 0x03FF));
     mySystem->setPageAccess(addr, access);
   }
   myOffset[2] = offset;
@@ -225,7 +228,7 @@ void CartridgeWD::segmentThree(uInt8 slice)
 
   for(uInt16 addr = 0x1C00; addr < 0x2000; addr += System::PAGE_SIZE)
   {
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x03FF)];
+    access.codeAccessBase = codeAccess(offset + (addr & 0x03FF));
     mySystem->setPageAccess(addr, access);
   }
   myOffset[3] = offset;
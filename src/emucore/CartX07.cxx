@@ -16,6 +16,7 @@
 //============================================================================
 
 #include "System.hxx"
+#include "PerfCounters.hxx"
 #include "M6532.hxx"
 #include "TIA.hxx"
 #include "CartX07.hxx"
@@ -104,6 +105,8 @@ bool CartridgeX07::bank(uInt16 bank)
 {
   if(bankLocked()) return false;
 
+  PERF_COUNT(bankSwitches, 1);
+
   // Remember what bank we're in
   myCurrentBank = (bank & 0x0f);
   uInt32 offset = myCurrentBank << 12;
@@ -115,7 +118,7 @@ bool CartridgeX07::bank(uInt16 bank)
   for(uInt16 addr = 0x1000; addr < 0x2000; addr += System::PAGE_SIZE)
   {
     access.directPeekBase = &myImage[offset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x0FFF)];
+    access.codeAccessBase = codeAccess(offset + (addr & 0x0FFF));
     mySystem->setPageAccess(addr, access);
   }
   return myBankChanged = true;
@@ -74,7 +74,8 @@
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
-                 const Properties& props, AudioSettings& audioSettings)
+                 const Properties& props, AudioSettings& audioSettings,
+                 const string& detectedFormat)
   : myOSystem(osystem),
     myEvent(osystem.eventHandler().event()),
     myProperties(props),
@@ -84,6 +85,10 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
   // Load user-defined palette for this ROM
   loadUserPalette();
 
+  // The debugger and cheats patch the ROM image and track code access,
+  // so this console can't share its image with other instances
+  myCart->enableDebugging();
+
   // Create subsystems for the console
   my6502 = make_unique<M6502>(myOSystem.settings());
   myRiot = make_unique<M6532>(*this, myOSystem.settings());
@@ -134,7 +139,10 @@ Console::Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
 
   if(myDisplayFormat == "AUTO" || myOSystem.settings().getBool("rominfo"))
   {
-    autodetectFrameLayout();
+    if(detectedFormat != EmptyString)
+      myDisplayFormat = detectedFormat;
+    else
+      autodetectFrameLayout();
 
     if(myProperties.get(PropType::Display_Format) == "AUTO")
     {
@@ -663,6 +671,22 @@ void Console::initializeAudio()
   myTIA->setAudioQueue(myAudioQueue);
 
   myOSystem.sound().open(myAudioQueue, &myEmulationTiming);
+
+  // The new queue starts out in normal mode
+  myFastForward = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::enableFastForward(bool state)
+{
+  if(state == myFastForward)
+    return;
+
+  myFastForward = state;
+
+  // Overflows are expected while fast-forwarding, so don't log them;
+  // afterwards, only log them if something actually drains the queue
+  myAudioQueue->ignoreOverflows(state || !myAudioSettings.enabled());
 }
 
 /* Original frying research and code by Fred Quimby.
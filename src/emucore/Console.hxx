@@ -42,7 +42,7 @@ class AudioSettings;
 #include "NTSCFilter.hxx"
 #include "EmulationTiming.hxx"
 #include "ConsoleTiming.hxx"
-#include "frame-manager/AbstractFrameManager.hxx"
+#include "frame-manager/FrameManager.hxx"
 
 /**
   Contains detailed info about a console.
@@ -72,9 +72,13 @@ class Console : public Serializable, public ConsoleIO
       @param osystem  The OSystem object to use
       @param cart     The cartridge to use with this console
       @param props    The properties for the cartridge
+      @param detectedFormat  The frame layout already detected for the
+                             cartridge ("NTSC" or "PAL"); autodetection
+                             is run when empty
     */
     Console(OSystem& osystem, unique_ptr<Cartridge>& cart,
-            const Properties& props, AudioSettings& audioSettings);
+            const Properties& props, AudioSettings& audioSettings,
+            const string& detectedFormat = EmptyString);
 
     /**
       Destructor
@@ -186,6 +190,11 @@ class Console : public Serializable, public ConsoleIO
      */
     EmulationTiming& emulationTiming() { return myEmulationTiming; }
 
+    /**
+      Retrieve the audio queue shared by the TIA and the sound driver.
+     */
+    AudioQueue& audioQueue() { return *myAudioQueue; }
+
   public:
     /**
       Toggle between NTSC/PAL/SECAM (and variants) display format.
@@ -262,6 +271,16 @@ class Console : public Serializable, public ConsoleIO
     */
     void fry() const;
 
+    /**
+      Prepare for emulating faster than real time. The audio queue will
+      overflow constantly and drop the oldest fragments, so that the audio
+      that is played is a decimated, but pitch correct version of the
+      emulated audio.
+
+      @param state  True to enable, false to disable fast-forward
+    */
+    void enableFastForward(bool state);
+
     /**
       Change the "Display.VCenter" variable.
 
@@ -399,7 +418,7 @@ class Console : public Serializable, public ConsoleIO
     unique_ptr<TIA> myTIA;
 
     // The frame manager instance that is used during emulation
-    unique_ptr<AbstractFrameManager> myFrameManager;
+    unique_ptr<FrameManager> myFrameManager;
 
     // The audio fragment queue that connects TIA and audio driver
     shared_ptr<AudioQueue> myAudioQueue;
@@ -442,6 +461,9 @@ class Console : public Serializable, public ConsoleIO
     // The audio settings
     AudioSettings& myAudioSettings;
 
+    // Whether fast-forward is currently active
+    bool myFastForward{false};
+
     // Table of RGB values for NTSC, PAL and SECAM
     static PaletteArray ourNTSCPalette;
     static PaletteArray ourPALPalette;
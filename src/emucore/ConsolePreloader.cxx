@@ -0,0 +1,274 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "ConsolePreloader.hxx"
+#include "BareConsole.hxx"
+#include "CartDetector.hxx"
+#include "MD5.hxx"
+#include "Props.hxx"
+#include "PropsSet.hxx"
+
+namespace {
+  // The settings which influence how a ROM behaves while its frame layout
+  // is detected; any change invalidates the preloaded results
+  const std::array<string, 19> EmulationSettings = {
+    "dev.settings",
+    "plr.console", "dev.console",
+    "plr.ramrandom", "dev.ramrandom",
+    "plr.cpurandom", "dev.cpurandom",
+    "plr.bankrandom", "dev.bankrandom",
+    "dev.tiadriven",
+    "dev.tia.type",
+    "dev.tia.plinvphase", "dev.tia.msinvphase", "dev.tia.blinvphase",
+    "dev.tia.delaypfbits", "dev.tia.delaypfcolor",
+    "dev.tia.delayplswap", "dev.tia.delayblswap",
+    "dev.thumb.trapfatal"
+  };
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ConsolePreloader::ConsolePreloader(const Settings& settings,
+                                   const PropertiesSet& propSet)
+  : myAppSettings(settings),
+    myPropSet(propSet)
+{
+  myThread = std::thread([this]() { run(); });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ConsolePreloader::~ConsolePreloader()
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+
+    myQuit = true;
+    myHasPendingJob = false;
+    myCancelRequested = true;
+  }
+  myCondition.notify_all();
+
+  myThread.join();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ConsolePreloader::preload(const FilesystemNode& rom, const string& cartType,
+                               const string& startBank)
+{
+  Job job{rom, cartType, startBank, snapshotSettings()};
+  const string path = rom.getPath();
+
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  // Nothing to do if up-to-date results are already pooled
+  for(auto it = myPool.begin(); it != myPool.end(); ++it)
+  {
+    if(it->first != path)
+      continue;
+
+    const Preload& pooled = *it->second;
+    if(pooled.cartTypeOverride == cartType &&
+       pooled.startBankOverride == startBank && pooled.settings == job.settings &&
+       fileUnchanged(pooled, rom))
+    {
+      myPool.splice(myPool.begin(), myPool, it);
+      myHasPendingJob = false;
+      if(myActivePath != "")
+        myCancelRequested = true;
+
+      return;
+    }
+    myPool.erase(it);
+    break;
+  }
+
+  if(myActivePath == path && !myCancelRequested)
+  {
+    // Already being worked on; forget about anything requested since
+    myHasPendingJob = false;
+    return;
+  }
+
+  // The selection has changed; discard the work in progress
+  if(myActivePath != "")
+    myCancelRequested = true;
+
+  myPendingJob = std::move(job);
+  myHasPendingJob = true;
+  myCondition.notify_all();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+shared_ptr<const ConsolePreloader::Preload>
+    ConsolePreloader::get(const FilesystemNode& rom)
+{
+  const string path = rom.getPath();
+  const StringList settings = snapshotSettings();
+
+  std::unique_lock<std::mutex> lock(myMutex);
+
+  // If the ROM is still being worked on, wait for the results
+  myCondition.wait(lock, [&]() {
+    return !(myHasPendingJob && myPendingJob.rom.getPath() == path) &&
+           !(myActivePath == path && !myCancelRequested);
+  });
+
+  for(auto it = myPool.begin(); it != myPool.end(); ++it)
+  {
+    if(it->first != path)
+      continue;
+
+    if(it->second->settings != settings || !fileUnchanged(*it->second, rom))
+    {
+      myPool.erase(it);
+      return nullptr;
+    }
+    myPool.splice(myPool.begin(), myPool, it);
+
+    return myPool.front().second;
+  }
+
+  return nullptr;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ConsolePreloader::cancel()
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  myHasPendingJob = false;
+  if(myActivePath != "")
+    myCancelRequested = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ConsolePreloader::run()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+
+  while(true)
+  {
+    myCondition.wait(lock, [this]() { return myQuit || myHasPendingJob; });
+    if(myQuit)
+      return;
+
+    Job job = std::move(myPendingJob);
+    myHasPendingJob = false;
+    myActivePath = job.rom.getPath();
+    myCancelRequested = false;
+
+    lock.unlock();
+    shared_ptr<const Preload> preload = process(job);
+    lock.lock();
+
+    if(preload && !myCancelRequested)
+    {
+      myPool.emplace_front(myActivePath, preload);
+      if(myPool.size() > POOL_SIZE)
+        myPool.pop_back();
+    }
+    myActivePath = "";
+
+    myCondition.notify_all();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+shared_ptr<ConsolePreloader::Preload> ConsolePreloader::process(const Job& job)
+{
+  auto preload = make_shared<Preload>();
+
+  // Taken before reading, so a change while reading is noticed later on
+  preload->fileSize = job.rom.getSize();
+  preload->fileModTime = job.rom.getModTime();
+
+  if((preload->size = job.rom.read(preload->image)) == 0 || myCancelRequested)
+    return nullptr;
+
+  preload->md5 = MD5::hash(preload->image, preload->size);
+  if(myCancelRequested)
+    return nullptr;
+
+  // Resolve the cartridge type and start bank as OSystem::openConsole does
+  Properties props;
+  myPropSet.getMD5(preload->md5, props);
+
+  preload->cartType = job.cartTypeOverride != ""
+      ? job.cartTypeOverride : props.get(PropType::Cart_Type);
+  preload->startBank = job.startBankOverride != ""
+      ? job.startBankOverride : props.get(PropType::Cart_StartBank);
+  preload->cartTypeOverride = job.cartTypeOverride;
+  preload->startBankOverride = job.startBankOverride;
+  preload->settings = job.settings;
+
+  // Mirror the application settings; as in Console::autodetectFrameLayout,
+  // the SuperCharger progress bars are turned off
+  for(size_t i = 0; i < EmulationSettings.size(); ++i)
+    mySettings.setValue(EmulationSettings[i], job.settings[i]);
+  mySettings.setValue("romloadcount", "0");
+  mySettings.setValue("fastscbios", "true");
+
+  try
+  {
+    string md5 = preload->md5;
+    unique_ptr<Cartridge> cart = CartDetector::create(job.rom, preload->image,
+        preload->size, md5, preload->cartType, mySettings);
+
+    // A cart created from a piece of a multicart image gets its own
+    // properties, so its detection can't be reused
+    if(!cart || md5 != preload->md5)
+      return preload;
+
+    const string& startBank = preload->startBank;
+    BareConsole console(std::move(cart), mySettings, props, [&startBank]() {
+      return (startBank == EmptyString || BSPF::equalsIgnoreCase(startBank, "AUTO"))
+          ? -1 : BSPF::stringToInt(startBank);
+    });
+
+    const FrameLayout layout = console.detectFrameLayout(&myCancelRequested);
+    if(myCancelRequested)
+      return nullptr;
+
+    preload->displayFormat =
+        layout == FrameLayout::pal ? "PAL" : "NTSC";
+  }
+  catch(const std::exception&)
+  {
+    // Leave the detection to the console, which reports any errors
+  }
+
+  return preload;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+StringList ConsolePreloader::snapshotSettings() const
+{
+  StringList settings;
+  settings.reserve(EmulationSettings.size());
+
+  for(const auto& key: EmulationSettings)
+    settings.push_back(myAppSettings.getString(key));
+
+  return settings;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ConsolePreloader::fileUnchanged(const Preload& preload,
+                                     const FilesystemNode& rom)
+{
+  return rom.getSize() == preload.fileSize &&
+         rom.getModTime() == preload.fileModTime;
+}
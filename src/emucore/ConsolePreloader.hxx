@@ -0,0 +1,196 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef CONSOLE_PRELOADER_HXX
+#define CONSOLE_PRELOADER_HXX
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <list>
+
+class PropertiesSet;
+
+#include "bspf.hxx"
+#include "FSNode.hxx"
+#include "Settings.hxx"
+
+/**
+  This class speculatively prepares a ROM for launching while it is still
+  highlighted in the ROM launcher.  A background thread reads the image,
+  computes its MD5, looks up its properties, builds a cartridge from it
+  and runs the frame layout detection on a private, bare emulation core.  When the ROM is actually started, the
+  console can be created from these results without touching the file
+  again or running the autodetection.
+
+  Only one ROM is worked on at a time; requesting another one cancels
+  the work in progress.  The results for the last few ROMs are kept in a
+  small pool, so that flipping between games stays fast.
+
+  The console itself is still created on the main thread, since it is
+  tied to the shared sound, video and event subsystems.
+*/
+class ConsolePreloader
+{
+  public:
+    /**
+      The results of preloading a ROM.
+    */
+    struct Preload
+    {
+      string md5;
+      ByteBuffer image;
+      size_t size{0};
+
+      // The size and modification time of the file when it was read;
+      // the results are discarded once the file changes
+      size_t fileSize{0};
+      uInt64 fileModTime{0};
+
+      // The cartridge type and start bank the results depend on, from
+      // the properties or the commandline
+      string cartType;
+      string startBank;
+
+      // The request and settings the results were created for
+      string cartTypeOverride;
+      string startBankOverride;
+      StringList settings;
+
+      // The frame layout that was detected ("NTSC" or "PAL"),
+      // empty if the detection failed
+      string displayFormat;
+    };
+
+  public:
+    /**
+      Create a new preloader; the worker thread is started immediately.
+
+      @param settings  The settings which are mirrored by the private core
+      @param propSet   The properties, looked up by the worker thread
+    */
+    ConsolePreloader(const Settings& settings, const PropertiesSet& propSet);
+
+    /**
+      The destructor cancels any work in progress and joins the worker.
+    */
+    ~ConsolePreloader();
+
+  public:
+    /**
+      Start preloading the given ROM, cancelling the ROM currently worked on.
+      Nothing happens if the ROM is already pooled or being worked on.
+
+      @param rom        The ROM file
+      @param cartType   The cartridge type given on the commandline, if any;
+                        otherwise the type from the ROM properties is used
+      @param startBank  The start bank given on the commandline, if any
+    */
+    void preload(const FilesystemNode& rom, const string& cartType,
+                 const string& startBank);
+
+    /**
+      Get the results for the given ROM.  If the ROM is currently being
+      preloaded, this waits until the work is finished.
+
+      @param rom  The ROM file
+      @return  The results, or nullptr if the ROM hasn't been preloaded,
+               or the file or the settings have since changed
+    */
+    shared_ptr<const Preload> get(const FilesystemNode& rom);
+
+    /**
+      Cancel and discard the work in progress, if any.
+    */
+    void cancel();
+
+  private:
+    struct Job
+    {
+      FilesystemNode rom;
+      string cartTypeOverride;
+      string startBankOverride;
+      StringList settings;
+    };
+
+    /**
+      The main loop of the worker thread.
+    */
+    void run();
+
+    /**
+      Do the actual work for a job, on the worker thread.
+
+      @return  The results, or nullptr if the ROM could not be read
+               or the job was cancelled
+    */
+    shared_ptr<Preload> process(const Job& job);
+
+    /**
+      Get the current values of all settings which influence the
+      frame layout detection.
+    */
+    StringList snapshotSettings() const;
+
+    /**
+      Answer whether the given ROM file is still the one that was preloaded.
+    */
+    static bool fileUnchanged(const Preload& preload, const FilesystemNode& rom);
+
+  private:
+    // The maximum number of ROMs to keep in the pool
+    static constexpr size_t POOL_SIZE = 4;
+
+    // The settings used by the application, mirrored on each request
+    const Settings& myAppSettings;
+
+    // The properties used by the application
+    const PropertiesSet& myPropSet;
+
+    // Private settings, only ever accessed by the worker thread
+    Settings mySettings;
+
+    std::mutex myMutex;
+    std::condition_variable myCondition;
+    std::thread myThread;
+
+    // The job waiting to be picked up by the worker
+    Job myPendingJob;
+    bool myHasPendingJob{false};
+
+    // The path of the ROM currently worked on, empty if idle
+    string myActivePath;
+
+    // Checked by the worker between frames
+    std::atomic<bool> myCancelRequested{false};
+
+    bool myQuit{false};
+
+    // Recently preloaded ROMs (keyed by path), most recently used first
+    std::list<std::pair<string, shared_ptr<const Preload>>> myPool;
+
+  private:
+    // Following constructors and assignment operators not supported
+    ConsolePreloader() = delete;
+    ConsolePreloader(const ConsolePreloader&) = delete;
+    ConsolePreloader(ConsolePreloader&&) = delete;
+    ConsolePreloader& operator=(const ConsolePreloader&) = delete;
+    ConsolePreloader& operator=(ConsolePreloader&&) = delete;
+};
+
+#endif
@@ -0,0 +1,308 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <iomanip>
+
+#include "DifferentialRunner.hxx"
+#include "BareConsole.hxx"
+#include "FSNode.hxx"
+#include "Settings.hxx"
+#include "Props.hxx"
+#include "MD5.hxx"
+#include "Base.hxx"
+
+namespace {
+  constexpr uInt32 FRAMES_DEFAULT = 600;
+  constexpr uInt32 RAM_SIZE = 128;
+
+  // Scripted input: each joystick input is held for this many frames
+  constexpr uInt32 INPUT_PERIOD = 30;
+
+  // Scripted input: reset is held during these frames
+  constexpr uInt32 RESET_START = 60, RESET_END = 65;
+}
+
+/**
+  A single console, running either the optimized or the reference core.
+*/
+class DifferentialRunner::Instance : public BareConsole
+{
+  public:
+    Instance(const FilesystemNode& romFile, const ByteBuffer& image, size_t size,
+             Settings& settings, const Properties& props, bool optimized)
+      : BareConsole(createCartridge(romFile, image, size, settings),
+                    settings, props)
+    {
+      myTIA.enableReferenceMode(!optimized);
+    }
+
+    void setInput(uInt32 frame);
+
+    bool execute() { return myCpu.execute(1); }
+
+  private:
+    // Following constructors and assignment operators not supported
+    Instance() = delete;
+    Instance(const Instance&) = delete;
+    Instance(Instance&&) = delete;
+    Instance& operator=(const Instance&) = delete;
+    Instance& operator=(Instance&&) = delete;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DifferentialRunner::Instance::setInput(uInt32 frame)
+{
+  // The script only depends on the frame number, so both consoles see
+  // exactly the same input
+  const uInt32 input = Random(frame / INPUT_PERIOD + 1).next();
+
+  myEvent.set(Event::JoystickZeroUp,    (input & 0x01) ? 1 : 0);
+  myEvent.set(Event::JoystickZeroDown,  (input & 0x02) && !(input & 0x01) ? 1 : 0);
+  myEvent.set(Event::JoystickZeroLeft,  (input & 0x04) ? 1 : 0);
+  myEvent.set(Event::JoystickZeroRight, (input & 0x08) && !(input & 0x04) ? 1 : 0);
+  myEvent.set(Event::JoystickZeroFire,  (input & 0x10) ? 1 : 0);
+  myEvent.set(Event::ConsoleReset,      frame >= RESET_START && frame < RESET_END ? 1 : 0);
+  myRiot.update();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DifferentialRunner::Step::operator==(const Step& other) const
+{
+  return
+    cycles == other.cycles && frame == other.frame &&
+    scanline == other.scanline && clock == other.clock &&
+    PC == other.PC && A == other.A && X == other.X && Y == other.Y &&
+    SP == other.SP && PS == other.PS && collisions == other.collisions;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+DifferentialRunner::DifferentialRunner(int argc, char* argv[])
+  : myRuns(std::max(argc - 2, 0))
+{
+  for (int i = 2; i < argc; i++) {
+    DifferentialRun& run(myRuns[i-2]);
+
+    string arg = argv[i];
+    size_t splitPoint = arg.find_first_of(':');
+
+    run.romFile = splitPoint == string::npos ? arg : arg.substr(0, splitPoint);
+
+    if (splitPoint == string::npos) run.frames = FRAMES_DEFAULT;
+    else  {
+      int frames = BSPF::stringToInt(arg.substr(splitPoint+1, string::npos));
+      run.frames = frames > 0 ? frames : FRAMES_DEFAULT;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+DifferentialRunner::~DifferentialRunner() = default;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DifferentialRunner::run()
+{
+  cout << "Comparing optimized and reference core..." << endl;
+
+  bool success = true;
+  for (const DifferentialRun& run : myRuns) {
+    cout << endl << "running " << run.romFile << " for " << run.frames << " frames..." << endl;
+
+    success = runOne(run) && success;
+  }
+
+  return success;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DifferentialRunner::runOne(const DifferentialRun& run)
+{
+  FilesystemNode imageFile(run.romFile);
+
+  if (!imageFile.isFile()) {
+    cout << "ERROR: " << run.romFile << " is not a ROM image" << endl;
+    return false;
+  }
+
+  ByteBuffer image;
+  size_t size = imageFile.read(image);
+  if (size == 0) {
+    cout << "ERROR: unable to read " << run.romFile << endl;
+    return false;
+  }
+
+  // Each console has its own settings, since creating the cartridge may
+  // update them
+  Settings referenceSettings, optimizedSettings;
+  referenceSettings.setValue("fastscbios", true);
+  optimizedSettings.setValue("fastscbios", true);
+  const Properties props;
+
+  Instance reference(imageFile, image, size, referenceSettings, props, false);
+  Instance optimized(imageFile, image, size, optimizedSettings, props, true);
+
+  // Both consoles must go through the same resets, as these consume
+  // random numbers
+  const FrameLayout layout = reference.detectFrameLayout();
+  if (optimized.detectFrameLayout() != layout) {
+    cout << "DIVERGENCE in frame layout detection" << endl;
+    return false;
+  }
+  reference.setFrameLayout(layout);
+  optimized.setFrameLayout(layout);
+  reference.mySystem.reset();
+  optimized.mySystem.reset();
+
+  myNumSteps = 0;
+
+  for (uInt32 frame = 0; frame < run.frames; ++frame) {
+    reference.setInput(frame);
+    optimized.setInput(frame);
+
+    const uInt32 frameCount = reference.myFrameManager.frameCount();
+
+    while (reference.myFrameManager.frameCount() == frameCount) {
+      const bool referenceOk = reference.execute();
+      const bool optimizedOk = optimized.execute();
+
+      const Step referenceStep = captureStep(reference);
+      const Step optimizedStep = captureStep(optimized);
+
+      myTrace[myNumSteps++ % TRACE_LENGTH] = {referenceStep, optimizedStep};
+
+      const bool ramDiffers = !std::equal(
+        reference.myRiot.getRAM(), reference.myRiot.getRAM() + RAM_SIZE,
+        optimized.myRiot.getRAM()
+      );
+
+      if (referenceOk != optimizedOk || referenceStep != optimizedStep || ramDiffers) {
+        cout << "DIVERGENCE after " << myNumSteps << " instructions, in frame " << frame
+             << (ramDiffers ? " (RIOT RAM differs)" : "") << endl;
+        printTrace();
+
+        return false;
+      }
+
+      if (!referenceOk) {
+        cout << "ERROR: emulation failed after " << referenceStep.cycles << " cycles" << endl;
+        return false;
+      }
+    }
+
+    if (!compareFrames(reference, optimized)) {
+      cout << "DIVERGENCE in frame " << frame << endl;
+      printTrace();
+
+      return false;
+    }
+  }
+
+  cout << "no divergence in " << run.frames << " frames, " << myNumSteps
+       << " instructions" << endl;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+DifferentialRunner::Step DifferentialRunner::captureStep(const Instance& instance)
+{
+  const M6502& cpu = instance.myCpu;
+  const TIA& tia = instance.myTIA;
+  Step step;
+
+  step.cycles = instance.mySystem.cycles();
+  step.frame = tia.frameCount();
+  step.scanline = tia.scanlines();
+  step.clock = tia.clocksThisLine();
+  step.PC = cpu.PC;
+  step.A = cpu.A;
+  step.X = cpu.X;
+  step.Y = cpu.Y;
+  step.SP = cpu.SP;
+  step.PS = cpu.PS();
+  step.collisions = uInt16(tia.myCollisionMask & 0x7fff);
+
+  return step;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string DifferentialRunner::describeStep(const Step& step)
+{
+  ostringstream buf;
+
+  buf << std::setw(10) << step.cycles
+      << std::setw(5) << step.scanline << std::setw(4) << step.clock
+      << std::hex << std::uppercase << std::setfill('0')
+      << "  PC=" << std::setw(4) << step.PC
+      << " A=" << std::setw(2) << int(step.A)
+      << " X=" << std::setw(2) << int(step.X)
+      << " Y=" << std::setw(2) << int(step.Y)
+      << " SP=" << std::setw(2) << int(step.SP)
+      << " PS=" << std::setw(2) << int(step.PS)
+      << " CX=" << std::setw(4) << step.collisions;
+
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DifferentialRunner::compareFrames(Instance& reference, Instance& optimized)
+{
+  TIA& referenceTIA = reference.myTIA;
+  TIA& optimizedTIA = optimized.myTIA;
+
+  referenceTIA.renderToFrameBuffer();
+  optimizedTIA.renderToFrameBuffer();
+
+  const uInt32 width = referenceTIA.width(), height = referenceTIA.height();
+  if (optimizedTIA.height() != height) {
+    cout << "frame height: reference " << height << ", optimized "
+         << optimizedTIA.height() << endl;
+    return false;
+  }
+
+  const uInt8* referenceFrame = referenceTIA.frameBuffer();
+  const uInt8* optimizedFrame = optimizedTIA.frameBuffer();
+  const auto mismatch =
+    std::mismatch(referenceFrame, referenceFrame + width * height, optimizedFrame);
+
+  if (mismatch.first == referenceFrame + width * height) return true;
+
+  const auto offset = mismatch.first - referenceFrame;
+  cout << "frame hash: reference " << MD5::hash(referenceFrame, width * height)
+       << ", optimized " << MD5::hash(optimizedFrame, width * height) << endl
+       << "first differing pixel at " << (offset % width) << "," << (offset / width)
+       << ": reference $" << Common::Base::toString(*mismatch.first, Common::Base::Fmt::_16_2)
+       << ", optimized $" << Common::Base::toString(*mismatch.second, Common::Base::Fmt::_16_2)
+       << endl;
+
+  return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DifferentialRunner::printTrace() const
+{
+  const uInt64 length = std::min<uInt64>(myNumSteps, TRACE_LENGTH);
+
+  cout << "last " << length << " instructions (cycles, scanline, clock, registers):" << endl;
+
+  for (uInt64 i = myNumSteps - length; i < myNumSteps; ++i) {
+    const auto& steps = myTrace[i % TRACE_LENGTH];
+
+    cout << "  reference " << describeStep(steps.first) << endl;
+    if (steps.second != steps.first)
+      cout << "  optimized " << describeStep(steps.second) << "  <--" << endl;
+  }
+}
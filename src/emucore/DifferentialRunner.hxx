@@ -0,0 +1,94 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef DIFFERENTIAL_RUNNER
+#define DIFFERENTIAL_RUNNER
+
+#include "bspf.hxx"
+
+/**
+  Runs a ROM on two bare console stacks in lock-step: one with all
+  optimizations enabled, and one using the reference implementation of
+  the core.  Both get the same scripted input, and their CPU registers,
+  RIOT RAM and TIA collision latches are compared after each instruction,
+  and their frames at the end of each frame.  On the first divergence,
+  the last instructions executed by both stacks are printed.
+
+  Started with 'stella -diff <rom>[:<frames>] ...'
+*/
+class DifferentialRunner
+{
+  public:
+    DifferentialRunner(int argc, char* argv[]);
+    ~DifferentialRunner();
+
+    bool run();
+
+  private:
+    struct DifferentialRun {
+      string romFile;
+      uInt32 frames;
+    };
+
+    class Instance;
+
+    /**
+      The state of a console after executing an instruction
+    */
+    struct Step {
+      uInt64 cycles{0};
+      uInt32 frame{0};
+      uInt32 scanline{0};
+      uInt32 clock{0};
+      uInt16 PC{0};
+      uInt8 A{0}, X{0}, Y{0}, SP{0}, PS{0};
+      uInt16 collisions{0};
+
+      bool operator==(const Step& other) const;
+      bool operator!=(const Step& other) const { return !(*this == other); }
+    };
+
+    // Number of instructions printed on divergence
+    static constexpr uInt32 TRACE_LENGTH = 16;
+
+  private:
+    bool runOne(const DifferentialRun& run);
+
+    static Step captureStep(const Instance& instance);
+    static string describeStep(const Step& step);
+
+    static bool compareFrames(Instance& reference, Instance& optimized);
+
+    void printTrace() const;
+
+  private:
+    vector<DifferentialRun> myRuns;
+
+    // Pairs of reference and optimized steps, used as a ring buffer
+    std::array<std::pair<Step, Step>, TRACE_LENGTH> myTrace;
+    uInt64 myNumSteps{0};
+
+  private:
+    // Following constructors and assignment operators not supported
+    DifferentialRunner() = delete;
+    DifferentialRunner(const DifferentialRunner&) = delete;
+    DifferentialRunner(DifferentialRunner&&) = delete;
+    DifferentialRunner& operator=(const DifferentialRunner&) = delete;
+    DifferentialRunner& operator=(DifferentialRunner&&) = delete;
+};
+
+#endif // DIFFERENTIAL_RUNNER
@@ -20,6 +20,7 @@
 #include "EmulationWorker.hxx"
 #include "DispatchResult.hxx"
 #include "TIA.hxx"
+#include "PerfCounters.hxx"
 
 using namespace std::chrono;
 
@@ -69,7 +70,8 @@ void EmulationWorker::handlePossibleException()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void EmulationWorker::start(uInt32 cyclesPerSecond, uInt64 maxCycles, uInt64 minCycles, DispatchResult* dispatchResult, TIA* tia)
+void EmulationWorker::start(uInt32 cyclesPerSecond, uInt64 maxCycles, uInt64 minCycles, DispatchResult* dispatchResult, TIA* tia,
+                            double fastForwardSeconds)
 {
   // Wait until any pending signal has been processed
   waitUntilPendingSignalHasProcessed();
@@ -97,6 +99,7 @@ void EmulationWorker::start(uInt32 cyclesPerSecond, uInt64 maxCycles, uInt64 min
     myMaxCycles = maxCycles;
     myMinCycles = minCycles;
     myDispatchResult = dispatchResult;
+    myFastForwardSeconds = fastForwardSeconds;
 
     // Raise the signal...
     myPendingSignal = Signal::resume;
@@ -207,6 +210,9 @@ void EmulationWorker::handleWakeupFromWaitingForResume(std::unique_lock<std::mut
       myVirtualTime = high_resolution_clock::now();
       myTotalCycles = 0;
 
+      myFastForwardDeadline = myVirtualTime +
+        duration_cast<high_resolution_clock::duration>(duration<double>(myFastForwardSeconds));
+
       // Enter emulation. This will emulate a timeslice and set the state upon completion.
       dispatchEmulation(lock);
       break;
@@ -262,6 +268,8 @@ void EmulationWorker::dispatchEmulation(std::unique_lock<std::mutex>& lock)
   // Technically, we could do without State::running, but it is cleaner and might be useful in the future
   myState = State::running;
 
+  PERF_TIME(emulationTime);
+
   uInt64 totalCycles = 0;
 
   do {
@@ -269,11 +277,20 @@ void EmulationWorker::dispatchEmulation(std::unique_lock<std::mutex>& lock)
     totalCycles += myDispatchResult->getCycles();
   } while (totalCycles < myMinCycles && myDispatchResult->getStatus() == DispatchResult::Status::ok);
 
+  // When fast-forwarding, keep going until the deadline has passed. We don't give up the mutex
+  // until then, so stop() will wait for us.
+  if (myFastForwardSeconds > 0)
+    while (myDispatchResult->getStatus() == DispatchResult::Status::ok &&
+           high_resolution_clock::now() < myFastForwardDeadline) {
+      myTia->update(*myDispatchResult, myMaxCycles);
+      totalCycles += myDispatchResult->getCycles();
+    }
+
   myTotalCycles += totalCycles;
 
   bool continueEmulating = false;
 
-  if (myDispatchResult->getStatus() == DispatchResult::Status::ok) {
+  if (myDispatchResult->getStatus() == DispatchResult::Status::ok && myFastForwardSeconds <= 0) {
     // If emulation finished successfully, we are free to go for another round
     duration<double> timesliceSeconds(static_cast<double>(totalCycles) / static_cast<double>(myCyclesPerSecond));
     myVirtualTime += duration_cast<high_resolution_clock::duration>(timesliceSeconds);
@@ -33,6 +33,11 @@
  * In combination, the scheduling in the main loop and the microscheduling in the worker
  * ensure that the emulation continues to run even if rendering blocks, ensuring the real
  * time scheduling required for cycle exact audio to work.
+ *
+ * In fast-forward mode, there is no real time scheduling. The worker emulates as fast as
+ * possible until a wall clock deadline is reached and then stops on its own. The main loop
+ * renders the last frame in the meantime and iterates without sleeping, so frames are
+ * skipped as needed to keep up with the display.
  */
 
 #ifndef EMULATION_WORKER_HXX
@@ -65,9 +70,13 @@ class EmulationWorker
     ~EmulationWorker();
 
     /**
-      Wake up the worker and start emulation with the specified parameters.
+      Wake up the worker and start emulation with the specified parameters. If
+      fastForwardSeconds is nonzero, emulation is not synced to real time;
+      instead, the worker emulates as fast as possible for the given wall clock
+      time and then stops.
      */
-    void start(uInt32 cyclesPerSecond, uInt64 maxCycles, uInt64 minCycles, DispatchResult* dispatchResult, TIA* tia);
+    void start(uInt32 cyclesPerSecond, uInt64 maxCycles, uInt64 minCycles, DispatchResult* dispatchResult, TIA* tia,
+               double fastForwardSeconds = 0.);
 
     /**
       Stop emulation and return the number of 6507 cycles emulated.
@@ -193,11 +202,14 @@ class EmulationWorker
     uInt64 myMaxCycles{0};
     uInt64 myMinCycles{0};
     DispatchResult* myDispatchResult{nullptr};
+    double myFastForwardSeconds{0.};
 
     // Total number of cycles during this emulation run
     uInt64 myTotalCycles{0};
     // 6507 time
     std::chrono::time_point<std::chrono::high_resolution_clock> myVirtualTime;
+    // End of the fast-forward timeslice (wall clock)
+    std::chrono::time_point<std::chrono::high_resolution_clock> myFastForwardDeadline;
 
   private:
 
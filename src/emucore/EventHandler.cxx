@@ -223,9 +223,8 @@ void EventHandler::poll(uInt64 time)
     myOSystem.console().riot().update();
 
     // Now check if the StateManager should be saving or loading state
-    // (for rewind and/or movies
-    if(myOSystem.state().mode() != StateManager::Mode::Off)
-      myOSystem.state().update();
+    // (for rewind and/or movies), and report finished saves
+    myOSystem.state().update();
 
   #ifdef CHEATCODE_SUPPORT
     for(auto& cheat: myOSystem.cheat().perFrame())
@@ -393,6 +392,10 @@ void EventHandler::handleEvent(Event::Type event, Int32 value, bool repeated)
       if (!repeated) myFryingFlag = pressed;
       return;
 
+    case Event::FastForward:
+      if (!repeated) myFastForwardFlag = pressed;
+      return;
+
     case Event::ReloadConsole:
       if (pressed && !repeated) myOSystem.reloadConsole();
       return;
@@ -1704,6 +1707,9 @@ void EventHandler::setState(EventHandlerState state)
 {
   myState = state;
 
+  // The key release would end up in another mode, so stop fast-forwarding
+  myFastForwardFlag = false;
+
   // Normally, the usage of modifier keys is determined by 'modcombo'
   // For certain ROMs it may be forced off, whatever the setting
   myPKeyHandler->useModKeys() = myOSystem.settings().getBool("modcombo");
@@ -1813,6 +1819,7 @@ EventHandler::EmulActionList EventHandler::ourEmulActionList = { {
   { Event::TogglePauseMode,         "Toggle Pause mode",                     "" },
   { Event::StartPauseMode,          "Start Pause mode",                      "" },
   { Event::Fry,                     "Fry cartridge",                         "" },
+  { Event::FastForward,             "Fast-forward (while held)",             "" },
   { Event::DebuggerMode,            "Toggle Debugger mode",                  "" },
 
   { Event::ConsoleSelect,           "Select",                                "" },
@@ -2019,7 +2026,7 @@ EventHandler::MenuActionList EventHandler::ourMenuActionList = { {
 // Event groups
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const Event::EventSet EventHandler::MiscEvents = {
-  Event::Quit, Event::ReloadConsole, Event::Fry, Event::StartPauseMode,
+  Event::Quit, Event::ReloadConsole, Event::Fry, Event::FastForward, Event::StartPauseMode,
   Event::TogglePauseMode, Event::OptionsMenuMode, Event::CmdMenuMode, Event::ExitMode,
   Event::TakeSnapshot, Event::ToggleContSnapshots, Event::ToggleContSnapshotsFrame,
   // Event::MouseAxisXMove, Event::MouseAxisYMove,
@@ -154,6 +154,7 @@ class EventHandler
     void handleConsoleStartupEvents();
 
     bool frying() const { return myFryingFlag; }
+    bool fastForwarding() const { return myFastForwardFlag; }
 
     StringList getActionList(Event::Group group) const;
     VariantList getComboList(EventMode mode) const;
@@ -450,6 +451,9 @@ class EventHandler
     // Indicates whether or not we're in frying mode
     bool myFryingFlag{false};
 
+    // Indicates whether or not emulation runs as fast as possible
+    bool myFastForwardFlag{false};
+
     // Sometimes an extraneous mouse motion event occurs after a video
     // state change; we detect when this happens and discard the event
     bool mySkipMouseMotion{true};
@@ -468,7 +472,7 @@ class EventHandler
     #else
       PNG_SIZE             = 0,
     #endif
-      EMUL_ACTIONLIST_SIZE = 144 + PNG_SIZE + COMBO_SIZE,
+      EMUL_ACTIONLIST_SIZE = 145 + PNG_SIZE + COMBO_SIZE,
       MENU_ACTIONLIST_SIZE = 18
     ;
 
@@ -299,6 +299,20 @@ class FBSurface
     */
     virtual bool render() = 0;
 
+    /**
+      This method can be called before render() to indicate that only the
+      given lines (relative to the source rectangle) were modified since
+      the last render(), so that backends can avoid uploading the other
+      lines.  A count of zero means that nothing was modified.  If not
+      called, the whole surface is assumed to be modified.
+
+      @param first  The first modified line
+      @param count  The number of modified lines
+    */
+    void setDirtyLines(uInt32 first, uInt32 count) {
+      myDirtyFirstLine = first;  myDirtyLineCount = count;
+    }
+
     /**
       This method should be called to reset the surface to empty
       pixels / colour black.
@@ -382,6 +396,11 @@ class FBSurface
 
     Attributes myAttributes;
 
+    // The lines modified since the last render(), see setDirtyLines();
+    // child classes that make use of this must reset it after rendering
+    static constexpr uInt32 ALL_LINES = ~0U;
+    uInt32 myDirtyFirstLine{0}, myDirtyLineCount{ALL_LINES};
+
     static FullPaletteArray myPalette;
 
   private:
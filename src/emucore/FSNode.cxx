@@ -208,6 +208,18 @@ bool FilesystemNode::rename(const string& newfile)
   return (_realNode && _realNode->exists()) ? _realNode->rename(newfile) : false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t FilesystemNode::getSize() const
+{
+  return _realNode ? _realNode->getSize() : 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 FilesystemNode::getModTime() const
+{
+  return _realNode ? _realNode->getModTime() : 0;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 size_t FilesystemNode::read(ByteBuffer& image) const
 {
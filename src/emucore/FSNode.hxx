@@ -240,6 +240,15 @@ class FilesystemNode
      */
     size_t read(ByteBuffer& buffer) const;
 
+    /**
+     * The size of the file and the time it was last modified, as reported
+     * by the filesystem; for a file inside a ZIP archive, those of the
+     * archive.  These are only meant to detect that a file has changed on
+     * disk, and are 0 if the information is not available.
+     */
+    size_t getSize() const;
+    uInt64 getModTime() const;
+
     /**
      * The following methods are almost exactly the same as the various
      * getXXXX() methods above.  Internally, they call the respective methods
@@ -399,6 +408,14 @@ class AbstractFSNode
      *          a try-catch block.
      */
     virtual size_t read(ByteBuffer& buffer) const { return 0; }
+
+    /**
+     * The size of the file and the time it was last modified.
+     *
+     * @return  The value, or 0 if it cannot be determined
+     */
+    virtual size_t getSize() const { return 0; }
+    virtual uInt64 getModTime() const { return 0; }
 };
 
 #endif
@@ -171,6 +171,7 @@ FBInitStatus FrameBuffer::createDisplay(const string& title,
 {
   ++myInitializedCount;
   myScreenTitle = title;
+  myPlainFramePresented = false;
 
   // In HiDPI mode, all created displays must be scaled by 2x
   if(honourHiDPI && hidpiEnabled())
@@ -257,7 +258,8 @@ FBInitStatus FrameBuffer::createDisplay(const string& title,
   const GUI::Font& f = hidpiEnabled() ? infoFont() : font();
   myStatsMsg.color = kColorInfo;
   myStatsMsg.w = f.getMaxCharWidth() * 40 + 3;
-  myStatsMsg.h = (f.getFontHeight() + 2) * 3;
+  myStatsMsg.h = (f.getFontHeight() + 2) *
+    (PerfCounters::enabled() ? 3 + PerfCounters::SUMMARY_LINES : 3);
 
   if(!myStatsMsg.surface)
   {
@@ -298,6 +300,9 @@ void FrameBuffer::update(bool force)
   //  - at the bottom of ::update(), to actually draw them (this must come
   //    last, since they are always drawn on top of everything else).
 
+  // Anything drawn from here on covers the last emulation frame
+  myPlainFramePresented = false;
+
   // Full rendering is required when messages are enabled
   force = force || myMsg.counter >= 0;
 
@@ -424,8 +429,15 @@ void FrameBuffer::updateInEmulationMode(float framesPerSecond)
   // Typically called from a thread, so it needs to be separate from
   // the normal update() method
   //
-  // We don't worry about selective rendering here; the rendering
-  // always happens at the full framerate
+  // Frames identical to the one on screen are neither rendered nor presented,
+  // unless messages are drawn on top of them
+  const bool overlays = myStatsMsg.enabled || myMsg.enabled;
+  if(myPlainFramePresented && !overlays && !myTIASurface->frameChanged())
+  {
+    myLastScanlines = myOSystem.console().tia().frameBufferScanlinesLastFrame();
+    myPausedCount = 0;
+    return;
+  }
 
   clear();  // TODO - test this: it may cause slowdowns on older systems
   myTIASurface->render();
@@ -443,6 +455,7 @@ void FrameBuffer::updateInEmulationMode(float framesPerSecond)
 
   // Push buffers to screen
   renderToScreen();
+  myPlainFramePresented = !overlays;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -499,11 +512,17 @@ void FrameBuffer::drawFrameStats(float framesPerSecond)
   yPos += dy;
   ss.str("");
 
+  // When fast-forwarding, show the actual speed instead of the configured one
+  const bool fastForward = myOSystem.eventHandler().fastForwarding();
+  const float speed = fastForward
+    ? framesPerSecond / myOSystem.console().getFramerate()
+    : myOSystem.settings().getFloat("speed");
+
   ss
     << std::fixed << std::setprecision(1) << framesPerSecond
     << "fps @ "
-    << std::fixed << std::setprecision(0) << 100 * myOSystem.settings().getFloat("speed")
-    << "% speed";
+    << std::fixed << std::setprecision(0) << 100 * speed
+    << (fastForward ? "% speed (fast-forward)" : "% speed");
 
   myStatsMsg.surface->drawString(f, ss.str(), xPos, yPos,
       myStatsMsg.w, myStatsMsg.color, TextAlign::Left, 0, true, kBGColor);
@@ -517,6 +536,18 @@ void FrameBuffer::drawFrameStats(float framesPerSecond)
   myStatsMsg.surface->drawString(f, ss.str(), xPos, yPos,
       myStatsMsg.w, myStatsMsg.color, TextAlign::Left, 0, true, kBGColor);
 
+#ifdef PERFCOUNTER_SUPPORT
+  // Performance counters over the last second
+  const PerfCounters::Sampler& sampler = myOSystem.perfSampler();
+  for(const string& line: PerfCounters::summary(sampler.lastInterval(),
+                                                sampler.lastIntervalSeconds()))
+  {
+    yPos += dy;
+    myStatsMsg.surface->drawString(f, line, xPos, yPos,
+        myStatsMsg.w, myStatsMsg.color, TextAlign::Left, 0, true, kBGColor);
+  }
+#endif
+
   myStatsMsg.surface->setDstPos(myImageRect.x() + 10, myImageRect.y() + 8);
   myStatsMsg.surface->setDstSize(myStatsMsg.w * hidpiScaleFactor(),
                                  myStatsMsg.h * hidpiScaleFactor());
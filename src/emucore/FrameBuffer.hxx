@@ -600,6 +600,10 @@ class FrameBuffer
     bool myStatsEnabled{false};
     uInt32 myLastScanlines{0};
 
+    // Whether the screen still shows the last emulation frame, without any
+    // messages on top of it; if so, unchanged frames don't need to be presented
+    bool myPlainFramePresented{false};
+
     bool myGrabMouse{false};
     bool myHiDPIAllowed{false};
     bool myHiDPIEnabled{false};
@@ -48,6 +48,7 @@
 #include "System.hxx"
 #include "M6502.hxx"
 #include "DispatchResult.hxx"
+#include "PerfCounters.hxx"
 #include "exception/EmulationWarning.hxx"
 #include "exception/FatalEmulationError.hxx"
 
@@ -123,6 +124,10 @@ inline uInt8 M6502::peek(uInt16 address, uInt8 flags)
   myLastPeekAddress = address;
 
 #ifdef DEBUGGER_SUPPORT
+  if(myTraceRecorder && myTraceRecorder->busAccesses())
+    myTraceRecorder->recordAccess(TraceRecorder::Kind::read, address, result,
+                                  mySystem->cycles());
+
   if(myReadTraps.isInitialized() && myReadTraps.isSet(address)
      && (myGhostReadsTrap || flags != DISASM_NONE))
   {
@@ -160,6 +165,10 @@ inline void M6502::poke(uInt16 address, uInt8 value, uInt8 flags)
   myLastPokeAddress = address;
 
 #ifdef DEBUGGER_SUPPORT
+  if(myTraceRecorder && myTraceRecorder->busAccesses())
+    myTraceRecorder->recordAccess(TraceRecorder::Kind::write, address, value,
+                                  mySystem->cycles());
+
   if(myWriteTraps.isInitialized() && myWriteTraps.isSet(address))
   {
     myLastPokeBaseAddress = myDebugger->getBaseAddress(myLastPokeAddress, false); // mirror handling
@@ -197,6 +206,8 @@ void M6502::execute(uInt64 number, DispatchResult& result)
 {
   _execute(number, result);
 
+  PERF_COUNT(cpuCycles, result.getCycles());
+
 #ifdef DEBUGGER_SUPPORT
   // Debugger hack: this ensures that stepping a "STA WSYNC" will actually end at the
   // beginning of the next line (otherwise, the next instruction would be stepped in order for
@@ -298,6 +309,25 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
       }
 
       mySystem->cart().clearAllRAMAccesses();
+
+      if(myTraceRecorder)
+      {
+        // The beam position is only valid once the TIA has caught up
+        tia.updateEmulation();
+        myTraceRecorder->recordInstruction(PC, mySystem->cart().getBank(PC),
+            A, X, Y, SP, PS(), mySystem->cycles(),
+            tia.scanlines(), tia.clocksThisLine());
+      }
+
+      if(myProfiler)
+      {
+        if(myProfiler->scanlines())
+        {
+          tia.updateEmulation();
+          myProfiler->setScanline(tia.scanlines());
+        }
+        myProfiler->begin(PC, mySystem->cart().getBank(PC), mySystem->cycles());
+      }
   #endif  // DEBUGGER_SUPPORT
 
       // Reset the peek/poke address pointers
@@ -326,6 +356,14 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
         }
 
     #ifdef DEBUGGER_SUPPORT
+        if(myProfiler)
+        {
+          // Resolve a pending halt now, so the cycles spent waiting are
+          // attributed to the instruction which requested it (STA WSYNC)
+          handleHalt();
+          myProfiler->end(mySystem->cycles());
+        }
+
         if(myReadFromWritePortBreak)
         {
           uInt16 rwpAddr = mySystem->cart().getIllegalRAMReadAccess();
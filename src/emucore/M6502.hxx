@@ -31,6 +31,8 @@ class DispatchResult;
   #include "Expression.hxx"
   #include "TrapArray.hxx"
   #include "BreakpointMap.hxx"
+  #include "TraceRecorder.hxx"
+  #include "CycleProfiler.hxx"
 #endif
 
 #include "bspf.hxx"
@@ -50,9 +52,11 @@ class DispatchResult;
 */
 class M6502 : public Serializable
 {
-  // The 6502 and Cart debugger classes are friends who need special access
+  // The 6502 and Cart debugger classes and the differential runner are
+  // friends who need special access
   friend class CartDebug;
   friend class CpuDebug;
+  friend class DifferentialRunner;
 
   public:
 
@@ -240,6 +244,18 @@ class M6502 : public Serializable
     void setGhostReadsTrap(bool enable) { myGhostReadsTrap = enable; }
     void setReadFromWritePortBreak(bool enable) { myReadFromWritePortBreak = enable; }
     void setWriteToReadPortBreak(bool enable) { myWriteToReadPortBreak = enable; }
+
+    // Start (or, with a null pointer, stop) recording an execution trace
+    void setTraceRecorder(unique_ptr<TraceRecorder> recorder) {
+      myTraceRecorder = std::move(recorder);
+    }
+    const TraceRecorder* traceRecorder() const { return myTraceRecorder.get(); }
+
+    // Start (or, with a null pointer, stop) profiling the executed cycles
+    void setProfiler(unique_ptr<CycleProfiler> profiler) {
+      myProfiler = std::move(profiler);
+    }
+    const CycleProfiler* profiler() const { return myProfiler.get(); }
 #endif  // DEBUGGER_SUPPORT
 
   private:
@@ -448,6 +464,12 @@ class M6502 : public Serializable
     StringList myCondSaveStateNames;
     vector<unique_ptr<Expression>> myTrapConds;
     StringList myTrapCondNames;
+
+    // Records an execution trace, if enabled
+    unique_ptr<TraceRecorder> myTraceRecorder;
+
+    // Counts the cycles executed per address, if enabled
+    unique_ptr<CycleProfiler> myProfiler;
 #endif  // DEBUGGER_SUPPORT
 
     bool myGhostReadsTrap{false};          // trap on ghost reads
@@ -0,0 +1,128 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef MUSIC_SYNTH_HXX
+#define MUSIC_SYNTH_HXX
+
+#include "bspf.hxx"
+
+/**
+  The music mode data fetchers shared by the DPC, DPC+, CDF, BUS and CTY
+  schemes.  A fixed-rate oscillator (nominally 20 kHz) clocks three
+  voices, each of which adds its frequency to a 32-bit phase counter on
+  every oscillator clock.
+
+  The voices are only advanced when the cart reads a music register, by
+  however many oscillator clocks have elapsed since the previous read.
+  Elapsed 6507 cycles are converted to clocks in exactly the same way (and
+  with the same floating-point rounding) as the original per-scheme code,
+  carrying the fractional clock over to the next read.
+*/
+class MusicSynth
+{
+  public:
+    // Default oscillator rate, in Hz
+    static constexpr double DEFAULT_RATE = 20000.0;
+
+    // 6507 clock rate, in Hz, used to convert cycles to clocks
+    static constexpr double CYCLE_RATE = 1193191.66666667;
+
+  public:
+    explicit MusicSynth(double rate = DEFAULT_RATE) : myRate(rate) { }
+
+    /**
+      Restart the oscillator at the given system cycle, dropping any
+      fractional clock.  The voices are left alone.
+    */
+    void reset(uInt64 cycles = 0) { myLastCycles = cycles; myFractionalClocks = 0.0; }
+
+    /**
+      Change the oscillator rate; it takes effect from the next update.
+    */
+    void setRate(double rate) { myRate = rate; }
+
+    /**
+      Answer the number of whole oscillator clocks that elapsed between the
+      previous call and the given system cycle.
+    */
+    uInt32 clocks(uInt64 cycles)
+    {
+      const uInt32 elapsed = uInt32(cycles - myLastCycles);
+      myLastCycles = cycles;
+
+      const double clocks = ((myRate * elapsed) / CYCLE_RATE) + myFractionalClocks;
+      const uInt32 whole = uInt32(clocks);
+      myFractionalClocks = clocks - double(whole);
+
+      return whole;
+    }
+
+    /**
+      Advance the three voices up to the given system cycle.
+    */
+    void update(uInt64 cycles)
+    {
+      const uInt32 whole = clocks(cycles);
+
+      if(whole > 0)
+        for(int x = 0; x < 3; ++x)
+          myCounters[x] += myFrequencies[x] * whole;
+    }
+
+    /**
+      The phase counter and frequency of the given voice (0 - 2).
+    */
+    uInt32& counter(uInt8 voice) { return myCounters[voice]; }
+    uInt32 counter(uInt8 voice) const { return myCounters[voice]; }
+    uInt32& frequency(uInt8 voice) { return myFrequencies[voice]; }
+    uInt32 frequency(uInt8 voice) const { return myFrequencies[voice]; }
+
+    /**
+      The phase counters and frequencies of all three voices.
+    */
+    std::array<uInt32, 3>& counters() { return myCounters; }
+    const std::array<uInt32, 3>& counters() const { return myCounters; }
+    std::array<uInt32, 3>& frequencies() { return myFrequencies; }
+    const std::array<uInt32, 3>& frequencies() const { return myFrequencies; }
+
+    /**
+      Accessors for state saving.
+    */
+    uInt64 lastCycles() const { return myLastCycles; }
+    void setLastCycles(uInt64 cycles) { myLastCycles = cycles; }
+
+    double fractionalClocks() const { return myFractionalClocks; }
+    void setFractionalClocks(double clocks) { myFractionalClocks = clocks; }
+
+  private:
+    // The phase counters of the voices
+    std::array<uInt32, 3> myCounters{0};
+
+    // The frequencies (phase increment per oscillator clock) of the voices
+    std::array<uInt32, 3> myFrequencies{0};
+
+    // System cycle count of the last update
+    uInt64 myLastCycles{0};
+
+    // Fraction of an oscillator clock left over from the last update
+    double myFractionalClocks{0.0};
+
+    // Oscillator rate, in Hz
+    double myRate{DEFAULT_RATE};
+};
+
+#endif
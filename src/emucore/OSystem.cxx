@@ -17,6 +17,7 @@
 
 #include <cassert>
 #include <functional>
+#include <iomanip>
 
 #include "bspf.hxx"
 #include "Logger.hxx"
@@ -52,6 +53,7 @@
 #include "TIAConstants.hxx"
 #include "Settings.hxx"
 #include "PropsSet.hxx"
+#include "ConsolePreloader.hxx"
 #include "EventHandler.hxx"
 #include "PNGLibrary.hxx"
 #include "Console.hxx"
@@ -63,6 +65,8 @@
 #include "DispatchResult.hxx"
 #include "EmulationWorker.hxx"
 #include "AudioSettings.hxx"
+#include "AudioQueue.hxx"
+#include "EmulationTiming.hxx"
 #include "repository/KeyValueRepositoryNoop.hxx"
 #include "repository/KeyValueRepositoryConfigfile.hxx"
 #include "M6532.hxx"
@@ -73,6 +77,7 @@ using namespace std::chrono;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 OSystem::OSystem()
+  : myStartTime(high_resolution_clock::now())
 {
   // Get built-in features
   #ifdef SOUND_SUPPORT
@@ -90,6 +95,9 @@ OSystem::OSystem()
   #ifdef PNG_SUPPORT
     myFeatures += "PNG ";
   #endif
+  #ifdef PERFCOUNTER_SUPPORT
+    myFeatures += "PerfCounters ";
+  #endif
   #ifdef ZIP_SUPPORT
     myFeatures += "ZIP";
   #endif
@@ -138,6 +146,14 @@ bool OSystem::create()
       << FilesystemNode(myPaletteFile).getShortPath() << "'" << endl;
   Logger::info(buf.str());
 
+  // The databases are parsed in the background, while the video and audio
+  // subsystems are initialized; the first lookup waits for them
+  myPropSet->load(myPropertiesFile);
+#ifdef CHEATCODE_SUPPORT
+  myCheatManager = make_unique<CheatManager>(*this);
+  myCheatManager->loadCheatDatabase();
+#endif
+
   // NOTE: The framebuffer MUST be created before any other object!!!
   // Get relevant information about the video hardware
   // This must be done before any graphics context is created, since
@@ -146,6 +162,7 @@ bool OSystem::create()
   catch(...) { return false; }
   if(!myFrameBuffer->initialize())
     return false;
+  traceStartup("video");
 
   // Create the event handler for the system
   myEventHandler = MediaFactory::createEventHandler(*this);
@@ -163,30 +180,77 @@ bool OSystem::create()
   // Create random number generator
   myRandom = make_unique<Random>(uInt32(TimerManager::getTicks()));
 
-#ifdef CHEATCODE_SUPPORT
-  myCheatManager = make_unique<CheatManager>(*this);
-  myCheatManager->loadCheatDatabase();
-#endif
-
-#ifdef GUI_SUPPORT
-  // Create various subsystems (menu and launcher GUI objects, etc)
-  myMenu = make_unique<Menu>(*this);
-  myCommandMenu = make_unique<CommandMenu>(*this);
-  myMessageMenu = make_unique<MessageMenu>(*this);
-  myTimeMachine = make_unique<TimeMachine>(*this);
-  myLauncher = make_unique<Launcher>(*this);
-#endif
-
 #ifdef PNG_SUPPORT
   // Create PNG handler
   myPNGLib = make_unique<PNGLibrary>(*this);
 #endif
+  traceStartup("subsystems");
 
-  myPropSet->load(myPropertiesFile);
+#ifdef PERFCOUNTER_SUPPORT
+  const string& perfCSV = mySettings->getString("perfcsv");
+  if(!myPerfSampler.logToCSV(perfCSV))
+    Logger::error("ERROR: Couldn't open performance counter log '" + perfCSV + "'");
+#endif
 
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ConsolePreloader& OSystem::consolePreloader() const
+{
+  if(!myConsolePreloader)
+    myConsolePreloader = make_unique<ConsolePreloader>(*mySettings, *myPropSet);
+
+  return *myConsolePreloader;
+}
+
+#ifdef GUI_SUPPORT
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Menu& OSystem::menu() const
+{
+  if(!myMenu)
+    myMenu = make_unique<Menu>(const_cast<OSystem&>(*this));
+
+  return *myMenu;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+CommandMenu& OSystem::commandMenu() const
+{
+  if(!myCommandMenu)
+    myCommandMenu = make_unique<CommandMenu>(const_cast<OSystem&>(*this));
+
+  return *myCommandMenu;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+MessageMenu& OSystem::messageMenu() const
+{
+  if(!myMessageMenu)
+    myMessageMenu = make_unique<MessageMenu>(const_cast<OSystem&>(*this));
+
+  return *myMessageMenu;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Launcher& OSystem::launcher() const
+{
+  if(!myLauncher)
+    myLauncher = make_unique<Launcher>(const_cast<OSystem&>(*this));
+
+  return *myLauncher;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TimeMachine& OSystem::timeMachine() const
+{
+  if(!myTimeMachine)
+    myTimeMachine = make_unique<TimeMachine>(const_cast<OSystem&>(*this));
+
+  return *myTimeMachine;
+}
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void OSystem::loadConfig(const Settings::Options& options)
 {
@@ -230,6 +294,8 @@ void OSystem::loadConfig(const Settings::Options& options)
 
   // Get updated paths for all configuration files
   setConfigPaths();
+
+  traceStartup("settings");
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -344,7 +410,7 @@ FBInitStatus OSystem::createFrameBuffer()
 
   #ifdef GUI_SUPPORT
     case EventHandlerState::LAUNCHER:
-      if((fbstatus = myLauncher->initializeVideo()) != FBInitStatus::Success)
+      if((fbstatus = launcher().initializeVideo()) != FBInitStatus::Success)
         return fbstatus;
       break;
   #endif
@@ -404,7 +470,8 @@ string OSystem::createConsole(const FilesystemNode& rom, const string& md5sum,
   try
   {
     closeConsole();
-    myConsole = openConsole(myRomFile, myRomMD5);
+    // A reload always reads the file again, it may have been rebuilt
+    myConsole = openConsole(myRomFile, myRomMD5, newrom);
   }
   catch(const runtime_error& e)
   {
@@ -453,6 +520,7 @@ string OSystem::createConsole(const FilesystemNode& rom, const string& md5sum,
         << "  ROM file: " << myRomFile.getShortPath() << endl << endl
         << getROMInfo(*myConsole);
     Logger::info(buf.str());
+    traceStartup("console");
 
     myFrameBuffer->setCursorState();
 
@@ -495,8 +563,9 @@ bool OSystem::createLauncher(const string& startdir)
   myEventHandler->reset(EventHandlerState::LAUNCHER);
   if(createFrameBuffer() == FBInitStatus::Success)
   {
-    myLauncher->reStack();
+    launcher().reStack();
     myFrameBuffer->setCursorState();
+    traceStartup("launcher");
 
     status = true;
   }
@@ -534,14 +603,38 @@ void OSystem::resetFps()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-unique_ptr<Console> OSystem::openConsole(const FilesystemNode& romfile, string& md5)
+unique_ptr<Console> OSystem::openConsole(const FilesystemNode& romfile, string& md5,
+                                         bool usePreload)
 {
   unique_ptr<Console> console;
 
+  // Use the results of preloading the ROM from the launcher, if available
+  shared_ptr<const ConsolePreloader::Preload> preload;
+  if(myConsolePreloader && usePreload)
+  {
+    preload = myConsolePreloader->get(romfile);
+    if(preload && md5 != "" && md5 != preload->md5)
+      preload.reset();
+  }
+
   // Open the cartridge image and read it in
   ByteBuffer image;
   size_t size = 0;
-  if((image = openROM(romfile, md5, size)) != nullptr)
+  if(preload)
+  {
+    md5  = preload->md5;
+    size = preload->size;
+    image = make_unique<uInt8[]>(size);
+    std::copy_n(preload->image.get(), size, image.get());
+
+    // Same side-effect as in 'openROM'
+    Properties props;
+    myPropSet->getMD5WithInsert(romfile, md5, props);
+  }
+  else
+    image = openROM(romfile, md5, size);
+
+  if(image != nullptr)
   {
     // Get a valid set of properties, including any entered on the commandline
     // For initial creation of the Cart, we're only concerned with the BS type
@@ -601,9 +694,16 @@ unique_ptr<Console> OSystem::openConsole(const FilesystemNode& romfile, string&
     CMDLINE_PROPS_UPDATE("pp", PropType::Display_Phosphor);
     CMDLINE_PROPS_UPDATE("ppblend", PropType::Display_PPBlend);
 
+    // The preloaded frame layout is only valid for the same cart
+    string detectedFormat;
+    if(preload && cartmd5 == md5 && preload->cartType == type &&
+       preload->startBank == props.get(PropType::Cart_StartBank))
+      detectedFormat = preload->displayFormat;
+
     // Finally, create the cart with the correct properties
     if(cart)
-      console = make_unique<Console>(*this, cart, props, *myAudioSettings);
+      console = make_unique<Console>(*this, cart, props, *myAudioSettings,
+                                     detectedFormat);
   }
 
   return console;
@@ -680,10 +780,16 @@ double OSystem::dispatchEmulation(EmulationWorker& emulationWorker)
   EmulationTiming& timing(myConsole->emulationTiming());
   DispatchResult dispatchResult;
 
+  // When fast-forwarding, emulate as fast as possible while the frame is rendered,
+  // but for no longer than a frame, in order to keep the UI responsive
+  const bool fastForward = myEventHandler->fastForwarding();
+  myConsole->enableFastForward(fastForward);
+
   // Check whether we have a frame pending for rendering...
   bool framePending = tia.newFramePending();
-  // ... and copy it to the frame buffer. It is important to do this before
-  // the worker is started to avoid racing.
+  // ... and hand it over to the frame buffer. This doesn't copy any pixels,
+  // and the TIA never draws to the frame buffer, so we can render it while
+  // the worker is running.
   if (framePending) {
     myFpsMeter.render(tia.framesSinceLastRender());
     tia.renderToFrameBuffer();
@@ -696,16 +802,27 @@ double OSystem::dispatchEmulation(EmulationWorker& emulationWorker)
     timing.maxCyclesPerTimeslice(),
     timing.minCyclesPerTimeslice(),
     &dispatchResult,
-    &tia
+    &tia,
+    fastForward
+      ? static_cast<double>(timing.cyclesPerFrame()) / static_cast<double>(timing.cyclesPerSecond())
+      : 0.
   );
 
   // Render the frame. This may block, but emulation will continue to run on the worker, so the
   // audio pipeline is kept fed :)
-  if (framePending) myFrameBuffer->updateInEmulationMode(myFpsMeter.fps());
+  if (framePending) {
+    PERF_TIME(renderTime);
+    myFrameBuffer->updateInEmulationMode(myFpsMeter.fps());
+  }
+  if (framePending && !myStartTraceDone) finishStartupTrace();
 
   // Stop the worker and wait until it has finished
   uInt64 totalCycles = emulationWorker.stop();
 
+#ifdef PERFCOUNTER_SUPPORT
+  myPerfSampler.update();
+#endif
+
   // Handle the dispatch result
   switch (dispatchResult.getStatus()) {
     case DispatchResult::Status::ok:
@@ -742,6 +859,39 @@ double OSystem::dispatchEmulation(EmulationWorker& emulationWorker)
   return static_cast<double>(totalCycles) / static_cast<double>(timing.cyclesPerSecond());
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystem::traceStartup(const string& phase)
+{
+  if(myStartTraceDone) return;
+
+  myStartTrace.emplace_back(phase,
+    duration_cast<duration<double>>(high_resolution_clock::now() - myStartTime).count());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystem::finishStartupTrace()
+{
+  traceStartup("first frame");
+  myStartTraceDone = true;
+
+  if(!mySettings->getBool("starttrace")) return;
+
+  ostringstream buf;
+  buf << "Startup timing:" << endl << std::fixed << std::setprecision(1);
+
+  double last = 0;
+  for(const auto& phase: myStartTrace)
+  {
+    buf << "  " << std::left << std::setw(14) << phase.first << std::right
+        << std::setw(8) << (phase.second - last) * 1000 << " ms"
+        << std::setw(10) << phase.second * 1000 << " ms total" << endl;
+    last = phase.second;
+  }
+  myStartTrace.clear();
+
+  Logger::info(buf.str());
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void OSystem::mainLoop()
 {
@@ -766,13 +916,29 @@ void OSystem::mainLoop()
 
     double timesliceSeconds;
 
-    if (myEventHandler->state() == EventHandlerState::EMULATION)
+    if (myEventHandler->state() == EventHandlerState::EMULATION) {
       // Dispatch emulation and render frame (if applicable)
       timesliceSeconds = dispatchEmulation(emulationWorker);
+
+      // If the sound driver drives emulation (dynamic rate control), we don't
+      // run ahead of it: audio queued beyond its target postpones the next timeslice
+      if (myConsole) {
+        const EmulationTiming& timing(myConsole->emulationTiming());
+        timesliceSeconds += static_cast<double>(myConsole->audioQueue().surplus() * timing.audioFragmentSize()) /
+          static_cast<double>(timing.audioSampleRate());
+      }
+    }
     else {
       // Render the GUI with 60 Hz in all other modes
       timesliceSeconds = 1. / 60.;
       myFrameBuffer->update();
+      if (!myStartTraceDone) finishStartupTrace();
+    }
+
+    // When fast-forwarding, the worker already took its time; don't wait for 6507 time
+    if (myEventHandler->state() == EventHandlerState::EMULATION && myEventHandler->fastForwarding()) {
+      virtualTime = high_resolution_clock::now();
+      continue;
     }
 
     duration<double> timeslice(timesliceSeconds);
@@ -23,6 +23,7 @@ class FrameBuffer;
 class EventHandler;
 class Properties;
 class PropertiesSet;
+class ConsolePreloader;
 class Random;
 class Sound;
 class StateManager;
@@ -56,6 +57,7 @@ class AudioSettings;
 #include "FrameBufferConstants.hxx"
 #include "EventHandlerConstants.hxx"
 #include "FpsMeter.hxx"
+#include "PerfCounters.hxx"
 #include "Settings.hxx"
 #include "Logger.hxx"
 #include "bspf.hxx"
@@ -132,6 +134,14 @@ class OSystem
     */
     PropertiesSet& propSet() const { return *myPropSet; }
 
+    /**
+      Get the preloader which prepares ROMs highlighted in the launcher.
+      It is created (and its thread started) when first used.
+
+      @return The console preloader object
+    */
+    ConsolePreloader& consolePreloader() const;
+
     /**
       Get the console of the system.  The console won't always exist,
       so we should test if it's available.
@@ -162,6 +172,13 @@ class OSystem
     */
     TimerManager& timer() const { return *myTimerManager; }
 
+    /**
+      Get the per second deltas of the performance counters.
+
+      @return The performance counter sampler
+    */
+    const PerfCounters::Sampler& perfSampler() const { return myPerfSampler; }
+
     /**
       This method should be called to initiate the process of loading settings
       from the config file.  It takes care of loading settings, applying
@@ -195,40 +212,42 @@ class OSystem
   #endif
 
   #ifdef GUI_SUPPORT
+    // The GUI objects below are only created when first used
+
     /**
       Get the settings menu of the system.
 
       @return The settings menu object
     */
-    Menu& menu() const { return *myMenu; }
+    Menu& menu() const;
 
     /**
       Get the command menu of the system.
 
       @return The command menu object
     */
-    CommandMenu& commandMenu() const { return *myCommandMenu; }
+    CommandMenu& commandMenu() const;
 
     /**
       Get the message menu of the system.
 
       @return The message menu object
     */
-    MessageMenu& messageMenu() const { return *myMessageMenu; }
+    MessageMenu& messageMenu() const;
 
     /**
       Get the ROM launcher of the system.
 
       @return The launcher object
     */
-    Launcher& launcher() const { return *myLauncher; }
+    Launcher& launcher() const;
 
     /**
       Get the time machine of the system (manages state files).
 
       @return The time machine object
     */
-    TimeMachine& timeMachine() const { return *myTimeMachine; }
+    TimeMachine& timeMachine() const;
   #endif
 
   #ifdef PNG_SUPPORT
@@ -473,6 +492,9 @@ class OSystem
     // Pointer to the PropertiesSet object
     unique_ptr<PropertiesSet> myPropSet;
 
+    // Pointer to the ConsolePreloader object
+    mutable unique_ptr<ConsolePreloader> myConsolePreloader;
+
     // Pointer to the (currently defined) Console object
     unique_ptr<Console> myConsole;
 
@@ -491,19 +513,19 @@ class OSystem
 
   #ifdef GUI_SUPPORT
     // Pointer to the Menu object
-    unique_ptr<Menu> myMenu;
+    mutable unique_ptr<Menu> myMenu;
 
     // Pointer to the CommandMenu object
-    unique_ptr<CommandMenu> myCommandMenu;
+    mutable unique_ptr<CommandMenu> myCommandMenu;
 
     // Pointer to the CommandMenu object
-    unique_ptr<MessageMenu> myMessageMenu;
+    mutable unique_ptr<MessageMenu> myMessageMenu;
 
     // Pointer to the Launcher object
-    unique_ptr<Launcher> myLauncher;
+    mutable unique_ptr<Launcher> myLauncher;
 
     // Pointer to the TimeMachine object
-    unique_ptr<TimeMachine> myTimeMachine;
+    mutable unique_ptr<TimeMachine> myTimeMachine;
   #endif
 
   #ifdef PNG_SUPPORT
@@ -546,6 +568,15 @@ class OSystem
     static constexpr uInt32 FPS_METER_QUEUE_SIZE = 100;
     FpsMeter myFpsMeter{FPS_METER_QUEUE_SIZE};
 
+    // Turns the performance counters into per second deltas
+    PerfCounters::Sampler myPerfSampler;
+
+    // The phases of startup and the time at which each of them ended,
+    // for '-starttrace'
+    std::chrono::time_point<std::chrono::high_resolution_clock> myStartTime;
+    vector<std::pair<string, double>> myStartTrace;
+    bool myStartTraceDone{false};
+
     // If not empty, a hint for derived classes to use this as the
     // base directory (where all settings are stored)
     // Derived classes are free to ignore it and use their own defaults
@@ -565,12 +596,14 @@ class OSystem
     /**
       Creates an actual Console object based on the given info.
 
-      @param romfile  The file node of the ROM to use (contains path)
-      @param md5      The MD5sum of the ROM
+      @param romfile     The file node of the ROM to use (contains path)
+      @param md5         The MD5sum of the ROM
+      @param usePreload  Whether the results of preloading the ROM may be used
 
       @return  The actual Console object, otherwise nullptr.
     */
-    unique_ptr<Console> openConsole(const FilesystemNode& romfile, string& md5);
+    unique_ptr<Console> openConsole(const FilesystemNode& romfile, string& md5,
+                                    bool usePreload = true);
 
     /**
       Close and finalize any currently open console.
@@ -587,6 +620,19 @@ class OSystem
 
     double dispatchEmulation(EmulationWorker& emulationWorker);
 
+    /**
+      Record the end of a startup phase, for '-starttrace'.
+
+      @param phase  The phase which just ended
+    */
+    void traceStartup(const string& phase);
+
+    /**
+      Record the first frame as the end of startup, and print the startup
+      timing if requested by '-starttrace'.
+    */
+    void finishStartupTrace();
+
     // Following constructors and assignment operators not supported
     OSystem(const OSystem&) = delete;
     OSystem(OSystem&&) = delete;
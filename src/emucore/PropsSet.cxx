@@ -23,19 +23,41 @@
 #include "Props.hxx"
 #include "PropsSet.hxx"
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+PropertiesSet::~PropertiesSet()
+{
+  waitForLoad();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PropertiesSet::load(const string& filename)
 {
-  ifstream in(filename);
+  waitForLoad();
+
+  myLoader = std::thread([this, filename]() {
+    ifstream in(filename);
 
-  Properties prop;
-  while(in >> prop)
-    insert(prop);
+    Properties prop;
+    while(in >> prop)
+      insertProperties(prop, true);
+  });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PropertiesSet::waitForLoad() const
+{
+  std::lock_guard<std::mutex> lock(myLoaderMutex);
+
+  if(myLoader.joinable())
+    myLoader.join();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool PropertiesSet::save(const string& filename) const
 {
+  waitForLoad();
+  std::lock_guard<std::mutex> lock(myMutex);
+
   // Only save properties when it won't create an empty file
   FilesystemNode props(filename);
   if(!props.exists() && myExternalProps.size() == 0)
@@ -55,6 +77,16 @@ bool PropertiesSet::save(const string& filename) const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool PropertiesSet::getMD5(const string& md5, Properties& properties,
                            bool useDefaults) const
+{
+  waitForLoad();
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  return findMD5(md5, properties, useDefaults);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool PropertiesSet::findMD5(const string& md5, Properties& properties,
+                            bool useDefaults) const
 {
   properties.setDefaults();
   bool found = false;
@@ -139,6 +171,15 @@ void PropertiesSet::getMD5WithInsert(const FilesystemNode& rom,
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PropertiesSet::insert(const Properties& properties, bool save)
+{
+  waitForLoad();
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  insertProperties(properties, save);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PropertiesSet::insertProperties(const Properties& properties, bool save)
 {
   // Note that the following code is optimized for insertion when an item
   // doesn't already exist, and when the external properties file is
@@ -156,9 +197,9 @@ void PropertiesSet::insert(const Properties& properties, bool save)
 
   // Make sure the exact entry isn't already in any list
   Properties defaultProps;
-  if(getMD5(md5, defaultProps, false) && defaultProps == properties)
+  if(findMD5(md5, defaultProps, false) && defaultProps == properties)
     return;
-  else if(getMD5(md5, defaultProps, true) && defaultProps == properties)
+  else if(findMD5(md5, defaultProps, true) && defaultProps == properties)
   {
     myExternalProps.erase(md5);
     return;
@@ -179,6 +220,9 @@ void PropertiesSet::insert(const Properties& properties, bool save)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PropertiesSet::print() const
 {
+  waitForLoad();
+  std::lock_guard<std::mutex> lock(myMutex);
+
   // We only look at the external properties and the built-in ones;
   // the temp properties are ignored
   // Also, any properties entries in the external file override the built-in
@@ -19,6 +19,8 @@
 #define PROPERTIES_SET_HXX
 
 #include <map>
+#include <mutex>
+#include <thread>
 
 class FilesystemNode;
 class OSystem;
@@ -34,6 +36,9 @@ class OSystem;
   the game rom image (essentially a different game) and this would
   necessitate a new entry in the stella.pro file anyway.
 
+  The set may be queried and updated from several threads (the ROM
+  launcher preloads ROMs in the background).
+
   @author  Stephen Anthony
 */
 class PropertiesSet
@@ -42,11 +47,13 @@ class PropertiesSet
     /**
       Trivial constructor.
     */
-   PropertiesSet() = default;
+    PropertiesSet() = default;
+    ~PropertiesSet();
 
     /**
       Load properties from the specified file, and create an internal
-      searchable list.
+      searchable list.  The file is parsed in the background; all other
+      methods wait until it has been parsed.
 
       @param filename  Full pathname of input file to use
     */
@@ -106,6 +113,20 @@ class PropertiesSet
     */
     void print() const;
 
+  private:
+    /**
+      Wait until the file given to load() has been parsed.
+    */
+    void waitForLoad() const;
+
+    /**
+      Implementations of getMD5() and insert(), which may be used while
+      loading.
+    */
+    bool findMD5(const string& md5, Properties& properties,
+                 bool useDefaults) const;
+    void insertProperties(const Properties& properties, bool save);
+
   private:
     using PropsList = std::map<string, Properties>;
 
@@ -116,6 +137,15 @@ class PropertiesSet
     // be discarded when the program ends
     PropsList myTempProps;
 
+    // Parses the file given to load()
+    mutable std::thread myLoader;
+
+    // Serializes waiting for the loader
+    mutable std::mutex myLoaderMutex;
+
+    // Guards the lists once they have been loaded
+    mutable std::mutex myMutex;
+
   private:
     // Following constructors and assignment operators not supported
     PropertiesSet(const PropertiesSet&) = delete;
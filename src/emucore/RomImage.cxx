@@ -0,0 +1,73 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <map>
+#include <mutex>
+
+#include "MD5.hxx"
+#include "RomImage.hxx"
+
+namespace {
+  // All shared images, keyed by their MD5 and size
+  std::map<string, std::weak_ptr<uInt8>> ourImages;
+  std::mutex ourMutex;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomImage::allocate(size_t size)
+{
+  myData = shared_ptr<uInt8>(new uInt8[size](), std::default_delete<uInt8[]>());
+  mySize = size;
+  myShared = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomImage::share()
+{
+  if(myShared || mySize == 0)
+    return;
+
+  const string key = MD5::hash(myData.get(), mySize) + ":" + std::to_string(mySize);
+
+  std::lock_guard<std::mutex> lock(ourMutex);
+
+  // Forget about images which have been freed in the meantime
+  for(auto it = ourImages.begin(); it != ourImages.end(); )
+    it = it->second.expired() ? ourImages.erase(it) : std::next(it);
+
+  auto& shared = ourImages[key];
+  if(auto image = shared.lock())
+    myData = image;
+  else
+    shared = myData;
+
+  myShared = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomImage::unshare()
+{
+  if(!myShared)
+    return false;
+
+  shared_ptr<uInt8> image(new uInt8[mySize], std::default_delete<uInt8[]>());
+  std::copy_n(myData.get(), mySize, image.get());
+  myData = image;
+  myShared = false;
+
+  return true;
+}
@@ -0,0 +1,80 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef ROM_IMAGE_HXX
+#define ROM_IMAGE_HXX
+
+#include "bspf.hxx"
+
+/**
+  The ROM image held by a cartridge.  Once a cart has filled in its image,
+  it can be shared: all images with the same contents then map the same
+  read-only memory, which is freed when the last cart using it goes away.
+  This saves memory (and cache) when many consoles run the same ROM.
+
+  A shared image must not be written to; a cart which needs to patch
+  its image must first get a private copy using unshare().
+*/
+class RomImage
+{
+  public:
+    RomImage() = default;
+
+    /**
+      Allocate a new, private image, filled with zeros.
+
+      @param size  The size of the image
+    */
+    void allocate(size_t size);
+
+    /**
+      Replace this image with the shared one holding the same contents,
+      or make it the shared one if there is none yet.
+    */
+    void share();
+
+    /**
+      Make this image private again by copying it, if it is shared.
+      Any pointers into the image become invalid.
+
+      @return  Whether the image was copied
+    */
+    bool unshare();
+
+    /**
+      Answer whether this image is shared (and thus read-only).
+    */
+    bool isShared() const { return myShared; }
+
+    uInt8* get() const { return myData.get(); }
+    uInt8& operator[](size_t i) const { return myData.get()[i]; }
+    size_t size() const { return mySize; }
+
+  private:
+    shared_ptr<uInt8> myData;
+    size_t mySize{0};
+    bool myShared{false};
+
+  private:
+    // Following constructors and assignment operators not supported
+    RomImage(const RomImage&) = delete;
+    RomImage(RomImage&&) = delete;
+    RomImage& operator=(const RomImage&) = delete;
+    RomImage& operator=(RomImage&&) = delete;
+};
+
+#endif
@@ -85,6 +85,7 @@ Settings::Settings()
   setPermanent(AudioSettings::SETTING_BUFFER_SIZE, AudioSettings::DEFAULT_BUFFER_SIZE);
   setPermanent(AudioSettings::SETTING_STEREO, AudioSettings::DEFAULT_STEREO);
   setPermanent(AudioSettings::SETTING_DPC_PITCH, AudioSettings::DEFAULT_DPC_PITCH);
+  setPermanent(AudioSettings::SETTING_DYNAMIC_RATE, AudioSettings::DEFAULT_DYNAMIC_RATE);
 
   // Input event options
   setPermanent("event_ver", "1");
@@ -156,6 +157,10 @@ Settings::Settings()
   setPermanent("threads", "false");
   setTemporary("romloadcount", "0");
   setTemporary("maxres", "");
+#ifdef PERFCOUNTER_SUPPORT
+  setTemporary("perfcsv", "");
+#endif
+  setTemporary("starttrace", "false");
 
 #ifdef DEBUGGER_SUPPORT
   // Debugger/disassembly options
@@ -413,6 +418,8 @@ void Settings::usage() const
     << "  -audio.buffer_size        <0-20>     Max. number of additional half-\n"
     << "                                        frames to buffer\n"
     << "  -audio.stereo             <1|0>      Enable stereo mode for all ROMs\n"
+    << "  -audio.dynamic_rate       <1|0>      Sync emulation to the audio clock,\n"
+    << "                                        adapting headroom automatically\n"
     << endl
   #endif
     << "  -tia.zoom        <zoom>       Use the specified zoom level (windowed mode)\n"
@@ -447,6 +454,11 @@ void Settings::usage() const
     << "  -loglevel     <0|1|2>        Set level of logging during application run\n"
     << endl
     << "  -logtoconsole <1|0>          Log output to console/commandline\n"
+  #ifdef PERFCOUNTER_SUPPORT
+    << "  -perfcsv      <file>         Append the performance counters to a CSV file\n"
+    << "                                once per second\n"
+  #endif
+    << "  -starttrace   <1|0>          Log the time spent in each phase of startup\n"
     << "  -joydeadzone  <number>       Sets 'deadzone' area for analog joysticks (0-29)\n"
     << "  -joyallow4    <1|0>          Allow all 4 directions on a joystick to be\n"
     << "                                pressed simultaneously\n"
@@ -0,0 +1,256 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <atomic>
+
+#include "StellaEnvironment.hxx"
+#include "BareConsole.hxx"
+#include "FSNode.hxx"
+#include "Serializer.hxx"
+#include "DispatchResult.hxx"
+
+/**
+  A single console, plus the scratch space needed for stepping and
+  snapshots.
+*/
+class StellaEnvironment::Instance : public BareConsole
+{
+  public:
+    Instance(const FilesystemNode& romFile, const ByteBuffer& image, size_t size,
+             Settings& settings, const Properties& props)
+      : BareConsole(createCartridge(romFile, image, size, settings),
+                    settings, props) { }
+
+    void reset();
+
+  public:
+    // Reused for every snapshot to avoid reallocating the stream
+    Serializer myScratch;
+
+    std::array<uInt8, RAM_SIZE> myPrevRam;
+
+  private:
+    // Following constructors and assignment operators not supported
+    Instance() = delete;
+    Instance(const Instance&) = delete;
+    Instance(Instance&&) = delete;
+    Instance& operator=(const Instance&) = delete;
+    Instance& operator=(Instance&&) = delete;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StellaEnvironment::Instance::reset()
+{
+  myEvent.clear();
+  mySystem.reset();
+
+  std::copy_n(myRiot.getRAM(), RAM_SIZE, myPrevRam.begin());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+StellaEnvironment::StellaEnvironment(const string& romFile, uInt32 numConsoles,
+                                     uInt32 numThreads)
+  : myThreadPool(numThreads)
+{
+  FilesystemNode imageFile(romFile);
+
+  if(!imageFile.isFile())
+    throw runtime_error(romFile + " is not a ROM image");
+
+  ByteBuffer image;
+  size_t size = imageFile.read(image);
+  if(size == 0)
+    throw runtime_error("unable to read " + romFile);
+
+  createConsoles(imageFile, image, size, numConsoles);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+StellaEnvironment::StellaEnvironment(const ByteBuffer& image, size_t size,
+                                     uInt32 numConsoles, uInt32 numThreads,
+                                     const Settings::Options& options)
+  : myThreadPool(numThreads)
+{
+  for(const auto& option: options)
+    mySettings.setValue(option.first, option.second);
+
+  createConsoles(FilesystemNode(), image, size, numConsoles);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StellaEnvironment::createConsoles(const FilesystemNode& romFile,
+    const ByteBuffer& image, size_t size, uInt32 numConsoles)
+{
+  mySettings.setValue("fastscbios", true);
+
+  // Cartridge creation consults (and may update) the settings, so the
+  // consoles are built sequentially
+  myConsoles.reserve(numConsoles);
+  for(uInt32 i = 0; i < std::max(numConsoles, 1U); ++i)
+    myConsoles.push_back(make_unique<Instance>(romFile, image, size, mySettings, myProps));
+
+  // All consoles run the same ROM from the same seed, so the layout only
+  // needs to be detected once
+  const FrameLayout layout = myConsoles.front()->detectFrameLayout();
+  for(auto& console : myConsoles)
+    console->setFrameLayout(layout);
+
+  reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+StellaEnvironment::~StellaEnvironment() = default;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StellaEnvironment::reset()
+{
+  myThreadPool.parallelFor(numConsoles(), [this](uInt32 i) {
+    myConsoles[i]->reset();
+  });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StellaEnvironment::step(const uInt8* actions, uInt32 frameskip,
+                             float* rewards, uInt8* ram, uInt8* frames)
+{
+  const uInt32 frameSize = frameWidth() * frameHeight();
+  std::atomic<bool> success{true};
+
+  myThreadPool.parallelFor(numConsoles(), [&](uInt32 i) {
+    Instance& console = *myConsoles[i];
+    float reward = 0;
+
+    for(uInt32 frame = 0; frame < std::max(frameskip, 1U); ++frame)
+      if(!runFrame(console, actions[i], reward))
+      {
+        success = false;
+        break;
+      }
+
+    if(rewards) rewards[i] = reward;
+    if(ram)     std::copy_n(console.myRiot.getRAM(), RAM_SIZE, ram + i * RAM_SIZE);
+    if(frames)  copyFrame(console, frames + i * frameSize);
+  });
+
+  return success;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StellaEnvironment::runFrame(Instance& console, uInt8 action, float& reward)
+{
+  Event& event = console.myEvent;
+
+  event.set(Event::JoystickZeroUp,    (action & Action::Up)     ? 1 : 0);
+  event.set(Event::JoystickZeroDown,  (action & Action::Down)   ? 1 : 0);
+  event.set(Event::JoystickZeroLeft,  (action & Action::Left)   ? 1 : 0);
+  event.set(Event::JoystickZeroRight, (action & Action::Right)  ? 1 : 0);
+  event.set(Event::JoystickZeroFire,  (action & Action::Fire)   ? 1 : 0);
+  event.set(Event::ConsoleReset,      (action & Action::Reset)  ? 1 : 0);
+  event.set(Event::ConsoleSelect,     (action & Action::Select) ? 1 : 0);
+  console.myRiot.update();
+
+  // The TIA stops the CPU at the end of each frame
+  const uInt32 frameCount = console.myFrameManager.frameCount();
+  DispatchResult dispatchResult;
+  do
+  {
+    console.myTIA.update(dispatchResult);
+    if(dispatchResult.getStatus() != DispatchResult::Status::ok)
+      return false;
+  }
+  while(console.myFrameManager.frameCount() == frameCount);
+
+  const uInt8* currentRam = console.myRiot.getRAM();
+  if(myRewardFunction)
+    reward += myRewardFunction(console.myPrevRam.data(), currentRam);
+  std::copy_n(currentRam, RAM_SIZE, console.myPrevRam.begin());
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StellaEnvironment::copyFrame(Instance& console, uInt8* out) const
+{
+  TIA& tia = console.myTIA;
+  tia.renderToFrameBuffer();
+
+  const uInt8* in = tia.frameBuffer();
+  const uInt32 width = frameWidth(), height = frameHeight();
+
+  for(uInt32 y = 0; y < height; ++y)
+  {
+    const uInt8* line = in + y * myDownsampling * tia.width();
+    for(uInt32 x = 0; x < width; ++x)
+      *out++ = line[x * myDownsampling];
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StellaEnvironment::cloneState(uInt32 index, State& state)
+{
+  if(index >= numConsoles()) return false;
+
+  Instance& console = *myConsoles[index];
+  Serializer& scratch = console.myScratch;
+
+  scratch.rewind();
+  if(!console.save(scratch))
+    return false;
+
+  state.data.resize(scratch.size());
+  scratch.rewind();
+  scratch.getByteArray(state.data.data(), state.data.size());
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StellaEnvironment::restoreState(uInt32 index, const State& state)
+{
+  if(index >= numConsoles() || state.data.empty()) return false;
+
+  Instance& console = *myConsoles[index];
+  Serializer& scratch = console.myScratch;
+
+  scratch.rewind();
+  scratch.putByteArray(state.data.data(), state.data.size());
+  scratch.rewind();
+  if(!console.load(scratch))
+    return false;
+
+  std::copy_n(console.myRiot.getRAM(), RAM_SIZE, console.myPrevRam.begin());
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 StellaEnvironment::frameWidth() const
+{
+  return myConsoles.front()->myTIA.width() / myDownsampling;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 StellaEnvironment::frameHeight() const
+{
+  return myConsoles.front()->myTIA.height() / myDownsampling;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+System& StellaEnvironment::system(uInt32 console)
+{
+  return myConsoles[console]->mySystem;
+}
@@ -0,0 +1,184 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef STELLA_ENVIRONMENT_HXX
+#define STELLA_ENVIRONMENT_HXX
+
+#include <functional>
+
+class FilesystemNode;
+class System;
+
+#include "bspf.hxx"
+#include "Settings.hxx"
+#include "Props.hxx"
+#include "ThreadPool.hxx"
+
+/**
+  A vectorized environment for driving many consoles from agent code (e.g.
+  reinforcement learning). All consoles run the same ROM and are stepped in
+  lockstep on an internal thread pool.
+
+  Just like the profiling runner, the consoles are bare System stacks without
+  OSystem, framebuffer or sound, so the per frame overhead is limited to
+  emulation itself. Input is restricted to the left joystick and the console
+  switches.
+
+  Console state can be cloned into and restored from compact in-memory
+  snapshots that contain only the serialized system, controllers and
+  switches (no framebuffers).
+
+  A C interface to this class is available in stella_env.h.  The same bare
+  consoles are also driven directly by the benchmarks (stella-bench).
+*/
+class StellaEnvironment
+{
+  public:
+    /**
+      Actions are a bitmask of joystick directions, fire and console switches.
+     */
+    enum Action: uInt8 {
+      Noop   = 0,
+      Up     = 1 << 0,
+      Down   = 1 << 1,
+      Left   = 1 << 2,
+      Right  = 1 << 3,
+      Fire   = 1 << 4,
+      Reset  = 1 << 5,
+      Select = 1 << 6
+    };
+
+    /**
+      Computes the reward of a single frame from the RIOT RAM before and
+      after the frame.
+     */
+    using RewardFunction = std::function<float(const uInt8* prevRam, const uInt8* ram)>;
+
+    /**
+      A serialized console state.
+     */
+    struct State {
+      vector<uInt8> data;
+    };
+
+    static constexpr uInt32 RAM_SIZE = 128;
+
+  public:
+    /**
+      Create numConsoles consoles running the given ROM. If numThreads is
+      zero, one worker per hardware thread is used.
+
+      Throws runtime_error if the ROM cannot be loaded.
+     */
+    StellaEnvironment(const string& romFile, uInt32 numConsoles, uInt32 numThreads = 0);
+
+    /**
+      Create numConsoles consoles running the given ROM image, with the
+      given settings overriding the defaults.
+
+      Throws runtime_error if no cartridge can be created from the image.
+     */
+    StellaEnvironment(const ByteBuffer& image, size_t size, uInt32 numConsoles,
+                      uInt32 numThreads = 0, const Settings::Options& options = {});
+    ~StellaEnvironment();
+
+    /**
+      Reset all consoles to their power-on state.
+     */
+    void reset();
+
+    /**
+      Apply actions[i] to console i for frameskip frames and accumulate the
+      reward of each frame. All output arrays are provided by the caller and
+      may be nullptr if the information is not needed:
+
+      @param actions    numConsoles() actions
+      @param frameskip  The number of frames to emulate per step (at least 1)
+      @param rewards    numConsoles() accumulated rewards
+      @param ram        numConsoles() * RAM_SIZE bytes of RIOT RAM
+      @param frames     numConsoles() * frameWidth() * frameHeight() palette
+                        indices of the last frame
+
+      @return  False if emulation failed on any console (e.g. the CPU jammed)
+     */
+    bool step(const uInt8* actions, uInt32 frameskip,
+              float* rewards, uInt8* ram = nullptr, uInt8* frames = nullptr);
+
+    /**
+      Snapshot the state of the given console.
+     */
+    bool cloneState(uInt32 console, State& state);
+
+    /**
+      Restore the given console from a snapshot. Snapshots can be restored
+      to any console of the environment.
+     */
+    bool restoreState(uInt32 console, const State& state);
+
+    /**
+      Set the function used to calculate rewards. Without a reward function,
+      all rewards are zero.
+     */
+    void setRewardFunction(const RewardFunction& reward) { myRewardFunction = reward; }
+
+    /**
+      Frames are downsampled by taking every factor'th pixel in both
+      directions.
+     */
+    void setFrameDownsampling(uInt32 factor) { myDownsampling = std::max(factor, 1U); }
+
+    uInt32 numConsoles() const { return uInt32(myConsoles.size()); }
+    uInt32 frameWidth() const;
+    uInt32 frameHeight() const;
+
+    /**
+      The system of the given console, for driving the CPU, TIA or
+      cartridge directly.
+     */
+    System& system(uInt32 console = 0);
+
+  private:
+    class Instance;
+
+    void createConsoles(const FilesystemNode& romFile, const ByteBuffer& image,
+                        size_t size, uInt32 numConsoles);
+
+    bool runFrame(Instance& instance, uInt8 action, float& reward);
+    void copyFrame(Instance& instance, uInt8* out) const;
+
+  private:
+    Settings mySettings;
+    Properties myProps;
+
+    vector<unique_ptr<Instance>> myConsoles;
+
+    ThreadPool myThreadPool;
+
+    RewardFunction myRewardFunction;
+
+    uInt32 myDownsampling{1};
+
+  private:
+    // Following constructors and assignment operators not supported
+    StellaEnvironment() = delete;
+    StellaEnvironment(const StellaEnvironment&) = delete;
+    StellaEnvironment(StellaEnvironment&&) = delete;
+    StellaEnvironment& operator=(const StellaEnvironment&) = delete;
+    StellaEnvironment& operator=(StellaEnvironment&&) = delete;
+};
+
+#endif // STELLA_ENVIRONMENT_HXX
@@ -16,6 +16,7 @@
 //============================================================================
 
 #include <cmath>
+#include <cstring>
 
 #include "FBSurface.hxx"
 #include "Settings.hxx"
@@ -41,6 +42,22 @@ namespace {
       FrameBuffer::ScalingInterpolation::sharp;
 #endif
   }
+
+  // FNV-1a, applied to 64 bit words. Each step is a bijection, so lines
+  // that differ in a single word never collide.
+  inline uInt64 hashLine(const uInt8* line, uInt32 length)
+  {
+    uInt64 hash = 0xcbf29ce484222325ULL;
+    uInt64 word = 0;
+
+    for(uInt32 i = 0; i < length; i += sizeof(word))
+    {
+      std::memcpy(&word, line + i, std::min<uInt32>(sizeof(word), length - i));
+      hash = (hash ^ word) * 0x100000001b3ULL;
+    }
+
+    return hash;
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -83,6 +100,7 @@ void TIASurface::initialize(const Console& console,
                             const FrameBuffer::VideoMode& mode)
 {
   myTIA = &(console.tia());
+  invalidateLineHashes();
 
   myTiaSurface->setDstPos(mode.image.x(), mode.image.y());
   myTiaSurface->setDstSize(mode.image.w(), mode.image.h());
@@ -125,6 +143,7 @@ void TIASurface::setPalette(const PaletteArray& tia_palette,
                             const PaletteArray& rgb_palette)
 {
   myPalette = tia_palette;
+  invalidateLineHashes();
 
   // The NTSC filtering needs access to the raw RGB data, since it calculates
   // its own internal palette
@@ -220,6 +239,7 @@ void TIASurface::enablePhosphor(bool enable, int blend)
   {
     myFilter = Filter(enable ? uInt8(myFilter) | 0x01 : uInt8(myFilter) & 0x10);
     myRGBFramebuffer.fill(0);
+    invalidateLineHashes();
   }
 }
 
@@ -246,6 +266,7 @@ void TIASurface::enableNTSC(bool enable)
   mySLineSurface->applyAttributes();
 
   myRGBFramebuffer.fill(0);
+  invalidateLineHashes();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -307,6 +328,10 @@ void TIASurface::render()
   uInt32 *out, outPitch;
   myTiaSurface->basePtr(out, outPitch);
 
+  if(!myDirtyLinesPending)
+    findDirtyLines();
+  myDirtyLinesPending = false;
+
   switch(myFilter)
   {
     case Filter::Normal:
@@ -316,6 +341,13 @@ void TIASurface::render()
       uInt32 bufofs = 0, screenofsY = 0, pos;
       for(uInt32 y = 0; y < height; ++y)
       {
+        if(!myLineChanged[y])
+        {
+          bufofs += width;
+          screenofsY += outPitch;
+          continue;
+        }
+
         pos = screenofsY;
         for (uInt32 x = width / 2; x; --x)
         {
@@ -355,7 +387,12 @@ void TIASurface::render()
 
     case Filter::BlarggNormal:
     {
-      myNTSCFilter.render(myTIA->frameBuffer(), width, height, out, outPitch << 2);
+      // Lines are filtered independently, so only the changed ones need to
+      // be filtered again
+      if(myDirtyLineCount > 0)
+        myNTSCFilter.render(myTIA->frameBuffer() + myDirtyFirstLine * width, width,
+                            myDirtyLineCount, out + myDirtyFirstLine * outPitch,
+                            outPitch << 2);
       break;
     }
 
@@ -371,6 +408,7 @@ void TIASurface::render()
   }
 
   // Draw TIA image
+  myTiaSurface->setDirtyLines(myDirtyFirstLine, myDirtyLineCount);
   myTiaSurface->render();
 
   // Draw overlaying scanlines
@@ -386,6 +424,57 @@ void TIASurface::render()
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TIASurface::frameChanged()
+{
+  findDirtyLines();
+
+  // If nothing changed, there is no need to remember this, since render()
+  // will simply find out again
+  myDirtyLinesPending = myDirtyLineCount > 0;
+
+  return myDirtyLinesPending;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASurface::findDirtyLines()
+{
+  const uInt32 width = myTIA->width(), height = myTIA->height();
+
+  // Phosphor blending changes the image even if the frame doesn't change,
+  // and snapshots need a complete image
+  if((uInt8(myFilter) & 0x01) || mySaveSnapFlag)
+  {
+    std::fill_n(myLineChanged.begin(), height, true);
+    myDirtyFirstLine = 0;
+    myDirtyLineCount = height;
+    invalidateLineHashes();
+
+    return;
+  }
+
+  const bool hashesValid = myHashedLines == height;
+  const uInt8* tiaIn = myTIA->frameBuffer();
+  uInt32 first = height, last = 0;
+
+  for(uInt32 y = 0; y < height; ++y, tiaIn += width)
+  {
+    const uInt64 hash = hashLine(tiaIn, width);
+
+    myLineChanged[y] = !hashesValid || hash != myLineHashes[y];
+    if(myLineChanged[y])
+    {
+      myLineHashes[y] = hash;
+      first = std::min(first, y);
+      last = y + 1;
+    }
+  }
+  myHashedLines = height;
+
+  myDirtyFirstLine = first < last ? first : 0;
+  myDirtyLineCount = first < last ? last - first : 0;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASurface::renderForSnapshot()
 {
@@ -450,6 +539,7 @@ void TIASurface::renderForSnapshot()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASurface::updateSurfaceSettings()
 {
+  invalidateLineHashes();
   myTiaSurface->setScalingInterpolation(interpolationModeFromSettings(myOSystem.settings()));
   mySLineSurface->setScalingInterpolation(
       interpolationModeFromSettings(myOSystem.settings())
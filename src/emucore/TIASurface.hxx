@@ -78,9 +78,10 @@ class TIASurface
     uInt32 mapIndexedPixel(uInt8 indexedColor, uInt8 shift = 0);
 
     /**
-      Get the NTSCFilter object associated with the framebuffer
+      Get the NTSCFilter object associated with the framebuffer.  Since
+      the caller may change the filter, the next frame is fully rendered.
     */
-    NTSCFilter& ntsc() { return myNTSCFilter; }
+    NTSCFilter& ntsc() { invalidateLineHashes(); return myNTSCFilter; }
 
     /**
       Use NTSC filtering effects specified by the given preset.
@@ -120,6 +121,13 @@ class TIASurface
     */
     void render();
 
+    /**
+      Answers whether the current TIA frame has to be rendered, i.e. if it
+      differs from the last rendered frame or rendering it has side effects.
+      If false, presenting the frame again can be skipped.
+    */
+    bool frameChanged();
+
     /**
       This method prepares the current frame for taking a snapshot.
       In particular, in phosphor modes the blending is adjusted slightly to
@@ -143,6 +151,18 @@ class TIASurface
     */
     uInt32 averageBuffers(uInt32 bufOfs);
 
+    /**
+      Compare the lines of the current TIA frame with those of the last
+      rendered frame, and determine which lines have to be rendered.
+    */
+    void findDirtyLines();
+
+    /**
+      Forget the last rendered frame, so that the next frame is rendered
+      completely.
+    */
+    void invalidateLineHashes() { myHashedLines = 0; }
+
   private:
     OSystem& myOSystem;
     FrameBuffer& myFB;
@@ -183,6 +203,21 @@ class TIASurface
     // Flag for saving a snapshot
     bool mySaveSnapFlag{false};
 
+    /////////////////////////////////////////////////////////////
+    // Changed line tracking
+    // Hashes of the lines of the last rendered frame; only the first
+    // myHashedLines are valid
+    std::array<uInt64, TIAConstants::frameBufferHeight> myLineHashes;
+    uInt32 myHashedLines{0};
+
+    // The lines of the current frame that have to be rendered
+    std::array<bool, TIAConstants::frameBufferHeight> myLineChanged;
+    uInt32 myDirtyFirstLine{0}, myDirtyLineCount{0};
+
+    // Set if findDirtyLines() was already called for the current frame
+    bool myDirtyLinesPending{false};
+    /////////////////////////////////////////////////////////////
+
   private:
     // Following constructors and assignment operators not supported
     TIASurface() = delete;
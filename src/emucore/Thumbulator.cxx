@@ -26,6 +26,7 @@
 #include "Base.hxx"
 #include "Cart.hxx"
 #include "Thumbulator.hxx"
+#include "PerfCounters.hxx"
 using Common::Base;
 
 // Uncomment the following to enable specific functionality
@@ -85,6 +86,11 @@ string Thumbulator::run()
       throw runtime_error("instructions > 500000");
 #endif
   }
+
+  PERF_COUNT(armCalls, 1);
+#ifndef UNSAFE_OPTIMIZATIONS
+  PERF_COUNT(armInstructions, instructions);
+#endif
 #if defined(THUMB_DISS) || defined(THUMB_DBUG)
   dump_counters();
   cout << statusMsg.str() << endl;
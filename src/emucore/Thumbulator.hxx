@@ -74,6 +74,12 @@ class Thumbulator
     string run();
     string run(uInt32 cycles);
 
+    /**
+      Point the emulator to a new copy of the ROM, with the same contents
+      (ie, after the cart has copied a shared image for patching).
+    */
+    void setRom(const uInt16* rom_ptr) { rom = rom_ptr; }
+
 #ifndef UNSAFE_OPTIMIZATIONS
     /**
       Normally when a fatal error is encountered, the ARM emulation
@@ -3,6 +3,7 @@ MODULE := src/emucore
 MODULE_OBJS := \
 	src/emucore/AtariVox.o \
 	src/emucore/Bankswitch.o \
+	src/emucore/BareConsole.o \
 	src/emucore/Booster.o \
 	src/emucore/Cart.o \
 	src/emucore/CartDetector.o \
@@ -30,6 +31,7 @@ MODULE_OBJS := \
 	src/emucore/CartE78K.o \
 	src/emucore/CartEF.o \
 	src/emucore/CartEFSC.o \
+	src/emucore/CartEnhanced.o \
 	src/emucore/CartBF.o \
 	src/emucore/CartBFSC.o \
 	src/emucore/CartDF.o \
@@ -52,6 +54,7 @@ MODULE_OBJS := \
 	src/emucore/CartX07.o \
 	src/emucore/CompuMate.o \
 	src/emucore/Console.o \
+	src/emucore/ConsolePreloader.o \
 	src/emucore/Control.o \
 	src/emucore/ControllerDetector.o \
 	src/emucore/DispatchResult.o \
@@ -76,11 +79,15 @@ MODULE_OBJS := \
 	src/emucore/Paddles.o \
 	src/emucore/PointingDevice.o \
 	src/emucore/ProfilingRunner.o \
+	src/emucore/DifferentialRunner.o \
 	src/emucore/Props.o \
 	src/emucore/PropsSet.o \
+	src/emucore/RomImage.o \
 	src/emucore/SaveKey.o \
 	src/emucore/Serializer.o \
 	src/emucore/Settings.o \
+	src/emucore/StellaEnvironment.o \
+	src/emucore/stella_env.o \
 	src/emucore/Switches.o \
 	src/emucore/System.o \
 	src/emucore/TIASurface.o \
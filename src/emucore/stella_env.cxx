@@ -0,0 +1,151 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "stella_env.h"
+#include "StellaEnvironment.hxx"
+
+struct stella_env
+{
+  unique_ptr<StellaEnvironment> env;
+};
+
+struct stella_env_state
+{
+  StellaEnvironment::State state;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+stella_env* stella_env_create(const char* rom_file, unsigned num_consoles,
+                              unsigned num_threads)
+{
+  try
+  {
+    return new stella_env{
+      make_unique<StellaEnvironment>(rom_file, num_consoles, num_threads)
+    };
+  }
+  catch(const std::exception& e)
+  {
+    cerr << "ERROR: " << e.what() << endl;
+    return nullptr;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void stella_env_destroy(stella_env* env)
+{
+  delete env;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+unsigned stella_env_num_consoles(const stella_env* env)
+{
+  return env->env->numConsoles();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void stella_env_set_reward_fn(stella_env* env, stella_env_reward_fn fn,
+                              void* user_data)
+{
+  if(fn)
+    env->env->setRewardFunction([fn, user_data](const uInt8* prevRam, const uInt8* ram) {
+      return fn(prevRam, ram, user_data);
+    });
+  else
+    env->env->setRewardFunction(nullptr);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void stella_env_set_frame_downsampling(stella_env* env, unsigned factor)
+{
+  env->env->setFrameDownsampling(factor);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+unsigned stella_env_frame_width(const stella_env* env)
+{
+  return env->env->frameWidth();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+unsigned stella_env_frame_height(const stella_env* env)
+{
+  return env->env->frameHeight();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void stella_env_reset(stella_env* env)
+{
+  env->env->reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int stella_env_step(stella_env* env, const uint8_t* actions, unsigned frameskip,
+                    float* rewards, uint8_t* ram, uint8_t* frames)
+{
+  try
+  {
+    return env->env->step(actions, frameskip, rewards, ram, frames);
+  }
+  catch(const std::exception& e)
+  {
+    cerr << "ERROR: " << e.what() << endl;
+    return 0;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+stella_env_state* stella_env_clone_state(stella_env* env, unsigned console)
+{
+  auto state = make_unique<stella_env_state>();
+
+  return env->env->cloneState(console, state->state) ? state.release() : nullptr;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int stella_env_restore_state(stella_env* env, unsigned console,
+                             const stella_env_state* state)
+{
+  return state && env->env->restoreState(console, state->state);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void stella_env_state_free(stella_env_state* state)
+{
+  delete state;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t stella_env_state_size(const stella_env_state* state)
+{
+  return state->state.data.size();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uint8_t* stella_env_state_data(const stella_env_state* state)
+{
+  return state->state.data.data();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+stella_env_state* stella_env_state_from_data(const uint8_t* data, size_t size)
+{
+  auto state = make_unique<stella_env_state>();
+  state->state.data.assign(data, data + size);
+
+  return state.release();
+}
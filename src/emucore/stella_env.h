@@ -0,0 +1,95 @@
+/*============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//==========================================================================*/
+
+/*
+  C interface to StellaEnvironment, for use from agent code and foreign
+  function interfaces. Link against libstellaenv.a ('make env').
+
+  All functions returning int return nonzero on success. Output arrays are
+  allocated by the caller and may be NULL if not needed.
+*/
+
+#ifndef STELLA_ENV_H
+#define STELLA_ENV_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Action bits, see StellaEnvironment::Action */
+#define STELLA_ENV_NOOP    0x00
+#define STELLA_ENV_UP      0x01
+#define STELLA_ENV_DOWN    0x02
+#define STELLA_ENV_LEFT    0x04
+#define STELLA_ENV_RIGHT   0x08
+#define STELLA_ENV_FIRE    0x10
+#define STELLA_ENV_RESET   0x20
+#define STELLA_ENV_SELECT  0x40
+
+#define STELLA_ENV_RAM_SIZE 128
+
+typedef struct stella_env stella_env;
+typedef struct stella_env_state stella_env_state;
+
+/* Reward of a single frame, calculated from the RIOT RAM before and after */
+typedef float (*stella_env_reward_fn)(const uint8_t* prev_ram, const uint8_t* ram,
+                                      void* user_data);
+
+/* Returns NULL on failure; num_threads == 0 uses all hardware threads */
+stella_env* stella_env_create(const char* rom_file, unsigned num_consoles,
+                              unsigned num_threads);
+void stella_env_destroy(stella_env* env);
+
+unsigned stella_env_num_consoles(const stella_env* env);
+void stella_env_set_reward_fn(stella_env* env, stella_env_reward_fn fn,
+                              void* user_data);
+
+/* Frame dimensions in bytes (palette indices) after downsampling */
+void stella_env_set_frame_downsampling(stella_env* env, unsigned factor);
+unsigned stella_env_frame_width(const stella_env* env);
+unsigned stella_env_frame_height(const stella_env* env);
+
+void stella_env_reset(stella_env* env);
+
+/*
+  actions:  num_consoles action bitmasks
+  rewards:  num_consoles floats
+  ram:      num_consoles * STELLA_ENV_RAM_SIZE bytes
+  frames:   num_consoles * frame_width * frame_height bytes
+*/
+int stella_env_step(stella_env* env, const uint8_t* actions, unsigned frameskip,
+                    float* rewards, uint8_t* ram, uint8_t* frames);
+
+/* Snapshots; free with stella_env_state_free */
+stella_env_state* stella_env_clone_state(stella_env* env, unsigned console);
+int stella_env_restore_state(stella_env* env, unsigned console,
+                             const stella_env_state* state);
+void stella_env_state_free(stella_env_state* state);
+
+/* Raw snapshot bytes, e.g. for persisting them */
+size_t stella_env_state_size(const stella_env_state* state);
+const uint8_t* stella_env_state_data(const stella_env_state* state);
+stella_env_state* stella_env_state_from_data(const uint8_t* data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STELLA_ENV_H */
@@ -22,6 +22,7 @@
 #include "bspf.hxx"
 #include "smartmod.hxx"
 #include "DelayQueueMember.hxx"
+#include "PerfCounters.hxx"
 
 template<unsigned length, unsigned capacity>
 class DelayQueueIteratorImpl;
@@ -87,6 +88,8 @@ void DelayQueue<length, capacity>::push(uInt8 address, uInt8 value, uInt8 delay)
   uInt8 index = smartmod<length>(myIndex + delay);
   myMembers[index].push(address, value);
 
+  PERF_COUNT(delayQueueEvents, 1);
+
   myIndices[address] = index;
 }
 
@@ -222,7 +222,7 @@ void Playfield::applyColors()
 uInt8 Playfield::getColor() const
 {
   if (!myDebugEnabled)
-    return myX < TIAConstants::H_PIXEL / 2 ? myColorLeft : myColorRight;
+    return getPlainColor();
   else
   {
     if (myX < TIAConstants::H_PIXEL / 2)
@@ -120,6 +120,13 @@ class Playfield : public Serializable
      */
     uInt8 getColor() const;
 
+    /**
+      Get the current color, for use while debug colors are disabled.
+     */
+    uInt8 getPlainColor() const {
+      return myX < TIAConstants::H_PIXEL / 2 ? myColorLeft : myColorRight;
+    }
+
     /**
       Serializable methods (see that class for more information).
     */
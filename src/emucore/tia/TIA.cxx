@@ -22,8 +22,10 @@
 #include "DelayQueueIteratorImpl.hxx"
 #include "TIAConstants.hxx"
 #include "frame-manager/FrameManager.hxx"
+#include "frame-manager/FrameLayoutDetector.hxx"
 #include "AudioQueue.hxx"
 #include "DispatchResult.hxx"
+#include "PerfCounters.hxx"
 
 #ifdef DEBUGGER_SUPPORT
   #include "CartDebug.hxx"
@@ -89,8 +91,27 @@ TIA::TIA(ConsoleIO& console, const ConsoleTimingProvider& timingProvider,
   initialize();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::setFrameManager(FrameManager* frameManager)
+{
+  attachFrameManager(frameManager);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::setFrameManager(FrameLayoutDetector* frameManager)
+{
+  attachFrameManager(frameManager);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::setFrameManager(AbstractFrameManager* frameManager)
+{
+  attachFrameManager(frameManager);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class FrameManagerType>
+void TIA::attachFrameManager(FrameManagerType* frameManager)
 {
   clearFrameManager();
 
@@ -107,6 +128,15 @@ void TIA::setFrameManager(AbstractFrameManager* frameManager)
 
   myFrameManager->enableJitter(myEnableJitter);
   myFrameManager->setJitterFactor(myJitterFactor);
+
+  // For unknown frame managers, always use the generic version
+  myCycleFunctions = {
+    std::is_same<FrameManagerType, AbstractFrameManager>::value
+      ? &TIA::cycle<AbstractFrameManager, true>
+      : &TIA::cycle<FrameManagerType, false>,
+    &TIA::cycle<FrameManagerType, true>
+  };
+  updateCycleFunction();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -170,14 +200,14 @@ void TIA::initialize()
   if (myFrameManager)
     myFrameManager->reset();
 
-  myFrontBufferScanlines = myFrameBufferScanlines = 0;
+  myFrameBuffersScanlines.fill(0);
+  myFrameBufferScanlines = 0;
 
   myFramesSinceLastRender = 0;
 
   // Blank the various framebuffers; they may contain graphical garbage
-  myBackBuffer.fill(0);
-  myFrontBuffer.fill(0);
-  myFramebuffer.fill(0);
+  for(auto& buffer: myFrameBuffers)
+    buffer.fill(0);
 
   applyDeveloperSettings();
 
@@ -284,7 +314,7 @@ bool TIA::save(Serializer& out) const
     out.putLong(myCyclesAtFrameStart);
 
     out.putInt(myFrameBufferScanlines);
-    out.putInt(myFrontBufferScanlines);
+    out.putInt(myFrameBuffersScanlines[myFrontBufferIdx & ~FRONT_BUFFER_FRESH]);
 
     out.putByte(myPFBitsDelay);
     out.putByte(myPFColorDelay);
@@ -355,7 +385,7 @@ bool TIA::load(Serializer& in)
     myCyclesAtFrameStart = in.getLong();
 
     myFrameBufferScanlines = in.getInt();
-    myFrontBufferScanlines = in.getInt();
+    myFrameBuffersScanlines[myFrontBufferIdx & ~FRONT_BUFFER_FRESH] = in.getInt();
 
     myPFBitsDelay = in.getByte();
     myPFColorDelay = in.getByte();
@@ -363,6 +393,7 @@ bool TIA::load(Serializer& in)
 
     // Re-apply dev settings
     applyDeveloperSettings();
+    updateCycleFunction();
   }
   catch(...)
   {
@@ -800,9 +831,11 @@ bool TIA::saveDisplay(Serializer& out) const
 {
   try
   {
-    out.putByteArray(myFramebuffer.data(), myFramebuffer.size());
-    out.putByteArray(myBackBuffer.data(), myBackBuffer.size());
-    out.putByteArray(myFrontBuffer.data(), myFrontBuffer.size());
+    const uInt8 frontBufferIdx = myFrontBufferIdx & ~FRONT_BUFFER_FRESH;
+
+    out.putByteArray(myFramebuffer, FRAME_BUFFER_SIZE);
+    out.putByteArray(myBackBuffer, FRAME_BUFFER_SIZE);
+    out.putByteArray(myFrameBuffers[frontBufferIdx].data(), FRAME_BUFFER_SIZE);
     out.putInt(myFramesSinceLastRender);
   }
   catch(...)
@@ -820,10 +853,15 @@ bool TIA::loadDisplay(Serializer& in)
   try
   {
     // Reset frame buffer pointer and data
-    in.getByteArray(myFramebuffer.data(), myFramebuffer.size());
-    in.getByteArray(myBackBuffer.data(), myBackBuffer.size());
-    in.getByteArray(myFrontBuffer.data(), myFrontBuffer.size());
+    const uInt8 frontBufferIdx = myFrontBufferIdx & ~FRONT_BUFFER_FRESH;
+
+    in.getByteArray(myFramebuffer, FRAME_BUFFER_SIZE);
+    in.getByteArray(myBackBuffer, FRAME_BUFFER_SIZE);
+    in.getByteArray(myFrameBuffers[frontBufferIdx].data(), FRAME_BUFFER_SIZE);
     myFramesSinceLastRender = in.getInt();
+
+    // The restored front buffer is the last completed frame
+    myFrontBufferIdx = frontBufferIdx | FRONT_BUFFER_FRESH;
   }
   catch(...)
   {
@@ -895,16 +933,30 @@ void TIA::renderToFrameBuffer()
 
   myFramesSinceLastRender = 0;
 
-  myFramebuffer = myFrontBuffer;
+  // Nothing to do if we already took the last published frame
+  if (!(myFrontBufferIdx.load(std::memory_order_relaxed) & FRONT_BUFFER_FRESH)) return;
+
+  myFramebufferIdx =
+    myFrontBufferIdx.exchange(myFramebufferIdx, std::memory_order_acq_rel) & ~FRONT_BUFFER_FRESH;
+  myFramebuffer = myFrameBuffers[myFramebufferIdx].data();
 
-  myFrameBufferScanlines = myFrontBufferScanlines;
+  myFrameBufferScanlines = myFrameBuffersScanlines[myFramebufferIdx];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uInt8* TIA::lastFrameBuffer() const
+{
+  const uInt8 frontBufferIdx = myFrontBufferIdx;
+
+  return frontBufferIdx & FRONT_BUFFER_FRESH ?
+    myFrameBuffers[frontBufferIdx & ~FRONT_BUFFER_FRESH].data() : myFramebuffer;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::clearFrameBuffer()
 {
-  myFramebuffer.fill(0);
-  myFrontBuffer.fill(0);
+  std::fill_n(myFramebuffer, FRAME_BUFFER_SIZE, 0);
+  myFrameBuffers[myFrontBufferIdx & ~FRONT_BUFFER_FRESH].fill(0);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1053,6 +1105,8 @@ bool TIA::enableFixedColors(bool enable)
   myBackground.enableDebugColors(enable);
   myColorHBlank = enable ? FixedColor::HBLANK_WHITE : 0x00;
 
+  updateCycleFunction();
+
   return enable;
 }
 
@@ -1207,7 +1261,7 @@ void TIA::updateEmulation()
   mySubClock = 0;
   myLastCycle = systemCycles;
 
-  cycle(cyclesToRun);
+  (this->*myCycleFunction)(cyclesToRun);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1242,18 +1296,24 @@ void TIA::onFrameComplete()
   myCyclesAtFrameStart = mySystem->cycles();
 
   if (myXAtRenderingStart > 0)
-    std::fill_n(myBackBuffer.begin(), myXAtRenderingStart, 0);
+    std::fill_n(myBackBuffer, myXAtRenderingStart, 0);
 
   // Blank out any extra lines not drawn this frame
   const Int32 missingScanlines = myFrameManager->missingScanlines();
   if (missingScanlines > 0)
-    std::fill_n(myBackBuffer.begin() + TIAConstants::H_PIXEL * myFrameManager->getY(), missingScanlines * TIAConstants::H_PIXEL, 0);
+    std::fill_n(myBackBuffer + TIAConstants::H_PIXEL * myFrameManager->getY(), missingScanlines * TIAConstants::H_PIXEL, 0);
 
-  myFrontBuffer = myBackBuffer;
+  myFrameBuffersScanlines[myBackBufferIdx] = scanlinesLastFrame();
 
-  myFrontBufferScanlines = scanlinesLastFrame();
+  // Publish the frame; the previous front buffer (either stale or already
+  // taken by the renderer) becomes the new back buffer
+  myBackBufferIdx =
+    myFrontBufferIdx.exchange(myBackBufferIdx | FRONT_BUFFER_FRESH, std::memory_order_acq_rel) & ~FRONT_BUFFER_FRESH;
+  myBackBuffer = myFrameBuffers[myBackBufferIdx].data();
 
   ++myFramesSinceLastRender;
+
+  PERF_COUNT(frames, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1265,8 +1325,31 @@ void TIA::onHalt()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::updateCycleFunction()
+{
+  myCycleFunction = myReferenceMode
+    ? &TIA::cycle<AbstractFrameManager, true>
+    : myCycleFunctions[usingFixedColors() ? 1 : 0];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::enableReferenceMode(bool enable)
+{
+  // A cached line may still be pending; flush it with the current core
+  flushLineCache();
+
+  myReferenceMode = enable;
+  updateCycleFunction();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class FrameManagerType, bool fixedColors>
 void TIA::cycle(uInt32 colorClocks)
 {
+  const FrameManagerType* frameManager = static_cast<FrameManagerType*>(myFrameManager);
+
+  PERF_COUNT(tiaClocks, colorClocks);
+
   for (uInt32 i = 0; i < colorClocks; ++i)
   {
     myDelayQueue.execute(
@@ -1282,9 +1365,9 @@ void TIA::cycle(uInt32 colorClocks)
       if (myHstate == HState::blank)
         tickHblank();
       else
-        tickHframe();
+        tickHframe<FrameManagerType, fixedColors>();
 
-      if (myCollisionUpdateRequired && !myFrameManager->vblank()) updateCollision();
+      if (myCollisionUpdateRequired && !frameManager->vblank()) updateCollision();
     }
 
     if (++myHctr >= TIAConstants::H_CLOCKS)
@@ -1347,9 +1430,11 @@ void TIA::tickHblank()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class FrameManagerType, bool fixedColors>
 void TIA::tickHframe()
 {
-  const uInt32 y = myFrameManager->getY();
+  const FrameManagerType* frameManager = static_cast<FrameManagerType*>(myFrameManager);
+  const uInt32 y = frameManager->getY();
   const uInt32 x = myHctr - TIAConstants::H_BLANK_CLOCKS - myHctrDelta;
 
   myCollisionUpdateRequired = true;
@@ -1361,8 +1446,8 @@ void TIA::tickHframe()
   myPlayer1.tick();
   myBall.tick();
 
-  if (myFrameManager->isRendering())
-    renderPixel(x, y);
+  if (frameManager->isRendering())
+    renderPixel<FrameManagerType, fixedColors>(x, y);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1372,7 +1457,7 @@ void TIA::applyRsync()
 
   myHctrDelta = TIAConstants::H_CLOCKS - 3 - myHctr;
   if (myFrameManager->isRendering())
-    std::fill_n(myBackBuffer.begin() + myFrameManager->getY() * TIAConstants::H_PIXEL + x, TIAConstants::H_PIXEL - x, 0);
+    std::fill_n(myBackBuffer + myFrameManager->getY() * TIAConstants::H_PIXEL + x, TIAConstants::H_PIXEL - x, 0);
 
   myHctr = TIAConstants::H_CLOCKS - 3;
 }
@@ -1382,11 +1467,12 @@ void TIA::nextLine()
 {
   if (myLinesSinceChange >= 2) {
     cloneLastLine();
+    PERF_COUNT(tiaClocksCloned, TIAConstants::H_CLOCKS);
   }
 
   myHctr = 0;
 
-  if (!myMovementInProgress && myLinesSinceChange < 2) ++myLinesSinceChange;
+  if (!myMovementInProgress && myLinesSinceChange < 2 && !myReferenceMode) ++myLinesSinceChange;
 
   myHstate = HState::blank;
   myHctrDelta = 0;
@@ -1411,8 +1497,8 @@ void TIA::cloneLastLine()
 
   if (!myFrameManager->isRendering() || y == 0) return;
 
-  std::copy_n(myBackBuffer.begin() + (y-1) * TIAConstants::H_PIXEL, TIAConstants::H_PIXEL,
-      myBackBuffer.begin() + y * TIAConstants::H_PIXEL);
+  std::copy_n(myBackBuffer + (y-1) * TIAConstants::H_PIXEL, TIAConstants::H_PIXEL,
+      myBackBuffer + y * TIAConstants::H_PIXEL);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1435,13 +1521,19 @@ void TIA::updateCollision()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class FrameManagerType, bool fixedColors>
 void TIA::renderPixel(uInt32 x, uInt32 y)
 {
   if (x >= TIAConstants::H_PIXEL) return;
 
+  // With fixed debug colors disabled, the playfield color needs no debug checks
+  const auto playfieldColor = [this] () {
+    return fixedColors ? myPlayfield.getColor() : myPlayfield.getPlainColor();
+  };
+
   uInt8 color = 0;
 
-  if (!myFrameManager->vblank())
+  if (!static_cast<FrameManagerType*>(myFrameManager)->vblank())
   {
     switch (myPriority)
     {
@@ -1449,7 +1541,7 @@ void TIA::renderPixel(uInt32 x, uInt32 y)
         // Playfield has priority so ScoreBit isn't used
         // Priority from highest to lowest:
         //   BL/PF => P0/M0 => P1/M1 => BK
-        if (myPlayfield.isOn())       color = myPlayfield.getColor();
+        if (myPlayfield.isOn())       color = playfieldColor();
         else if (myBall.isOn())       color = myBall.getColor();
         else if (myPlayer0.isOn())    color = myPlayer0.getColor();
         else if (myMissile0.isOn())   color = myMissile0.getColor();
@@ -1468,7 +1560,7 @@ void TIA::renderPixel(uInt32 x, uInt32 y)
         // write
         if (myPlayer0.isOn())         color = myPlayer0.getColor();
         else if (myMissile0.isOn())   color = myMissile0.getColor();
-        else if (myPlayfield.isOn())  color = myPlayfield.getColor();
+        else if (myPlayfield.isOn())  color = playfieldColor();
         else if (myPlayer1.isOn())    color = myPlayer1.getColor();
         else if (myMissile1.isOn())   color = myMissile1.getColor();
         else if (myBall.isOn())       color = myBall.getColor();
@@ -1482,7 +1574,7 @@ void TIA::renderPixel(uInt32 x, uInt32 y)
         else if (myMissile0.isOn())   color = myMissile0.getColor();
         else if (myPlayer1.isOn())    color = myPlayer1.getColor();
         else if (myMissile1.isOn())   color = myMissile1.getColor();
-        else if (myPlayfield.isOn())  color = myPlayfield.getColor();
+        else if (myPlayfield.isOn())  color = playfieldColor();
         else if (myBall.isOn())       color = myBall.getColor();
         else                          color = myBackground.getColor();
         break;
@@ -1506,7 +1598,7 @@ void TIA::flushLineCache()
       if (myHstate == HState::blank)
         tickHblank();
       else
-        tickHframe();
+        tickHframe<AbstractFrameManager, true>();
     }
   }
 }
@@ -1515,7 +1607,7 @@ void TIA::flushLineCache()
 void TIA::clearHmoveComb()
 {
   if (myFrameManager->isRendering() && myHstate == HState::blank)
-    std::fill_n(myBackBuffer.begin() + myFrameManager->getY() * TIAConstants::H_PIXEL, 8, myColorHBlank);
+    std::fill_n(myBackBuffer + myFrameManager->getY() * TIAConstants::H_PIXEL, 8, myColorHBlank);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -18,6 +18,7 @@
 #ifndef TIA_TIA
 #define TIA_TIA
 
+#include <atomic>
 #include <functional>
 
 #include "bspf.hxx"
@@ -45,6 +46,8 @@
 
 class AudioQueue;
 class DispatchResult;
+class FrameManager;
+class FrameLayoutDetector;
 
 /**
   This class is a device that emulates the Television Interface Adaptor
@@ -108,6 +111,7 @@ class TIA : public Device
   public:
     friend class TIADebug;
     friend class RiotDebug;
+    friend class DifferentialRunner;
 
     /**
       Create a new TIA for the specified console
@@ -121,8 +125,11 @@ class TIA : public Device
 
   public:
     /**
-      Configure the frame manager.
+      Configure the frame manager.  The overloads for the concrete frame
+      managers select a specialized emulation core without virtual calls.
      */
+    void setFrameManager(FrameManager* frameManager);
+    void setFrameManager(FrameLayoutDetector* frameManager);
     void setFrameManager(AbstractFrameManager* frameManager);
 
     /**
@@ -229,7 +236,9 @@ class TIA : public Device
     uInt32 framesSinceLastRender() { return myFramesSinceLastRender; }
 
     /**
-      Render the pending frame to the framebuffer and clear the flag.
+      Make the last completed frame the framebuffer and clear the flag.
+      No pixel data is copied, and the emulation core may keep running
+      while this is called.
      */
     void renderToFrameBuffer();
 
@@ -237,12 +246,18 @@ class TIA : public Device
       Return the buffer that holds the currently drawing TIA frame
       (the TIA output widget needs this).
      */
-    uInt8* outputBuffer() { return myBackBuffer.data(); }
+    uInt8* outputBuffer() { return myBackBuffer; }
+
+    /**
+      Return the buffer that holds the last completed TIA frame. The TIA
+      output widget shows it below the electron beam.
+     */
+    const uInt8* lastFrameBuffer() const;
 
     /**
       Returns a pointer to the internal frame buffer.
     */
-    uInt8* frameBuffer() { return myFramebuffer.data(); }
+    uInt8* frameBuffer() { return myFramebuffer; }
 
     void clearFrameBuffer();
 
@@ -385,6 +400,15 @@ class TIA : public Device
     bool toggleFixedColors() { return enableFixedColors(!usingFixedColors()); }
     bool usingFixedColors() const { return myColorHBlank != 0x00; }
 
+    /**
+      Enables/disables 'reference' mode: the generic, unspecialized version
+      of the core is used, without line caching.  This is
+      meant for validating the optimized code paths against.
+
+      @param enable  Whether to enable reference mode
+    */
+    void enableReferenceMode(bool enable);
+
     /**
       Sets the color of each object in 'fixed debug colors' mode.
       Note that this doesn't enable/disable fixed colors; it simply
@@ -573,10 +597,27 @@ class TIA : public Device
     void onHalt();
 
     /**
-     * Execute colorClocks cycles of TIA simulation.
+     * Attach the frame manager and select the matching specializations of cycle().
+     */
+    template<class FrameManagerType>
+    void attachFrameManager(FrameManagerType* frameManager);
+
+    /**
+     * Execute colorClocks cycles of TIA simulation. This is specialized on the
+     * concrete frame manager and on fixed debug colors, so that the per pixel
+     * work in normal play does not need any indirect calls or debug checks.
+     * With AbstractFrameManager and fixedColors == true, the result is the
+     * generic version which works for any configuration.
      */
+    template<class FrameManagerType, bool fixedColors>
     void cycle(uInt32 colorClocks);
 
+    /**
+     * Select the specialization of cycle() matching the fixed debug colors
+     * setting.
+     */
+    void updateCycleFunction();
+
     /**
      * Advance the movement logic by a single clock.
      */
@@ -590,6 +631,7 @@ class TIA : public Device
     /**
      * Advance a single clock duing the visible part of the scanline.
      */
+    template<class FrameManagerType, bool fixedColors>
     void tickHframe();
 
     /**
@@ -605,6 +647,7 @@ class TIA : public Device
     /**
      * Render the current pixel into the framebuffer.
      */
+    template<class FrameManagerType, bool fixedColors>
     void renderPixel(uInt32 x, uInt32 y);
 
     /**
@@ -731,6 +774,14 @@ class TIA : public Device
      */
     AbstractFrameManager* myFrameManager{nullptr};
 
+    /**
+     * The specializations of cycle() for the current frame manager, without
+     * and with fixed debug colors, and the one currently in use.
+     */
+    using CycleFunction = void (TIA::*)(uInt32);
+    std::array<CycleFunction, 2> myCycleFunctions{};
+    CycleFunction myCycleFunction{nullptr};
+
     /**
      * The various TIA objects.
      */
@@ -755,20 +806,40 @@ class TIA : public Device
     LatchedInput myInput0;
     LatchedInput myInput1;
 
-    // Pointer to the internal color-index-based frame buffer
-    std::array<uInt8, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight> myFramebuffer;
-
-    // The frame is rendered to the backbuffer and only copied to the framebuffer
-    // upon completion
-    std::array<uInt8, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight> myBackBuffer;
-    std::array<uInt8, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight> myFrontBuffer;
-
-    // We snapshot frame statistics when the back buffer is copied to the front buffer
-    // and when the front buffer is copied to the frame buffer
-    uInt32 myFrontBufferScanlines{0}, myFrameBufferScanlines{0};
+    // The color-index-based frame buffers. Frames are handed from the TIA to
+    // the renderer by rotating the roles of these three buffers:
+    //  - the frame is drawn to the back buffer
+    //  - upon completion, the back buffer is published as the front buffer,
+    //    and the old front buffer becomes the new back buffer
+    //  - the renderer swaps its framebuffer with the front buffer if the
+    //    latter holds a frame it has not seen yet
+    // Both swaps are single atomic exchanges, so neither side ever waits for
+    // the other.
+    static constexpr uInt32 FRAME_BUFFER_SIZE =
+        TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight;
+    std::array<std::array<uInt8, FRAME_BUFFER_SIZE>, 3> myFrameBuffers;
+
+    // The index of the front buffer, plus a flag that is set when it is
+    // published and cleared when the renderer takes it
+    static constexpr uInt8 FRONT_BUFFER_FRESH = 0x80;
+    std::atomic<uInt8> myFrontBufferIdx{2};
+
+    // Buffer indices and pointers of the back buffer (owned by the TIA) and
+    // the framebuffer (owned by the renderer)
+    uInt8 myBackBufferIdx{0}, myFramebufferIdx{1};
+    uInt8* myBackBuffer{myFrameBuffers[0].data()};
+    uInt8* myFramebuffer{myFrameBuffers[1].data()};
+
+    // We snapshot frame statistics when a frame is published and when it
+    // becomes the framebuffer
+    std::array<uInt32, 3> myFrameBuffersScanlines;
+    uInt32 myFrameBufferScanlines{0};
 
     // Frames since the last time a frame was rendered to the render buffer
-    uInt32 myFramesSinceLastRender{0};
+    std::atomic<uInt32> myFramesSinceLastRender{0};
+
+    // Use the generic core only (see enableReferenceMode())
+    bool myReferenceMode{false};
 
     /**
      * Setting this to true injects random values into undefined reads.
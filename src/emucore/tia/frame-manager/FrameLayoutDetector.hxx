@@ -25,7 +25,7 @@
  * This frame manager performs frame layout autodetection. It counts the scanlines
  * in each frame and assigns guesses the frame layout from this.
  */
-class FrameLayoutDetector: public AbstractFrameManager {
+class FrameLayoutDetector final : public AbstractFrameManager {
   public:
 
     FrameLayoutDetector();
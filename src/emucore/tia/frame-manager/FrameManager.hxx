@@ -23,7 +23,7 @@
 #include "bspf.hxx"
 #include "JitterEmulation.hxx"
 
-class FrameManager: public AbstractFrameManager {
+class FrameManager final : public AbstractFrameManager {
   public:
 
     enum Metrics : uInt32 {
@@ -55,7 +55,7 @@ AudioDialog::AudioDialog(OSystem& osystem, DialogContainer& parent,
 
   // Set real dimensions
   _w = 48 * fontWidth + HBORDER * 2;
-  _h = 12 * (lineHeight + VGAP) + VBORDER + _th;
+  _h = 13 * (lineHeight + VGAP) + VBORDER + _th;
 
   xpos = HBORDER;  ypos = VBORDER + _th;
 
@@ -150,6 +150,12 @@ AudioDialog::AudioDialog(OSystem& osystem, DialogContainer& parent,
   wid.push_back(myStereoSoundCheckbox);
   ypos += lineHeight + VGAP;
 
+  // Dynamic rate control
+  myDynamicRateCheckbox = new CheckboxWidget(this, font, xpos, ypos,
+                                             "Sync to audio clock (dynamic rate control)");
+  wid.push_back(myDynamicRateCheckbox);
+  ypos += lineHeight + VGAP;
+
   myDpcPitch = new SliderWidget(this, font, xpos, ypos, swidth - 16, lineHeight,
                                 "Pitfall II music pitch ", 0, 0, 5 * fontWidth);
   myDpcPitch->setMinValue(10000); myDpcPitch->setMaxValue(30000);
@@ -177,6 +183,9 @@ void AudioDialog::loadConfig()
   // Stereo
   myStereoSoundCheckbox->setState(audioSettings.stereo());
 
+  // Dynamic rate control
+  myDynamicRateCheckbox->setState(audioSettings.dynamicRate());
+
   // DPC Pitch
   myDpcPitch->setValue(audioSettings.dpcPitch());
 
@@ -223,6 +232,9 @@ void AudioDialog::saveConfig()
   // Stereo
   audioSettings.setStereo(myStereoSoundCheckbox->getState());
 
+  // Dynamic rate control
+  audioSettings.setDynamicRate(myDynamicRateCheckbox->getState());
+
   // DPC Pitch
   audioSettings.setDpcPitch(myDpcPitch->getValue());
   // update if current cart is Pitfall II
@@ -256,6 +268,7 @@ void AudioDialog::setDefaults()
   mySoundEnableCheckbox->setState(AudioSettings::DEFAULT_ENABLED);
   myVolumeSlider->setValue(AudioSettings::DEFAULT_VOLUME);
   myStereoSoundCheckbox->setState(AudioSettings::DEFAULT_STEREO);
+  myDynamicRateCheckbox->setState(AudioSettings::DEFAULT_DYNAMIC_RATE);
   myDpcPitch->setValue(AudioSettings::DEFAULT_DPC_PITCH);
   myModePopup->setSelected(static_cast<int>(AudioSettings::DEFAULT_PRESET));
 
@@ -280,6 +293,7 @@ void AudioDialog::updateEnabledState()
 
   myVolumeSlider->setEnabled(active);
   myStereoSoundCheckbox->setEnabled(active);
+  myDynamicRateCheckbox->setEnabled(active);
   myModePopup->setEnabled(active);
   // enable only for Pitfall II cart
   myDpcPitch->setEnabled(active && instance().hasConsole() && instance().console().cartridge().name() == "CartridgeDPC");
@@ -57,6 +57,7 @@ class AudioDialog : public Dialog
     CheckboxWidget*   mySoundEnableCheckbox{nullptr};
     SliderWidget*     myVolumeSlider{nullptr};
     CheckboxWidget*   myStereoSoundCheckbox{nullptr};
+    CheckboxWidget*   myDynamicRateCheckbox{nullptr};
     PopUpWidget*      myModePopup{nullptr};
     PopUpWidget*      myFragsizePopup{nullptr};
     PopUpWidget*      myFreqPopup{nullptr};
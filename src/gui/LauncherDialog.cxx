@@ -36,6 +36,7 @@
 #include "StellaKeys.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
+#include "ConsolePreloader.hxx"
 #include "RomInfoWidget.hxx"
 #include "TIAConstants.hxx"
 #include "Settings.hxx"
@@ -410,6 +411,21 @@ void LauncherDialog::setRomInfoFont(const Common::Size& area)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void LauncherDialog::loadRomInfo()
 {
+  // Prepare the ROM for launching in the background, using the same
+  // commandline overrides as OSystem::openConsole; reading and hashing
+  // the file is left to the preloader's thread
+  if(!currentNode().isDirectory() && Bankswitch::isValidRomName(currentNode()))
+  {
+    const Settings& settings = instance().settings();
+    string type = settings.getString("bs");
+    if(settings.getString("type") != "") type = settings.getString("type");
+
+    instance().consolePreloader().preload(currentNode(), type,
+                                          settings.getString("startbank"));
+  }
+  else
+    instance().consolePreloader().cancel();
+
   if(!myRomInfoWidget)
     return;
 
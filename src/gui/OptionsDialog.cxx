@@ -49,6 +49,9 @@
 OptionsDialog::OptionsDialog(OSystem& osystem, DialogContainer& parent,
                              GuiObject* boss, int max_w, int max_h, Menu::AppMode mode)
   : Dialog(osystem, parent, osystem.frameBuffer().font(), "Options"),
+    myBoss(boss),
+    myMaxWidth(max_w),
+    myMaxHeight(max_h),
     myMode(mode)
 {
   // do not show basic settings options in debugger
@@ -137,20 +140,7 @@ OptionsDialog::OptionsDialog(OSystem& osystem, DialogContainer& parent,
   wid.push_back(b);
   addCancelWidget(b);
 
-  // Now create all the dialogs attached to each menu button
-  myVideoDialog    = make_unique<VideoDialog>(osystem, parent, _font, max_w, max_h);
-  myAudioDialog    = make_unique<AudioDialog>(osystem, parent, _font);
-  myInputDialog    = make_unique<InputDialog>(osystem, parent, _font, max_w, max_h);
-  myUIDialog       = make_unique<UIDialog>(osystem, parent, _font, boss, max_w, max_h);
-  mySnapshotDialog = make_unique<SnapshotDialog>(osystem, parent, _font, max_w, max_h);
-  myDeveloperDialog = make_unique<DeveloperDialog>(osystem, parent, _font, max_w, max_h);
-  myGameInfoDialog = make_unique<GameInfoDialog>(osystem, parent, _font, this, max_w, max_h);
-#ifdef CHEATCODE_SUPPORT
-  myCheatCodeDialog = make_unique<CheatCodeDialog>(osystem, parent, _font);
-#endif
-  myRomAuditDialog = make_unique<RomAuditDialog>(osystem, parent, _font, max_w, max_h);
-  myHelpDialog      = make_unique<HelpDialog>(osystem, parent, _font);
-  myAboutDialog     = make_unique<AboutDialog>(osystem, parent, _font);
+  // The dialogs attached to each menu button are created when first used
 
   addToFocusList(wid);
 
@@ -211,7 +201,7 @@ void OptionsDialog::handleCommand(CommandSender* sender, int cmd,
     {
       // This dialog is resizable under certain conditions, so we need
       // to re-create it as necessary
-      uInt32 w = 0, h = 0;
+      uInt32 w = myMaxWidth, h = myMaxHeight;
 
       if(myVideoDialog == nullptr || myVideoDialog->shouldResize(w, h))
       {
@@ -223,6 +213,8 @@ void OptionsDialog::handleCommand(CommandSender* sender, int cmd,
     }
 
     case kAudCmd:
+      if(myAudioDialog == nullptr)
+        myAudioDialog = make_unique<AudioDialog>(instance(), parent(), _font);
       myAudioDialog->open();
       break;
 
@@ -230,7 +222,7 @@ void OptionsDialog::handleCommand(CommandSender* sender, int cmd,
     {
       // This dialog is resizable under certain conditions, so we need
       // to re-create it as necessary
-      uInt32 w = 0, h = 0;
+      uInt32 w = myMaxWidth, h = myMaxHeight;
 
       if(myInputDialog == nullptr || myInputDialog->shouldResize(w, h))
       {
@@ -243,6 +235,9 @@ void OptionsDialog::handleCommand(CommandSender* sender, int cmd,
     }
 
     case kUsrIfaceCmd:
+      if(myUIDialog == nullptr)
+        myUIDialog = make_unique<UIDialog>(instance(), parent(), _font, myBoss,
+                                           myMaxWidth, myMaxHeight);
       myUIDialog->open();
       break;
 
@@ -250,7 +245,7 @@ void OptionsDialog::handleCommand(CommandSender* sender, int cmd,
     {
       // This dialog is resizable under certain conditions, so we need
       // to re-create it as necessary
-      uInt32 w = 0, h = 0;
+      uInt32 w = myMaxWidth, h = myMaxHeight;
 
       if(mySnapshotDialog == nullptr || mySnapshotDialog->shouldResize(w, h))
       {
@@ -265,7 +260,7 @@ void OptionsDialog::handleCommand(CommandSender* sender, int cmd,
     {
       // This dialog is resizable under certain conditions, so we need
       // to re-create it as necessary
-      uInt32 w = 0, h = 0;
+      uInt32 w = myMaxWidth, h = myMaxHeight;
 
       if(myDeveloperDialog == nullptr || myDeveloperDialog->shouldResize(w, h))
       {
@@ -280,7 +275,7 @@ void OptionsDialog::handleCommand(CommandSender* sender, int cmd,
     {
       // This dialog is resizable under certain conditions, so we need
       // to re-create it as necessary
-      uInt32 w = 0, h = 0;
+      uInt32 w = myMaxWidth, h = myMaxHeight;
 
       if(myGameInfoDialog == nullptr || myGameInfoDialog->shouldResize(w, h))
       {
@@ -293,11 +288,16 @@ void OptionsDialog::handleCommand(CommandSender* sender, int cmd,
 
 #ifdef CHEATCODE_SUPPORT
     case kCheatCmd:
+      if(myCheatCodeDialog == nullptr)
+        myCheatCodeDialog = make_unique<CheatCodeDialog>(instance(), parent(), _font);
       myCheatCodeDialog->open();
       break;
 #endif
 
     case kAuditCmd:
+      if(myRomAuditDialog == nullptr)
+        myRomAuditDialog = make_unique<RomAuditDialog>(instance(), parent(), _font,
+                                                       myMaxWidth, myMaxHeight);
       myRomAuditDialog->open();
       break;
 
@@ -318,10 +318,14 @@ void OptionsDialog::handleCommand(CommandSender* sender, int cmd,
     }
 
     case kHelpCmd:
+      if(myHelpDialog == nullptr)
+        myHelpDialog = make_unique<HelpDialog>(instance(), parent(), _font);
       myHelpDialog->open();
       break;
 
     case kAboutCmd:
+      if(myAboutDialog == nullptr)
+        myAboutDialog = make_unique<AboutDialog>(instance(), parent(), _font);
       myAboutDialog->open();
       break;
 
@@ -71,6 +71,10 @@ class OptionsDialog : public Dialog
     ButtonWidget* myGameInfoButton{nullptr};
     ButtonWidget* myCheatCodeButton{nullptr};
 
+    // Needed to create the dialogs above on first use
+    GuiObject* myBoss{nullptr};
+    uInt32 myMaxWidth{0}, myMaxHeight{0};
+
     // Indicates if this dialog is used for global (vs. in-game) settings
     Menu::AppMode myMode{Menu::AppMode::emulator};
 
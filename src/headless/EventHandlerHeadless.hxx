@@ -0,0 +1,57 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef EVENTHANDLER_HEADLESS_HXX
+#define EVENTHANDLER_HEADLESS_HXX
+
+#include "EventHandler.hxx"
+
+/**
+  This class implements an event handler without any event source.  No
+  physical input devices exist in headless mode, so events can only
+  originate from within Stella itself (commandline, state files, etc).
+*/
+class EventHandlerHeadless : public EventHandler
+{
+  public:
+    /**
+      Create a new headless event handler object
+    */
+    explicit EventHandlerHeadless(OSystem& osystem) : EventHandler(osystem) { }
+    virtual ~EventHandlerHeadless() = default;
+
+  private:
+    /**
+      Enable/disable text events (distinct from single-key events).
+    */
+    void enableTextEvents(bool enable) override { }
+
+    /**
+      Collects and dispatches any pending events (there are none).
+    */
+    void pollEvent() override { }
+
+  private:
+    // Following constructors and assignment operators not supported
+    EventHandlerHeadless() = delete;
+    EventHandlerHeadless(const EventHandlerHeadless&) = delete;
+    EventHandlerHeadless(EventHandlerHeadless&&) = delete;
+    EventHandlerHeadless& operator=(const EventHandlerHeadless&) = delete;
+    EventHandlerHeadless& operator=(EventHandlerHeadless&&) = delete;
+};
+
+#endif
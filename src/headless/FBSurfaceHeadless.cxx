@@ -0,0 +1,135 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "FBSurfaceHeadless.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FBSurfaceHeadless::FBSurfaceHeadless(FrameBufferHeadless& buffer,
+                                     uInt32 width, uInt32 height,
+                                     const uInt32* staticData)
+  : myFB(buffer)
+{
+  createSurface(width, height, staticData);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FBSurfaceHeadless::setSrcPos(uInt32 x, uInt32 y)
+{
+  mySrcR.moveTo(x, y);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FBSurfaceHeadless::setSrcSize(uInt32 w, uInt32 h)
+{
+  mySrcR.setWidth(w);  mySrcR.setHeight(h);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FBSurfaceHeadless::setDstPos(uInt32 x, uInt32 y)
+{
+  myDstR.moveTo(x, y);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FBSurfaceHeadless::setDstSize(uInt32 w, uInt32 h)
+{
+  myDstR.setWidth(w);  myDstR.setHeight(h);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FBSurfaceHeadless::translateCoords(Int32& x, Int32& y) const
+{
+  x -= myDstR.x();  x /= myDstR.w() / mySrcR.w();
+  y -= myDstR.y();  y /= myDstR.h() / mySrcR.h();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FBSurfaceHeadless::render()
+{
+  if(!myIsVisible || mySrcR.empty() || myDstR.empty())
+    return false;
+
+  // Clip the destination to the display
+  const uInt32 dstW = std::min(myDstR.w(), myFB.myScreenWidth > myDstR.x() ?
+                               myFB.myScreenWidth - myDstR.x() : 0),
+               dstH = std::min(myDstR.h(), myFB.myScreenHeight > myDstR.y() ?
+                               myFB.myScreenHeight - myDstR.y() : 0);
+  if(dstW == 0 || dstH == 0)
+    return false;
+
+  // Source column for each destination column, in 16.16 fixed point steps
+  const uInt32 stepX = (mySrcR.w() << 16) / myDstR.w(),
+               stepY = (mySrcR.h() << 16) / myDstR.h();
+  const bool blend = myAttributes.blending && myAttributes.blendalpha < 100;
+  const uInt32 alpha = myAttributes.blendalpha * 256 / 100;
+
+  for(uInt32 dy = 0; dy < dstH; ++dy)
+  {
+    const uInt32* src = myPixels + (mySrcR.y() + ((dy * stepY) >> 16)) * myPitch
+                        + mySrcR.x();
+    uInt32* dst = myFB.myScreen.data() + (myDstR.y() + dy) * myFB.myScreenWidth
+                  + myDstR.x();
+
+    if(blend)
+      for(uInt32 dx = 0, sx = 0; dx < dstW; ++dx, sx += stepX)
+      {
+        const uInt32 s = src[sx >> 16], d = dst[dx];
+        const uInt32 rb = ((s & 0xff00ff) * alpha + (d & 0xff00ff) * (256 - alpha)) >> 8,
+                     g  = ((s & 0x00ff00) * alpha + (d & 0x00ff00) * (256 - alpha)) >> 8;
+        dst[dx] = (rb & 0xff00ff) | (g & 0x00ff00);
+      }
+    else
+      for(uInt32 dx = 0, sx = 0; dx < dstW; ++dx, sx += stepX)
+        dst[dx] = src[sx >> 16];
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FBSurfaceHeadless::invalidate()
+{
+  std::fill_n(myPixelData.get(), myWidth * myHeight, 0);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FBSurfaceHeadless::resize(uInt32 width, uInt32 height)
+{
+  createSurface(width, height, nullptr);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FBSurfaceHeadless::createSurface(uInt32 width, uInt32 height,
+                                      const uInt32* data)
+{
+  myWidth = width;
+  myHeight = height;
+
+  myPixelData = make_unique<uInt32[]>(width * height);
+  if(data)
+    std::copy_n(data, width * height, myPixelData.get());
+
+  // We start out with the src and dst rectangles containing the same
+  // dimensions, indicating no scaling or re-positioning
+  mySrcR = myDstR = Common::Rect(width, height);
+
+  ////////////////////////////////////////////////////
+  // These *must* be set for the parent class
+  myPixels = myPixelData.get();
+  myPitch = width;
+  ////////////////////////////////////////////////////
+}
@@ -0,0 +1,82 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef FBSURFACE_HEADLESS_HXX
+#define FBSURFACE_HEADLESS_HXX
+
+#include "bspf.hxx"
+#include "FBSurface.hxx"
+#include "FrameBufferHeadless.hxx"
+
+/**
+  An FBSurface backed by plain memory.  Rendering scales the source
+  rectangle into the destination rectangle of the offscreen display of
+  the owning FrameBufferHeadless (nearest neighbour), optionally blending
+  it with the existing contents.
+*/
+class FBSurfaceHeadless : public FBSurface
+{
+  public:
+    FBSurfaceHeadless(FrameBufferHeadless& buffer, uInt32 width, uInt32 height,
+                      const uInt32* staticData);
+    virtual ~FBSurfaceHeadless() = default;
+
+    uInt32 width() const override { return myWidth; }
+    uInt32 height() const override { return myHeight; }
+
+    const Common::Rect& srcRect() const override { return mySrcR; }
+    const Common::Rect& dstRect() const override { return myDstR; }
+    void setSrcPos(uInt32 x, uInt32 y) override;
+    void setSrcSize(uInt32 w, uInt32 h) override;
+    void setDstPos(uInt32 x, uInt32 y) override;
+    void setDstSize(uInt32 w, uInt32 h) override;
+    void setVisible(bool visible) override { myIsVisible = visible; }
+
+    void translateCoords(Int32& x, Int32& y) const override;
+    bool render() override;
+    void invalidate() override;
+    void free() override { }
+    void reload() override { }
+    void resize(uInt32 width, uInt32 height) override;
+
+    void setScalingInterpolation(FrameBuffer::ScalingInterpolation) override { }
+
+  protected:
+    void applyAttributes() override { }
+
+  private:
+    void createSurface(uInt32 width, uInt32 height, const uInt32* data);
+
+    // Following constructors and assignment operators not supported
+    FBSurfaceHeadless() = delete;
+    FBSurfaceHeadless(const FBSurfaceHeadless&) = delete;
+    FBSurfaceHeadless(FBSurfaceHeadless&&) = delete;
+    FBSurfaceHeadless& operator=(const FBSurfaceHeadless&) = delete;
+    FBSurfaceHeadless& operator=(FBSurfaceHeadless&&) = delete;
+
+  private:
+    FrameBufferHeadless& myFB;
+
+    unique_ptr<uInt32[]> myPixelData;
+    uInt32 myWidth{0}, myHeight{0};
+
+    Common::Rect mySrcR, myDstR;
+
+    bool myIsVisible{true};
+};
+
+#endif
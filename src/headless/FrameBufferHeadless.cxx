@@ -0,0 +1,78 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2020 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "bspf.hxx"
+
+#include "FBSurfaceHeadless.hxx"
+#include "FrameBufferHeadless.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FrameBufferHeadless::FrameBufferHeadless(OSystem& osystem)
+  : FrameBuffer(osystem)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBufferHeadless::queryHardware(vector<Common::Size>& fullscreenRes,
+                                        vector<Common::Size>& windowedRes,
+                                        VariantList& renderers)
+{
+  fullscreenRes.emplace_back(1920, 1080);
+  windowedRes.emplace_back(1920, 1080);
+
+  VarList::push_back(renderers, "software", "Software");
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FrameBufferHeadless::setVideoMode(const string&, const VideoMode& mode)
+{
+  myScreenWidth = mode.screen.w;
+  myScreenHeight = mode.screen.h;
+  myScreen.assign(myScreenWidth * myScreenHeight, 0);
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+unique_ptr<FBSurface>
+    FrameBufferHeadless::createSurface(uInt32 w, uInt32 h,
+                                       FrameBuffer::ScalingInterpolation,
+                                       const uInt32* data) const
+{
+  return make_unique<FBSurfaceHeadless>
+      (const_cast<FrameBufferHeadless&>(*this), w, h, data);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBufferHeadless::readPixels(uInt8* buffer, uInt32 pitch,
+                                     const Common::Rect& rect) const
+{
+  const uInt32 x = std::min(rect.x(), myScreenWidth),
+               y = std::min(rect.y(), myScreenHeight),
+               w = std::min(rect.w(), myScreenWidth - x),
+               h = std::min(rect.h(), myScreenHeight - y);
+
+  const uInt32* src = myScreen.data() + y * myScreenWidth + x;
+  for(uInt32 line = 0; line < h; ++line, src += myScreenWidth, buffer += pitch)
+    std::copy_n(src, w, reinterpret_cast<uInt32*>(buffer));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBufferHeadless::clear()
+{
+  std::fill(myScreen.begin(), myScreen.end(), 0);
+}
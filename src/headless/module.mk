@@ -0,0 +1,11 @@
+MODULE := src/headless
+
+MODULE_OBJS := \
+	src/headless/FBSurfaceHeadless.o \
+	src/headless/FrameBufferHeadless.o
+
+MODULE_DIRS += \
+	src/headless
+
+# Include common rules
+include $(srcdir)/common.rules
@@ -180,6 +180,20 @@ bool FilesystemNodePOSIX::getChildren(AbstractFSList& myList, ListMode mode) con
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t FilesystemNodePOSIX::getSize() const
+{
+  struct stat st;
+  return stat(_path.c_str(), &st) == 0 ? size_t(st.st_size) : 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 FilesystemNodePOSIX::getModTime() const
+{
+  struct stat st;
+  return stat(_path.c_str(), &st) == 0 ? uInt64(st.st_mtime) : 0;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool FilesystemNodePOSIX::makeDir()
 {
@@ -262,6 +262,27 @@ bool FilesystemNodeWINDOWS::
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t FilesystemNodeWINDOWS::getSize() const
+{
+  WIN32_FILE_ATTRIBUTE_DATA data;
+  if(!GetFileAttributesEx(toUnicode(_path.c_str()), GetFileExInfoStandard, &data))
+    return 0;
+
+  return size_t((uInt64(data.nFileSizeHigh) << 32) | data.nFileSizeLow);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 FilesystemNodeWINDOWS::getModTime() const
+{
+  WIN32_FILE_ATTRIBUTE_DATA data;
+  if(!GetFileAttributesEx(toUnicode(_path.c_str()), GetFileExInfoStandard, &data))
+    return 0;
+
+  return (uInt64(data.ftLastWriteTime.dwHighDateTime) << 32) |
+         data.ftLastWriteTime.dwLowDateTime;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool FilesystemNodeWINDOWS::makeDir()
 {
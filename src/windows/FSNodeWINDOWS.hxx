@@ -70,6 +70,9 @@ class FilesystemNodeWINDOWS : public AbstractFSNode
     bool makeDir() override;
     bool rename(const string& newfile) override;
 
+    size_t getSize() const override;
+    uInt64 getModTime() const override;
+
     bool getChildren(AbstractFSList& list, ListMode mode) const override;
     AbstractFSNodePtr getParent() const override;
 